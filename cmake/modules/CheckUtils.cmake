@@ -502,6 +502,29 @@ macro(polar_check_builtin_ctzll)
    endif()
 endmacro()
 
+macro(polar_check_func_attribute_target)
+   check_c_source_compiles("
+      #include <immintrin.h>
+      __attribute__((target(\"avx2\"))) static int foo(void) {
+         __m256i value = _mm256_set1_epi8(1);
+         return _mm256_movemask_epi8(_mm256_cmpeq_epi8(value, value));
+      }
+      int main(){return foo() == -1 ? 0 : 1;}"
+      checkFuncAttributeTarget)
+   if (checkFuncAttributeTarget)
+      set(HAVE_FUNC_ATTRIBUTE_TARGET ON)
+   endif()
+endmacro()
+
+macro(polar_check_avx2_instructions)
+   check_c_source_compiles("
+      int main(){__asm__ volatile(\"vpunpcklqdq %ymm1, %ymm2, %ymm3\");return 0;}"
+      checkAvx2Instructions)
+   if (checkAvx2Instructions)
+      set(PHP_HAVE_AVX2_INSTRUCTIONS ON)
+   endif()
+endmacro()
+
 macro(polar_check_builtin_smull_overflow)
    check_c_source_runs("
       int main(){
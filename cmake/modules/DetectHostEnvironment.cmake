@@ -180,6 +180,8 @@ polar_check_headers(
    syslog.h
    sysexits.h
    sys/ioctl.h
+   sys/inotify.h
+   immintrin.h
    sys/file.h
    sys/mman.h
    sys/mount.h
@@ -196,6 +198,7 @@ polar_check_headers(
    sys/wait.h
    sys/loadavg.h
    termios.h
+   ucontext.h
    unistd.h
    unix.h
    utime.h
@@ -245,6 +248,8 @@ polar_check_builtin_saddl_overflow()
 polar_check_builtin_saddll_overflow()
 polar_check_builtin_ssubl_overflow()
 polar_check_builtin_ssubll_overflow()
+polar_check_func_attribute_target()
+polar_check_avx2_instructions()
 
 # Check for members of the stat structure
 check_struct_has_member("struct stat" st_blksize "sys/types.h;sys/stat.h" HAVE_STRUCT_STAT_ST_BLKSIZE LANGUAGE C)
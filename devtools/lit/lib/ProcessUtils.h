@@ -22,6 +22,15 @@
 namespace polar {
 namespace lit {
 
+/// Resources consumed by the child processes spawned from the current
+/// thread, the times are in seconds and maxRss is in kilobytes.
+struct ProcessResourceUsage
+{
+   double userTime = 0.0;
+   double systemTime = 0.0;
+   long maxRss = 0;
+};
+
 namespace internal {
 
 void do_run_program(const std::string &cmd, int &exitCode,
@@ -49,6 +58,8 @@ inline const char *run_program_arg_filter(const std::string &arg)
 } // internal
 
 bool find_executable(const fs::path &filepath) noexcept;
+void reset_child_resource_usage() noexcept;
+const ProcessResourceUsage &get_child_resource_usage() noexcept;
 std::optional<std::string> look_path(const std::string &file) noexcept;
 
 std::tuple<std::list<pid_t>, bool> retrieve_children_pids(pid_t pid, bool recursive = false) noexcept;
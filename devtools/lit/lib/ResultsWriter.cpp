@@ -0,0 +1,154 @@
+// This source file is part of the polarphp.org open source project
+//
+// Copyright (c) 2017 - 2018 polarphp software foundation
+// Copyright (c) 2017 - 2018 zzu_softboy <zzu_softboy@163.com>
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://polarphp.org/LICENSE.txt for license information
+// See http://polarphp.org/CONTRIBUTORS.txt for the list of polarphp project authors
+//
+// Created by polarboy on 2018/09/21.
+
+#include "ResultsWriter.h"
+
+namespace polar {
+namespace lit {
+
+nlohmann::json metric_value_to_json(MetricValuePointer value)
+{
+   std::any data = value->todata();
+   if (data.type() == typeid(int)) {
+      return std::any_cast<int>(data);
+   } else if (data.type() == typeid(double)) {
+      return std::any_cast<double>(data);
+   } else if (data.type() == typeid(nlohmann::json)) {
+      return std::any_cast<nlohmann::json>(data);
+   }
+   return value->format();
+}
+
+nlohmann::json result_to_json(const Result &result)
+{
+   nlohmann::json data = {
+      {"code", result.getCode().getName()}
+   };
+   if (result.getElapsed().has_value()) {
+      data["elapsed"] = result.getElapsed().value();
+   }
+   if (result.getResourceUsage().has_value()) {
+      const ProcessResourceUsage &usage = result.getResourceUsage().value();
+      data["user_time"] = usage.userTime;
+      data["system_time"] = usage.systemTime;
+      data["peak_rss_kb"] = usage.maxRss;
+   }
+   if (!result.getMetrics().empty()) {
+      nlohmann::json metrics = nlohmann::json::object();
+      for (auto &item : result.getMetrics()) {
+         metrics[item.first] = metric_value_to_json(item.second);
+      }
+      data["metrics"] = metrics;
+   }
+   if (!result.getMicroResults().empty()) {
+      nlohmann::json microResults = nlohmann::json::object();
+      for (auto &item : result.getMicroResults()) {
+         microResults[item.first] = result_to_json(*item.second);
+      }
+      data["micro_results"] = microResults;
+   }
+   return data;
+}
+
+/// Write the results grouped by test suite in the XUnit XML layout
+/// understood by most CI servers.
+bool write_xunit_xml_results(const std::string &filename, const TestList &tests)
+{
+   std::ofstream stream(filename, std::ios::out | std::ios::trunc);
+   if (!stream.is_open()) {
+      return false;
+   }
+   std::list<TestSuitePointer> suites;
+   std::map<TestSuitePointer, TestList> suiteTests;
+   for (const TestPointer &test : tests) {
+      TestSuitePointer suite = test->getSuite();
+      if (suiteTests.find(suite) == suiteTests.end()) {
+         suites.push_back(suite);
+      }
+      suiteTests[suite].push_back(test);
+   }
+   stream << "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>\n<testsuites>\n";
+   for (const TestSuitePointer &suite : suites) {
+      const TestList &curTests = suiteTests[suite];
+      int numFailures = 0;
+      int numSkipped = 0;
+      for (const TestPointer &test : curTests) {
+         const std::optional<Result> &result = test->getResult();
+         if (!result.has_value()) {
+            continue;
+         }
+         if (result.value().getCode().isFailure()) {
+            ++numFailures;
+         } else if (result.value().getCode() == UNSUPPORTED) {
+            ++numSkipped;
+         }
+      }
+      std::string safeName = suite->getName();
+      replace_string(".", "_", safeName);
+      stream << "<testsuite name='" << safeName << "' tests='" << curTests.size()
+             << "' failures='" << numFailures << "' skipped='" << numSkipped << "'>\n";
+      for (const TestPointer &test : curTests) {
+         std::string xmlStr;
+         test->writeJUnitXML(xmlStr);
+         stream << xmlStr << "\n";
+      }
+      stream << "</testsuite>\n";
+   }
+   stream << "</testsuites>\n";
+   return stream.good();
+}
+
+JSONLinesResultsWriter::JSONLinesResultsWriter(const std::string &filename)
+   : m_filename(filename),
+     m_stream(filename, std::ios::out | std::ios::trunc)
+{
+}
+
+bool JSONLinesResultsWriter::isOpen() const
+{
+   return m_stream.is_open();
+}
+
+const std::string &JSONLinesResultsWriter::getFilename() const
+{
+   return m_filename;
+}
+
+void JSONLinesResultsWriter::writeResult(TestPointer test)
+{
+   const std::optional<Result> &result = test->getResult();
+   if (!result.has_value()) {
+      return;
+   }
+   nlohmann::json data = result_to_json(result.value());
+   data["name"] = test->getFullName();
+   writeLine(data);
+}
+
+void JSONLinesResultsWriter::writeSummary(double elapsed, const std::map<std::string, int> &codeCounts)
+{
+   writeLine({
+                {"summary", {
+                    {"elapsed", elapsed},
+                    {"codes", codeCounts}
+                 }}
+             });
+}
+
+void JSONLinesResultsWriter::writeLine(const nlohmann::json &data)
+{
+   std::lock_guard locker(m_lock);
+   m_stream << data.dump() << '\n';
+   m_stream.flush();
+}
+
+} // lit
+} // polar
@@ -0,0 +1,61 @@
+// This source file is part of the polarphp.org open source project
+//
+// Copyright (c) 2017 - 2018 polarphp software foundation
+// Copyright (c) 2017 - 2018 zzu_softboy <zzu_softboy@163.com>
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://polarphp.org/LICENSE.txt for license information
+// See http://polarphp.org/CONTRIBUTORS.txt for the list of polarphp project authors
+//
+// Created by polarboy on 2018/09/21.
+
+#ifndef POLAR_DEVLTOOLS_LIT_RESULTS_WRITER_H
+#define POLAR_DEVLTOOLS_LIT_RESULTS_WRITER_H
+
+#include <string>
+#include <fstream>
+#include <mutex>
+#include "Test.h"
+#include "nlohmann/json.hpp"
+
+namespace polar {
+namespace lit {
+
+class JSONLinesResultsWriter;
+using JSONLinesResultsWriterPointer = std::shared_ptr<JSONLinesResultsWriter>;
+
+nlohmann::json metric_value_to_json(MetricValuePointer value);
+nlohmann::json result_to_json(const Result &result);
+bool write_xunit_xml_results(const std::string &filename, const TestList &tests);
+
+/**
+ * @brief The JSONLinesResultsWriter class
+ *
+ * Streams one JSON object per finished test while the run progresses, every
+ * line carries the result code, the wall time, the user and system time and
+ * the peak RSS of the processes spawned by the test, and the metrics the
+ * test reported. Lines are flushed as soon as they are written so the file
+ * can be tailed by dashboards during a long run.
+ */
+class JSONLinesResultsWriter
+{
+public:
+   JSONLinesResultsWriter(const std::string &filename);
+   bool isOpen() const;
+   void writeResult(TestPointer test);
+   void writeSummary(double elapsed, const std::map<std::string, int> &codeCounts);
+   const std::string &getFilename() const;
+
+protected:
+   void writeLine(const nlohmann::json &data);
+
+protected:
+   std::string m_filename;
+   std::ofstream m_stream;
+   std::mutex m_lock;
+};
+
+} // lit
+} // polar
+
+#endif // POLAR_DEVLTOOLS_LIT_RESULTS_WRITER_H
@@ -10,21 +10,136 @@
 // Created by polarboy on 2018/09/05.
 
 #include "Run.h"
+#include "LitConfig.h"
+#include "formats/Base.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace polar {
 namespace lit {
 
 Run::Run(std::shared_ptr<LitConfig> litConfig, const TestList &tests)
    : m_litConfig(litConfig),
-     m_tests(tests)
+     m_tests(tests),
+     m_elapsed(0.0),
+     m_numFailures(0)
 {
 }
 
+/// Run one test and attach its result, the wall time of the whole test and
+/// the resources consumed by the processes it spawned are recorded with it.
+void execute_test(TestPointer test, LitConfigPointer litConfig)
+{
+   if (litConfig->isNoExecute()) {
+      test->setResult(Result(PASS));
+      return;
+   }
+   reset_child_resource_usage();
+   auto startTime = std::chrono::steady_clock::now();
+   std::optional<Result> result;
+   try {
+      const std::optional<std::shared_ptr<TestFormat>> &testFormat = test->getConfig()->getTestFormat();
+      if (!testFormat.has_value() || !testFormat.value()) {
+         result.emplace(UNRESOLVED, "test suite has no test format");
+      } else {
+         result.emplace(testFormat.value()->executeTest(test, litConfig));
+      }
+   } catch (std::exception &error) {
+      result.emplace(UNRESOLVED, std::string("Exception during script execution:\n") + error.what());
+   }
+   std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+   result.value().setElapsed(elapsed.count());
+   result.value().setResourceUsage(get_child_resource_usage());
+   test->setResult(result.value());
+}
+
+/// Execute every test of the run on numThreads worker threads, callback is
+/// invoked (serialized) as soon as a test finished so results can be
+/// reported while the run progresses.
+void Run::execute(int numThreads, const TestFinishedCallback &callback)
+{
+   std::vector<TestPointer> tests(m_tests.begin(), m_tests.end());
+   std::atomic<size_t> nextIndex(0);
+   std::atomic<int> numFailures(0);
+   std::mutex callbackLock;
+   const std::optional<int> &maxFailures = m_litConfig->getMaxFailures();
+   auto worker = [&]() {
+      while (true) {
+         if (maxFailures.has_value() && maxFailures.value() > 0 &&
+             numFailures.load() >= maxFailures.value()) {
+            return;
+         }
+         size_t index = nextIndex.fetch_add(1);
+         if (index >= tests.size()) {
+            return;
+         }
+         TestPointer test = tests[index];
+         execute_test(test, m_litConfig);
+         if (test->getResult().value().getCode().isFailure()) {
+            ++numFailures;
+         }
+         if (callback) {
+            std::lock_guard locker(callbackLock);
+            callback(test);
+         }
+      }
+   };
+   auto startTime = std::chrono::steady_clock::now();
+   if (m_litConfig->isSingleProcess() || numThreads <= 1) {
+      worker();
+   } else {
+      std::vector<std::thread> threads;
+      size_t threadCount = std::min<size_t>(numThreads, tests.size());
+      for (size_t i = 0; i < threadCount; ++i) {
+         threads.emplace_back(worker);
+      }
+      for (std::thread &thread : threads) {
+         thread.join();
+      }
+   }
+   std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+   m_elapsed = elapsed.count();
+   m_numFailures = numFailures.load();
+}
+
+double Run::getElapsed() const
+{
+   return m_elapsed;
+}
+
+int Run::getNumFailures() const
+{
+   return m_numFailures;
+}
+
 const TestList &Run::getTests() const
 {
    return m_tests;
 }
 
+/// Restrict the run to the tests whose inputs changed since the last run
+/// and to the tests that failed last time, the failing ones go first.
+Run &Run::selectIncrementalTests(TestDatabasePointer database)
+{
+   m_tests = database->selectTests(m_tests);
+   return *this;
+}
+
+/// Record the outcome of every executed test, tests that did not get a
+/// result (interrupted run, --max-failures) keep their previous entry.
+void Run::updateTestDatabase(TestDatabasePointer database)
+{
+   for (const TestPointer &test : m_tests) {
+      const std::optional<Result> &result = test->getResult();
+      if (result.has_value()) {
+         database->recordResult(test, result.value().getCode());
+      }
+   }
+}
+
 } // lit
 } // polar
 
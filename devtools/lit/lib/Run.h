@@ -13,6 +13,8 @@
 #define POLAR_DEVLTOOLS_LIT_RUN_H
 
 #include "Test.h"
+#include "TestDatabase.h"
+#include <functional>
 
 namespace polar {
 namespace lit {
@@ -20,15 +22,26 @@ namespace lit {
 class LitConfig;
 class Run;
 using RunPointer = std::shared_ptr<Run>;
+using LitConfigPointer = std::shared_ptr<LitConfig>;
+using TestFinishedCallback = std::function<void(TestPointer)>;
+
+void execute_test(TestPointer test, LitConfigPointer litConfig);
 
 class Run
 {
 public:
    Run(std::shared_ptr<LitConfig> litConfig, const TestList &tests);
    const TestList &getTests() const;
+   void execute(int numThreads, const TestFinishedCallback &callback = nullptr);
+   double getElapsed() const;
+   int getNumFailures() const;
+   Run &selectIncrementalTests(TestDatabasePointer database);
+   void updateTestDatabase(TestDatabasePointer database);
 protected:
    std::shared_ptr<LitConfig> m_litConfig;
    TestList m_tests;
+   double m_elapsed;
+   int m_numFailures;
 };
 
 } // lit
@@ -28,7 +28,7 @@ const ResultCode &UNRESOLVED = ResultCode::getInstance("UNRESOLVED", true);
 const ResultCode &UNSUPPORTED = ResultCode::getInstance("UNSUPPORTED", false);
 const ResultCode &TIMEOUT = ResultCode::getInstance("TIMEOUT", true);
 
-Result::Result(const ResultCode &code, std::string output, std::optional<int> elapsed)
+Result::Result(const ResultCode &code, std::string output, std::optional<double> elapsed)
    : m_code(code),
      m_output(output),
      m_elapsed(elapsed)
@@ -57,12 +57,29 @@ Result &Result::setOutput(const std::string &output)
    return *this;
 }
 
-const std::optional<int> &Result::getElapsed() const
+const std::optional<double> &Result::getElapsed() const
 {
    return m_elapsed;
 }
 
-const std::unordered_map<std::string, MetricValue *> &Result::getMetrics() const
+Result &Result::setElapsed(double elapsed)
+{
+   m_elapsed = elapsed;
+   return *this;
+}
+
+const std::optional<ProcessResourceUsage> &Result::getResourceUsage() const
+{
+   return m_resourceUsage;
+}
+
+Result &Result::setResourceUsage(const ProcessResourceUsage &usage)
+{
+   m_resourceUsage = usage;
+   return *this;
+}
+
+const std::unordered_map<std::string, MetricValuePointer> &Result::getMetrics() const
 {
    return m_metrics;
 }
@@ -72,15 +89,12 @@ std::unordered_map<std::string, std::shared_ptr<Result>> &Result::getMicroResult
    return m_microResults;
 }
 
-Result::~Result()
+const std::unordered_map<std::string, std::shared_ptr<Result>> &Result::getMicroResults() const
 {
-   auto iter = m_metrics.begin();
-   while (iter != m_metrics.end()) {
-      delete iter->second;
-   }
+   return m_microResults;
 }
 
-Result &Result::addMetric(const std::string &name, MetricValue *value)
+Result &Result::addMetric(const std::string &name, MetricValuePointer value)
 {
    if (m_metrics.find(name) != m_metrics.end()) {
       throw ValueError(format_string("result already includes metrics for %s", name.c_str()));
@@ -91,8 +105,8 @@ Result &Result::addMetric(const std::string &name, MetricValue *value)
 
 Result &Result::addMicroResult(const std::string &name, std::shared_ptr<Result> microResult)
 {
-   if (m_metrics.find(name) != m_metrics.end()) {
-      throw ValueError(format_string("esult already includes microResult for %s", name.c_str()));
+   if (m_microResults.find(name) != m_microResults.end()) {
+      throw ValueError(format_string("Result already includes microResult for %s", name.c_str()));
    }
    m_microResults[name] = microResult;
    return *this;
@@ -178,6 +192,16 @@ void Test::setResult(const Result &result)
    }
 }
 
+const std::optional<Result> &Test::getResult() const
+{
+   return m_result;
+}
+
+TestSuitePointer Test::getSuite() const
+{
+   return m_suite;
+}
+
 std::string Test::getFullName()
 {
    return m_config->getName() + " :: " + join_string_list(m_pathInSuite, "/");
@@ -352,7 +376,7 @@ void Test::writeJUnitXML(std::string &xmlStr)
       } else {
          skipMessage = "Skipping because of configuration.";
       }
-      xmlStr += format_string(">\n\t<skipped message=\"%s\" />\n</testcase>\n", skipMessage);
+      xmlStr += format_string(">\n\t<skipped message=\"%s\" />\n</testcase>\n", skipMessage.c_str());
    } else {
       xmlStr += "/>";
    }
@@ -18,6 +18,7 @@
 #include <list>
 #include "nlohmann/json.hpp"
 #include "TestingConfig.h"
+#include "ProcessUtils.h"
 #include "Utils.h"
 
 namespace polar {
@@ -25,12 +26,14 @@ namespace lit {
 
 class Test;
 class TestSuite;
+class MetricValue;
 
 using TestPointer = std::shared_ptr<Test>;
 using TestSuitePointer = std::shared_ptr<TestSuite>;
 using TestingConfigPointer = std::shared_ptr<TestingConfig>;
 using TestList = std::list<TestPointer>;
 using TestSuiteList = std::list<TestSuitePointer>;
+using MetricValuePointer = std::shared_ptr<MetricValue>;
 
 class ResultCode
 {
@@ -44,15 +47,6 @@ public:
       return *sm_instances[name];
    }
 
-   ~ResultCode()
-   {
-      if (sm_instances.find(m_name) != sm_instances.end()) {
-         ResultCode *code = sm_instances.at(m_name);
-         delete code;
-         sm_instances.erase(m_name);
-      }
-   }
-
    bool operator == (const ResultCode &other) const
    {
       return m_name == other.m_name && m_isFailure == other.m_isFailure;
@@ -97,7 +91,7 @@ class MetricValue
 public:
    virtual std::string format() = 0;
    virtual std::any todata() = 0;
-   ~MetricValue()
+   virtual ~MetricValue()
    {}
 };
 
@@ -184,22 +178,26 @@ inline JSONMetricValue to_meteric_value(T value)
 class Result
 {
 public:
-   Result(const ResultCode &code, std::string output = "", std::optional<int> elapsed = std::nullopt);
-   Result &addMetric(const std::string &name, MetricValue *value);
+   Result(const ResultCode &code, std::string output = "", std::optional<double> elapsed = std::nullopt);
+   Result &addMetric(const std::string &name, MetricValuePointer value);
    Result &addMicroResult(const std::string &name, std::shared_ptr<Result> microResult);
-   ~Result();
    const ResultCode &getCode() const;
    Result &setCode(const ResultCode &code);
    const std::string &getOutput() const;
    Result &setOutput(const std::string &output);
-   const std::optional<int> &getElapsed() const;
-   const std::unordered_map<std::string, MetricValue *> &getMetrics() const;
+   const std::optional<double> &getElapsed() const;
+   Result &setElapsed(double elapsed);
+   const std::optional<ProcessResourceUsage> &getResourceUsage() const;
+   Result &setResourceUsage(const ProcessResourceUsage &usage);
+   const std::unordered_map<std::string, MetricValuePointer> &getMetrics() const;
    std::unordered_map<std::string, std::shared_ptr<Result>> &getMicroResults();
+   const std::unordered_map<std::string, std::shared_ptr<Result>> &getMicroResults() const;
 protected:
    ResultCode m_code;
    std::string m_output;
-   std::optional<int> m_elapsed;
-   std::unordered_map<std::string, MetricValue *> m_metrics;
+   std::optional<double> m_elapsed;
+   std::optional<ProcessResourceUsage> m_resourceUsage;
+   std::unordered_map<std::string, MetricValuePointer> m_metrics;
    std::unordered_map<std::string, std::shared_ptr<Result>> m_microResults;
 };
 
@@ -226,7 +224,9 @@ public:
    Test(TestSuitePointer testSuite, const std::list<std::string> &pathInSuite,
         TestingConfigPointer config, const std::optional<std::string> &filePath = std::nullopt);
    void setResult(const Result &result);
+   const std::optional<Result> &getResult() const;
    std::string getFullName();
+   TestSuitePointer getSuite() const;
    std::string getFilePath();
    std::string getSourcePath();
    TestingConfigPointer getConfig();
@@ -0,0 +1,318 @@
+// This source file is part of the polarphp.org open source project
+//
+// Copyright (c) 2017 - 2018 polarphp software foundation
+// Copyright (c) 2017 - 2018 zzu_softboy <zzu_softboy@163.com>
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://polarphp.org/LICENSE.txt for license information
+// See http://polarphp.org/CONTRIBUTORS.txt for the list of polarphp project authors
+//
+// Created by polarboy on 2018/09/20.
+
+#include "TestDatabase.h"
+#include "Global.h"
+#include "Utils.h"
+#include "nlohmann/json.hpp"
+#include <fstream>
+#include <set>
+#include <random>
+#include <cstdio>
+
+namespace polar {
+namespace lit {
+
+namespace {
+
+const std::uint64_t sg_fnvOffsetBasis = 14695981039346656037ULL;
+const std::uint64_t sg_fnvPrime = 1099511628211ULL;
+const int sg_databaseVersion = 1;
+
+inline std::uint64_t fnv1a_update(std::uint64_t hash, const char *data, size_t length)
+{
+   for (size_t i = 0; i < length; ++i) {
+      hash ^= static_cast<unsigned char>(data[i]);
+      hash *= sg_fnvPrime;
+   }
+   return hash;
+}
+
+/// Split a RUN line into shell words, we only need the words that can name
+/// a file, so quoting, redirections and option assignments all act as
+/// separators.
+std::list<std::string> split_run_line_words(const std::string &line)
+{
+   static const std::string separators(" \t\r\n|&;<>()'\"=,");
+   std::list<std::string> words;
+   std::string word;
+   for (char ch : line) {
+      if (separators.find(ch) != std::string::npos) {
+         if (!word.empty()) {
+            words.push_back(word);
+            word.clear();
+         }
+      } else {
+         word += ch;
+      }
+   }
+   if (!word.empty()) {
+      words.push_back(word);
+   }
+   return words;
+}
+
+std::string get_test_input_path(TestPointer test)
+{
+   const std::string &selfSourcePath = test->getSelfSourcePath();
+   if (!selfSourcePath.empty()) {
+      return selfSourcePath;
+   }
+   return test->getSourcePath();
+}
+
+} // anonymous namespace
+
+std::optional<std::uint64_t> hash_file_content(const std::string &path) noexcept
+{
+   std::ifstream file(path, std::ios::in | std::ios::binary);
+   if (!file.is_open()) {
+      return std::nullopt;
+   }
+   std::uint64_t hash = sg_fnvOffsetBasis;
+   char buffer[8192];
+   while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0) {
+      hash = fnv1a_update(hash, buffer, static_cast<size_t>(file.gcount()));
+   }
+   if (file.bad()) {
+      return std::nullopt;
+   }
+   return hash;
+}
+
+std::string hash_to_hex(std::uint64_t hash)
+{
+   char buffer[17];
+   std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(hash));
+   return buffer;
+}
+
+TestDatabase::TestDatabase(const std::string &dbPath)
+   : m_dbPath(dbPath)
+{
+}
+
+const std::string &TestDatabase::getDbPath() const
+{
+   return m_dbPath;
+}
+
+size_t TestDatabase::getEntryCount() const
+{
+   std::lock_guard locker(m_lock);
+   return m_entries.size();
+}
+
+std::optional<TestDatabase::Entry> TestDatabase::getEntry(const std::string &testName) const
+{
+   std::lock_guard locker(m_lock);
+   auto iter = m_entries.find(testName);
+   if (iter == m_entries.end()) {
+      return std::nullopt;
+   }
+   return iter->second;
+}
+
+/// Load the database from disk, a missing, corrupted or out of date database
+/// is treated as empty so every test is selected.
+bool TestDatabase::load()
+{
+   std::lock_guard locker(m_lock);
+   m_entries.clear();
+   std::ifstream file(m_dbPath);
+   if (!file.is_open()) {
+      return false;
+   }
+   try {
+      nlohmann::json data = nlohmann::json::parse(file);
+      if (!data.is_object() || data.value("version", 0) != sg_databaseVersion) {
+         return false;
+      }
+      for (auto &item : data.at("tests").items()) {
+         const nlohmann::json &value = item.value();
+         Entry entry;
+         entry.fingerprint = value.at("fingerprint").get<std::string>();
+         entry.failed = value.at("failed").get<bool>();
+         for (const nlohmann::json &dep : value.at("dependencies")) {
+            entry.dependencies.push_back(dep.get<std::string>());
+         }
+         m_entries[item.key()] = std::move(entry);
+      }
+   } catch (nlohmann::json::exception &) {
+      m_entries.clear();
+      return false;
+   }
+   return true;
+}
+
+/// Write the database back, the content goes to a temporary file in the same
+/// directory first and then replaces the old database with a rename, so an
+/// interrupted run never leaves a truncated database behind.
+bool TestDatabase::save()
+{
+   nlohmann::json tests = nlohmann::json::object();
+   {
+      std::lock_guard locker(m_lock);
+      for (auto &item : m_entries) {
+         const Entry &entry = item.second;
+         tests[item.first] = {
+            {"fingerprint", entry.fingerprint},
+            {"failed", entry.failed},
+            {"dependencies", entry.dependencies}
+         };
+      }
+   }
+   nlohmann::json data = {
+      {"version", sg_databaseVersion},
+      {"tests", tests}
+   };
+   std::random_device randomDevice;
+   std::string tempPath = m_dbPath + ".tmp" + std::to_string(randomDevice());
+   {
+      std::ofstream file(tempPath, std::ios::out | std::ios::trunc);
+      if (!file.is_open()) {
+         return false;
+      }
+      file << data.dump(1);
+      file.flush();
+      if (!file.good()) {
+         file.close();
+         std::error_code errorCode;
+         fs::remove(tempPath, errorCode);
+         return false;
+      }
+   }
+   std::error_code errorCode;
+   fs::rename(tempPath, m_dbPath, errorCode);
+   if (errorCode) {
+      fs::remove(tempPath, errorCode);
+      return false;
+   }
+   return true;
+}
+
+/// Collect the inputs of the test, the test file itself (the %s input) and
+/// every existing file named by its RUN lines after the %s, %S and %p
+/// substitutions are applied.
+std::list<std::string> TestDatabase::collectDependencies(TestPointer test)
+{
+   std::string sourcePath = get_test_input_path(test);
+   fs::path sourceDir = fs::path(sourcePath).parent_path();
+   std::set<std::string> dependencies;
+   std::ifstream file(sourcePath);
+   std::string line;
+   while (std::getline(file, line)) {
+      size_t pos = line.find("RUN:");
+      if (pos == std::string::npos) {
+         continue;
+      }
+      std::string command = line.substr(pos + 4);
+      replace_string("%s", sourcePath, command);
+      replace_string("%S", sourceDir.string(), command);
+      replace_string("%p", sourceDir.string(), command);
+      for (const std::string &word : split_run_line_words(command)) {
+         // temporary files and the remaining substitutions are outputs
+         // of the test, not inputs
+         if (word.find('%') != std::string::npos || string_startswith(word, "-")) {
+            continue;
+         }
+         fs::path candidate(word);
+         if (candidate.is_relative()) {
+            candidate = sourceDir / candidate;
+         }
+         std::error_code errorCode;
+         if (fs::is_regular_file(candidate, errorCode)) {
+            dependencies.insert(candidate.lexically_normal().string());
+         }
+      }
+   }
+   dependencies.erase(sourcePath);
+   std::list<std::string> result{sourcePath};
+   result.insert(result.end(), dependencies.begin(), dependencies.end());
+   return result;
+}
+
+std::optional<std::uint64_t> TestDatabase::getFileHash(const std::string &path)
+{
+   {
+      std::lock_guard locker(m_lock);
+      auto iter = m_fileHashCache.find(path);
+      if (iter != m_fileHashCache.end()) {
+         return iter->second;
+      }
+   }
+   std::optional<std::uint64_t> hash = hash_file_content(path);
+   std::lock_guard locker(m_lock);
+   m_fileHashCache[path] = hash;
+   return hash;
+}
+
+std::string TestDatabase::computeFingerprint(const std::list<std::string> &dependencies)
+{
+   std::uint64_t hash = sg_fnvOffsetBasis;
+   for (const std::string &path : dependencies) {
+      std::optional<std::uint64_t> fileHash = getFileHash(path);
+      std::string record = path + ":" + (fileHash.has_value() ? hash_to_hex(fileHash.value()) : "missing") + "\n";
+      hash = fnv1a_update(hash, record.data(), record.size());
+   }
+   return hash_to_hex(hash);
+}
+
+std::string TestDatabase::computeFingerprint(TestPointer test)
+{
+   return computeFingerprint(collectDependencies(test));
+}
+
+bool TestDatabase::isAffected(TestPointer test)
+{
+   std::optional<Entry> entry = getEntry(test->getFullName());
+   if (!entry.has_value() || entry.value().failed) {
+      return true;
+   }
+   // cheap check first, the recorded dependency list is enough to tell a
+   // modified input, only reparse the RUN lines when nothing changed
+   if (computeFingerprint(entry.value().dependencies) != entry.value().fingerprint) {
+      return true;
+   }
+   return computeFingerprint(test) != entry.value().fingerprint;
+}
+
+void TestDatabase::recordResult(TestPointer test, const ResultCode &code)
+{
+   Entry entry;
+   entry.dependencies = collectDependencies(test);
+   entry.fingerprint = computeFingerprint(entry.dependencies);
+   entry.failed = code.isFailure();
+   std::lock_guard locker(m_lock);
+   m_entries[test->getFullName()] = std::move(entry);
+}
+
+/// Select the tests to run for --incremental, the tests that failed last
+/// time go first, then the tests whose inputs changed or that were never
+/// recorded. Unchanged passing tests are dropped.
+TestList TestDatabase::selectTests(const TestList &tests)
+{
+   TestList failedTests;
+   TestList changedTests;
+   for (const TestPointer &test : tests) {
+      std::optional<Entry> entry = getEntry(test->getFullName());
+      if (entry.has_value() && entry.value().failed) {
+         failedTests.push_back(test);
+      } else if (isAffected(test)) {
+         changedTests.push_back(test);
+      }
+   }
+   failedTests.splice(failedTests.end(), changedTests);
+   return failedTests;
+}
+
+} // lit
+} // polar
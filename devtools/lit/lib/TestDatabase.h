@@ -0,0 +1,88 @@
+// This source file is part of the polarphp.org open source project
+//
+// Copyright (c) 2017 - 2018 polarphp software foundation
+// Copyright (c) 2017 - 2018 zzu_softboy <zzu_softboy@163.com>
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://polarphp.org/LICENSE.txt for license information
+// See http://polarphp.org/CONTRIBUTORS.txt for the list of polarphp project authors
+//
+// Created by polarboy on 2018/09/20.
+
+#ifndef POLAR_DEVLTOOLS_LIT_TEST_DATABASE_H
+#define POLAR_DEVLTOOLS_LIT_TEST_DATABASE_H
+
+#include <string>
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <cstdint>
+#include "Test.h"
+
+namespace polar {
+namespace lit {
+
+class TestDatabase;
+using TestDatabasePointer = std::shared_ptr<TestDatabase>;
+
+/// The default name of the incremental database, it lives in the exec root
+/// of the first test suite.
+const static std::string sgc_kdefaultTestDatabaseName(".lit_test_db.json");
+
+/// FNV-1a 64 bit hash of the file content, std::nullopt if the file can
+/// not be read.
+std::optional<std::uint64_t> hash_file_content(const std::string &path) noexcept;
+std::string hash_to_hex(std::uint64_t hash);
+
+/**
+ * @brief The TestDatabase class
+ *
+ * Persistent content-hash database used by --incremental. Every entry maps
+ * the full name of a test to the fingerprint of its inputs (the test file
+ * itself and every file referenced by its RUN lines) and to the outcome of
+ * the last run. A test is selected again only when its fingerprint changed,
+ * when it failed last time, or when it was never recorded.
+ */
+class TestDatabase
+{
+public:
+   struct Entry
+   {
+      std::string fingerprint;
+      std::list<std::string> dependencies;
+      bool failed = false;
+   };
+
+public:
+   TestDatabase(const std::string &dbPath);
+   bool load();
+   bool save();
+
+   std::list<std::string> collectDependencies(TestPointer test);
+   std::string computeFingerprint(TestPointer test);
+   std::string computeFingerprint(const std::list<std::string> &dependencies);
+   bool isAffected(TestPointer test);
+   void recordResult(TestPointer test, const ResultCode &code);
+   TestList selectTests(const TestList &tests);
+
+   const std::string &getDbPath() const;
+   std::optional<Entry> getEntry(const std::string &testName) const;
+   size_t getEntryCount() const;
+
+protected:
+   std::optional<std::uint64_t> getFileHash(const std::string &path);
+
+protected:
+   std::string m_dbPath;
+   std::map<std::string, Entry> m_entries;
+   /// file hashes are shared between tests that use the same inputs, we
+   /// hash every file at most once per run
+   std::map<std::string, std::optional<std::uint64_t>> m_fileHashCache;
+   mutable std::mutex m_lock;
+};
+
+} // lit
+} // polar
+
+#endif // POLAR_DEVLTOOLS_LIT_TEST_DATABASE_H
@@ -18,6 +18,7 @@
 #include <list>
 #include <any>
 #include <memory>
+#include <optional>
 
 namespace polar {
 namespace lit {
@@ -316,15 +316,17 @@ void replace_string(const std::string &search, const std::string &replacement,
    size_t pos = std::string::npos;
    size_t startPos = 0;
    size_t searchSize = search.size();
-   size_t targetStrSize = targetStr.size();
    size_t replacementSize = replacement.size();
+   if (search.empty()) {
+      return;
+   }
    do {
       pos = targetStr.find(search, startPos);
       if (pos == std::string::npos) {
          break;
       }
-      startPos = std::max(pos + replacementSize, targetStrSize);
       targetStr.replace(pos, searchSize, replacement);
+      startPos = pos + replacementSize;
    } while (true);
 }
 
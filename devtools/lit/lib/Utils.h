@@ -93,8 +93,14 @@ std::string join_string_list(const std::list<std::string> &list, const std::stri
 template <typename... ArgTypes>
 std::string format_string(const std::string &format, ArgTypes&&...args)
 {
-   char buffer[256];
-   std::sprintf(buffer, format.c_str(), std::forward<ArgTypes>(args)...);
+   int size = std::snprintf(nullptr, 0, format.c_str(), args...);
+   if (size <= 0) {
+      return std::string();
+   }
+   std::string buffer(size + 1, '\0');
+   std::snprintf(buffer.data(), buffer.size(), format.c_str(), args...);
+   buffer.resize(size);
+   return buffer;
 }
 
 void replace_string(const std::string &search, const std::string &replacement,
@@ -16,12 +16,52 @@
 #include <list>
 #include <cstdlib>
 #include <sys/wait.h>
+#include <sys/time.h>
+#include <sys/resource.h>
 #include <iostream>
 #include <memory>
 
 namespace polar {
 namespace lit {
 
+namespace {
+
+/// every test runs on one worker thread, so accumulating per thread gives
+/// the usage of the processes spawned on behalf of the current test
+thread_local ProcessResourceUsage sg_childResourceUsage;
+
+inline double timeval_to_seconds(const struct timeval &value)
+{
+   return value.tv_sec + value.tv_usec / 1000000.0;
+}
+
+void account_child_resource_usage(const struct rusage &usage) noexcept
+{
+   sg_childResourceUsage.userTime += timeval_to_seconds(usage.ru_utime);
+   sg_childResourceUsage.systemTime += timeval_to_seconds(usage.ru_stime);
+#ifdef POLAR_OS_DARWIN
+   // ru_maxrss is in bytes on Darwin
+   long maxRss = usage.ru_maxrss / 1024;
+#else
+   long maxRss = usage.ru_maxrss;
+#endif
+   if (maxRss > sg_childResourceUsage.maxRss) {
+      sg_childResourceUsage.maxRss = maxRss;
+   }
+}
+
+} // anonymous namespace
+
+void reset_child_resource_usage() noexcept
+{
+   sg_childResourceUsage = ProcessResourceUsage();
+}
+
+const ProcessResourceUsage &get_child_resource_usage() noexcept
+{
+   return sg_childResourceUsage;
+}
+
 bool find_executable(const fs::path &filepath) noexcept
 {
    std::error_code errCode;
@@ -173,7 +213,15 @@ void do_run_program(const std::string &cmd, int &exitCode,
          }
       }
    }
-   while(-1 != waitpid(cpid, &exitCode, 0) || errno == EAGAIN) {}
+   struct rusage usage;
+   while (-1 == wait4(cpid, &exitCode, 0, &usage)) {
+      if (errno != EINTR) {
+         exitCode = -1;
+         errMsg = strerror(errno);
+         return;
+      }
+   }
+   account_child_resource_usage(usage);
    char readBuffer[256];
    ssize_t readed = 0;
    if (0 == exitCode) {
@@ -20,6 +20,18 @@ namespace lit {
 
 namespace fs = std::filesystem;
 
+std::tuple<const ResultCode &, std::string>
+TestFormat::execute(TestPointer test, LitConfigPointer litConfig)
+{
+   return std::tuple<const ResultCode &, std::string>(UNRESOLVED, "format does not implement execute()");
+}
+
+Result TestFormat::executeTest(TestPointer test, LitConfigPointer litConfig)
+{
+   ExecResultTuple execResult = execute(test, litConfig);
+   return Result(std::get<0>(execResult), std::get<1>(execResult));
+}
+
 std::list<std::shared_ptr<Test>>
 FileBasedTest::getTestsInDirectory(TestSuitePointer testSuite,
                                    const std::list<std::string> &pathInSuite,
@@ -41,8 +41,12 @@ public:
                                                                 const std::list<std::string> &pathInSuite,
                                                                 LitConfigPointer litConfig,
                                                                 TestingConfigPointer localConfig) = 0;
-   virtual std::tuple<const ResultCode &, std::string> execute(TestPointer test, LitConfigPointer litConfig)
-   {}
+   /// formats that override neither this nor executeTest() get their tests
+   /// reported as unresolved
+   virtual std::tuple<const ResultCode &, std::string> execute(TestPointer test, LitConfigPointer litConfig);
+   /// formats that report metrics or micro results override this one, the
+   /// default wraps the (code, output) tuple returned by execute()
+   virtual Result executeTest(TestPointer test, LitConfigPointer litConfig);
 };
 
 class FileBasedTest : public TestFormat
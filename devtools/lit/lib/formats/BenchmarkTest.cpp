@@ -0,0 +1,210 @@
+// This source file is part of the polarphp.org open source project
+//
+// Copyright (c) 2017 - 2018 polarphp software foundation
+// Copyright (c) 2017 - 2018 zzu_softboy <zzu_softboy@163.com>
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://polarphp.org/LICENSE.txt for license information
+// See http://polarphp.org/CONTRIBUTORS.txt for the list of polarphp project authors
+//
+// Created by polarboy on 2018/09/22.
+
+#include "BenchmarkTest.h"
+#include "../Utils.h"
+#include "../ProcessUtils.h"
+#include "../LitConfig.h"
+#include "../TestingConfig.h"
+#include "../Test.h"
+#include "nlohmann/json.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <regex>
+
+namespace polar {
+namespace lit {
+
+namespace {
+
+const static std::regex sgc_kbenchmarkLineRegex(
+      "^(.*?\\S)\\s+(-?[0-9][0-9,]*\\.[0-9]+)(\\s+-?[0-9][0-9,]*\\.[0-9]+)?\\s*$");
+
+} // anonymous namespace
+
+BenchmarkTimings parse_benchmark_output(const std::string &output)
+{
+   BenchmarkTimings timings;
+   std::istringstream stream(output);
+   std::string line;
+   while (std::getline(stream, line)) {
+      std::smatch match;
+      if (!std::regex_match(line, match, sgc_kbenchmarkLineRegex)) {
+         continue;
+      }
+      std::string name = match[1].str();
+      if (name == "Total") {
+         continue;
+      }
+      std::string number = match[2].str();
+      number.erase(std::remove(number.begin(), number.end(), ','), number.end());
+      // the micro benchmarks may print the same label twice, keep both
+      std::string key = name;
+      for (int i = 2; timings.find(key) != timings.end(); ++i) {
+         key = name + "#" + std::to_string(i);
+      }
+      timings[key] = std::stod(number);
+   }
+   return timings;
+}
+
+double compute_median(std::vector<double> values)
+{
+   if (values.empty()) {
+      return 0.0;
+   }
+   std::sort(values.begin(), values.end());
+   size_t middle = values.size() / 2;
+   if (values.size() % 2 == 0) {
+      return (values[middle - 1] + values[middle]) / 2;
+   }
+   return values[middle];
+}
+
+double compute_median_absolute_deviation(const std::vector<double> &values)
+{
+   double median = compute_median(values);
+   std::vector<double> deviations;
+   deviations.reserve(values.size());
+   for (double value : values) {
+      deviations.push_back(std::fabs(value - median));
+   }
+   return compute_median(deviations);
+}
+
+BenchmarkTest::BenchmarkTest(const std::string &executable, int iterations,
+                             int warmupIterations, double threshold,
+                             bool updateBaseline)
+   : m_executable(executable),
+     m_iterations(std::max(1, iterations)),
+     m_warmupIterations(std::max(0, warmupIterations)),
+     m_threshold(threshold),
+     m_updateBaseline(updateBaseline)
+{}
+
+std::string BenchmarkTest::getBaselinePath(const std::string &sourcePath)
+{
+   return sourcePath + ".baseline.json";
+}
+
+std::optional<BenchmarkTimings> BenchmarkTest::loadBaseline(const std::string &path)
+{
+   std::ifstream file(path);
+   if (!file.is_open()) {
+      return std::nullopt;
+   }
+   try {
+      nlohmann::json data = nlohmann::json::parse(file);
+      BenchmarkTimings timings;
+      for (auto &item : data.items()) {
+         timings[item.key()] = item.value().get<double>();
+      }
+      return timings;
+   } catch (nlohmann::json::exception &) {
+      return std::nullopt;
+   }
+}
+
+bool BenchmarkTest::saveBaseline(const std::string &path, const BenchmarkTimings &timings)
+{
+   std::ofstream file(path, std::ios::out | std::ios::trunc);
+   if (!file.is_open()) {
+      return false;
+   }
+   file << nlohmann::json(timings).dump(2) << "\n";
+   return file.good();
+}
+
+ExecResultTuple BenchmarkTest::execute(TestPointer test, LitConfigPointer litConfig)
+{
+   Result result = executeTest(test, litConfig);
+   const ResultCode &code = result.getCode();
+   return ExecResultTuple{ResultCode::getInstance(code.getName(), code.isFailure()), result.getOutput()};
+}
+
+Result BenchmarkTest::executeTest(TestPointer test, LitConfigPointer litConfig)
+{
+   if (test->getConfig()->isUnsupported()) {
+      return Result(UNSUPPORTED, "Test is unsupported");
+   }
+   std::string sourcePath = test->getSourcePath();
+   std::map<std::string, std::vector<double>> samples;
+   for (int i = 0; i < m_warmupIterations + m_iterations; ++i) {
+      RunCmdResponse response = run_program(m_executable, std::nullopt, test->getConfig()->getEnvironment(),
+                                            std::nullopt, sourcePath);
+      int exitCode = std::get<0>(response);
+      const std::string &output = std::get<1>(response);
+      if (exitCode != 0) {
+         return Result(FAIL, format_string("Command: %s %s\nexit code: %d\n", m_executable.c_str(),
+                                           sourcePath.c_str(), exitCode) + output + std::get<2>(response));
+      }
+      if (i < m_warmupIterations) {
+         continue;
+      }
+      BenchmarkTimings timings = parse_benchmark_output(output);
+      if (timings.empty()) {
+         return Result(UNRESOLVED, "Unable to find benchmark timings in output:\n" + output);
+      }
+      for (auto &item : timings) {
+         samples[item.first].push_back(item.second);
+      }
+   }
+   std::string baselinePath = getBaselinePath(sourcePath);
+   std::optional<BenchmarkTimings> baseline;
+   if (!m_updateBaseline) {
+      baseline = loadBaseline(baselinePath);
+   }
+   Result result(PASS);
+   BenchmarkTimings medians;
+   double total = 0.0;
+   std::string report;
+   for (auto &item : samples) {
+      const std::string &name = item.first;
+      double median = compute_median(item.second);
+      double mad = compute_median_absolute_deviation(item.second);
+      medians[name] = median;
+      total += median;
+      std::shared_ptr<Result> microResult = std::make_shared<Result>(PASS);
+      microResult->addMetric("median", std::make_shared<RealMetricValue>(median));
+      microResult->addMetric("mad", std::make_shared<RealMetricValue>(mad));
+      microResult->addMetric("samples", std::make_shared<IntMetricValue>(static_cast<int>(item.second.size())));
+      if (baseline.has_value() && baseline.value().find(name) != baseline.value().end() &&
+          baseline.value().at(name) > 0) {
+         double base = baseline.value().at(name);
+         double change = (median - base) / base;
+         microResult->addMetric("baseline", std::make_shared<RealMetricValue>(base));
+         microResult->addMetric("change", std::make_shared<RealMetricValue>(change));
+         // only report a regression when it is larger than the noise of
+         // this run as well
+         if ((median - mad - base) / base > m_threshold) {
+            microResult->setCode(FAIL);
+            result.setCode(FAIL);
+            report += format_string("%s regressed: median %.4fs (MAD %.4fs), baseline %.4fs, %+.1f%%\n",
+                                    name.c_str(), median, mad, base, change * 100);
+         }
+      }
+      result.addMicroResult(name, microResult);
+   }
+   result.addMetric("total", std::make_shared<RealMetricValue>(total));
+   if (m_updateBaseline) {
+      if (!saveBaseline(baselinePath, medians)) {
+         return Result(UNRESOLVED, "Unable to write benchmark baseline " + baselinePath);
+      }
+      litConfig->note("updated benchmark baseline " + baselinePath);
+   }
+   result.setOutput(report);
+   return result;
+}
+
+} // lit
+} // polar
@@ -0,0 +1,70 @@
+// This source file is part of the polarphp.org open source project
+//
+// Copyright (c) 2017 - 2018 polarphp software foundation
+// Copyright (c) 2017 - 2018 zzu_softboy <zzu_softboy@163.com>
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://polarphp.org/LICENSE.txt for license information
+// See http://polarphp.org/CONTRIBUTORS.txt for the list of polarphp project authors
+//
+// Created by polarboy on 2018/09/22.
+
+#ifndef POLAR_DEVLTOOLS_LIT_FORMATS_BENCHMARKTEST_H
+#define POLAR_DEVLTOOLS_LIT_FORMATS_BENCHMARKTEST_H
+
+#include "Base.h"
+#include <map>
+#include <vector>
+#include <optional>
+
+namespace polar {
+namespace lit {
+
+using BenchmarkTimings = std::map<std::string, double>;
+
+/// Parse the report printed by the engine benchmark scripts (bench.php,
+/// micro_bench.php), one "name<padding>seconds" line per sub-benchmark,
+/// the separator and the "Total" lines are skipped.
+BenchmarkTimings parse_benchmark_output(const std::string &output);
+double compute_median(std::vector<double> values);
+double compute_median_absolute_deviation(const std::vector<double> &values);
+
+/**
+ * @brief The BenchmarkTest class
+ *
+ * BenchmarkTest is a format with one benchmark script per test. Every script
+ * is run warmupIterations times without being measured and then iterations
+ * times, the median and the median absolute deviation of every
+ * sub-benchmark are reported as metrics of a micro result.
+ *
+ * When a baseline file exists next to the script (script + ".baseline.json",
+ * a {"name": seconds} object), the test fails if the median of a
+ * sub-benchmark exceeds its baseline by more than threshold (a ratio, 0.10
+ * is 10%) even after subtracting the measured MAD. With updateBaseline the
+ * medians of the run are written as the new baseline instead.
+ */
+class BenchmarkTest : public FileBasedTest
+{
+public:
+   BenchmarkTest(const std::string &executable, int iterations = 5,
+                 int warmupIterations = 1, double threshold = 0.10,
+                 bool updateBaseline = false);
+   ExecResultTuple execute(TestPointer test, LitConfigPointer litConfig);
+   Result executeTest(TestPointer test, LitConfigPointer litConfig);
+
+   static std::string getBaselinePath(const std::string &sourcePath);
+   static std::optional<BenchmarkTimings> loadBaseline(const std::string &path);
+   static bool saveBaseline(const std::string &path, const BenchmarkTimings &timings);
+
+protected:
+   std::string m_executable;
+   int m_iterations;
+   int m_warmupIterations;
+   double m_threshold;
+   bool m_updateBaseline;
+};
+
+} // lit
+} // polar
+
+#endif // POLAR_DEVLTOOLS_LIT_FORMATS_BENCHMARKTEST_H
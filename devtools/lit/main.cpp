@@ -13,13 +13,30 @@
 #include "Config.h"
 #include "lib/Utils.h"
 #include "lib/LitConfig.h"
+#include "lib/Discovery.h"
+#include "lib/Run.h"
+#include "lib/TestDatabase.h"
+#include "lib/ResultsWriter.h"
 #include <iostream>
 #include <thread>
 #include <assert.h>
 #include <filesystem>
 #include <list>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
 
 using polar::lit::LitConfig;
+using polar::lit::LitConfigPointer;
+using polar::lit::TestSuitePointer;
+using polar::lit::TestList;
+using polar::lit::Run;
+using polar::lit::RunPointer;
+using polar::lit::TestDatabase;
+using polar::lit::TestDatabasePointer;
+using polar::lit::TestPointer;
+using polar::lit::JSONLinesResultsWriter;
+using polar::lit::JSONLinesResultsWriterPointer;
 namespace fs = std::filesystem;
 
 namespace {
@@ -33,6 +50,29 @@ std::list<std::string> vector_to_list(const std::vector<std::string> &items)
    return ret;
 }
 
+void print_slowest_tests(const TestList &tests, size_t count = 20)
+{
+   std::vector<std::tuple<std::string, double>> testTimes;
+   for (const TestPointer &test : tests) {
+      const std::optional<polar::lit::Result> &result = test->getResult();
+      if (result.has_value() && result.value().getElapsed().has_value()) {
+         testTimes.emplace_back(test->getFullName(), result.value().getElapsed().value());
+      }
+   }
+   std::sort(testTimes.begin(), testTimes.end(),
+             [](const std::tuple<std::string, double> &lhs,
+             const std::tuple<std::string, double> &rhs) -> bool {
+      return std::get<1>(lhs) > std::get<1>(rhs);
+   });
+   if (testTimes.size() > count) {
+      testTimes.resize(count);
+   }
+   std::printf("\nSlowest Tests:\n%s\n", std::string(20, '-').c_str());
+   for (auto &item : testTimes) {
+      std::printf("%8.2fs: %s\n", std::get<1>(item), std::get<0>(item).c_str());
+   }
+}
+
 } // anonymous namespace
 
 int main(int argc, char *argv[])
@@ -78,6 +118,7 @@ int main(int argc, char *argv[])
    bool timeTests;
    bool noExecute;
    std::string xunitOutputFile;
+   std::string jsonLinesOutputFile;
    int maxIndividualTestTime;
    int maxFailures;
    litApp.add_option("--path", paths, "Additional paths to add to testing environment", false)->group("Test Execution");
@@ -87,6 +128,8 @@ int main(int argc, char *argv[])
    litApp.add_option("--time-tests", timeTests, "Track elapsed wall time for each test", false)->group("Test Execution");
    litApp.add_option("--no-execute", noExecute, "Don't execute any tests (assume PASS)", false)->group("Test Execution");
    litApp.add_option("--xunit-xml-output", xunitOutputFile, "Write XUnit-compatible XML test reports to the  specified file")->group("Test Execution");
+   litApp.add_option("--json-lines-output", jsonLinesOutputFile, "Stream per-test results, timings, resource usage and "
+                                                                 "metrics as JSON lines to the specified file")->group("Test Execution");
    litApp.add_option("--timeout", maxIndividualTestTime, "Maximum time to spend running a single test (in seconds)."
                                                          "0 means no time limit. [Default: 0]", 0)->group("Test Execution");
    CLI::Option *maxFailuresOpt = litApp.add_option("--max-failures", maxFailures, "Stop execution after the given number of failures.", 0)->group("Test Execution");
@@ -102,8 +145,8 @@ int main(int argc, char *argv[])
    litApp.add_option("--max-tests", maxTests, "Maximum number of tests to run")->group("Test Selection");
    litApp.add_option("--max-time", maxTime, "Maximum time to spend testing (in seconds)")->group("Test Selection");
    litApp.add_option("--shuffle", shuffle, "Run tests in random order", false)->group("Test Selection");
-   litApp.add_option("-i, --incremental", incremental, "Run modified and failing tests first (updates "
-                                                       "mtimes)", false)->group("Test Selection");
+   litApp.add_option("-i, --incremental", incremental, "Only run tests whose inputs changed and tests that "
+                                                       "failed last time (failing tests first)", false)->group("Test Selection");
    litApp.add_option("--filter", filter, "Only run tests with paths matching the given "
                                          "regular expression")->envname("LIT_FILTER")->group("Test Selection");
    litApp.add_option("--num-shards", numShards, "Split testsuite into M pieces and only run one")->envname("LIT_NUM_SHARDS")->group("Test Selection");
@@ -152,7 +195,7 @@ int main(int argc, char *argv[])
       }
    }
    // Create the global config object.
-   LitConfig litConfig(
+   LitConfigPointer litConfig = std::make_shared<LitConfig>(
             fs::path(argv[0]).filename(),
          vector_to_list(paths),
          quiet,
@@ -175,6 +218,61 @@ int main(int argc, char *argv[])
    echoAllCommands
          );
    // Perform test discovery.
-   return 0;
+   std::list<std::tuple<TestSuitePointer, TestList>> searchResults =
+         polar::lit::find_tests_for_inputs(litConfig, vector_to_list(inputs));
+   TestList tests;
+   for (auto &item : searchResults) {
+      TestList &subtests = std::get<1>(item);
+      tests.insert(tests.end(), subtests.begin(), subtests.end());
+   }
+   RunPointer run = std::make_shared<Run>(litConfig, tests);
+   TestDatabasePointer testDatabase;
+   if (incremental && !searchResults.empty()) {
+      TestSuitePointer firstSuite = std::get<0>(searchResults.front());
+      fs::path dbPath = fs::path(firstSuite->getExecPath({})) / polar::lit::sgc_kdefaultTestDatabaseName;
+      testDatabase = std::make_shared<TestDatabase>(dbPath.string());
+      testDatabase->load();
+      size_t numDiscovered = run->getTests().size();
+      run->selectIncrementalTests(testDatabase);
+      if (!quiet) {
+         std::cout << "-- Incremental: selected " << run->getTests().size() << " of "
+                   << numDiscovered << " tests --" << std::endl;
+      }
+   }
+   JSONLinesResultsWriterPointer resultsWriter;
+   if (!jsonLinesOutputFile.empty()) {
+      resultsWriter = std::make_shared<JSONLinesResultsWriter>(jsonLinesOutputFile);
+      if (!resultsWriter->isOpen()) {
+         litConfig->fatal("unable to open results file " + jsonLinesOutputFile);
+      }
+   }
+   run->execute(threadNumbers, [&resultsWriter](TestPointer test) {
+      if (resultsWriter) {
+         resultsWriter->writeResult(test);
+      }
+   });
+   if (resultsWriter) {
+      std::map<std::string, int> codeCounts;
+      for (const TestPointer &test : run->getTests()) {
+         if (test->getResult().has_value()) {
+            codeCounts[test->getResult().value().getCode().getName()] += 1;
+         }
+      }
+      resultsWriter->writeSummary(run->getElapsed(), codeCounts);
+   }
+   if (timeTests) {
+      print_slowest_tests(run->getTests());
+   }
+   if (!xunitOutputFile.empty() &&
+       !polar::lit::write_xunit_xml_results(xunitOutputFile, run->getTests())) {
+      litConfig->warning("unable to write xunit results to " + xunitOutputFile);
+   }
+   if (testDatabase) {
+      run->updateTestDatabase(testDatabase);
+      if (!testDatabase->save()) {
+         litConfig->warning("unable to write test database " + testDatabase->getDbPath());
+      }
+   }
+   return run->getNumFailures() > 0 ? 1 : 0;
 }
 
@@ -0,0 +1,106 @@
+// This source file is part of the polarphp.org open source project
+//
+// Copyright (c) 2017 - 2018 polarphp software foundation
+// Copyright (c) 2017 - 2018 zzu_softboy <zzu_softboy@163.com>
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://polarphp.org/LICENSE.txt for license information
+// See http://polarphp.org/CONTRIBUTORS.txt for the list of polarphp project authors
+//
+// Created by polarboy on 2018/09/22.
+
+#include <gtest/gtest.h>
+#include "formats/BenchmarkTest.h"
+#include "Test.h"
+#include <string>
+#include <fstream>
+#include <filesystem>
+
+namespace {
+
+namespace fs = std::filesystem;
+using polar::lit::BenchmarkTest;
+using polar::lit::BenchmarkTimings;
+using polar::lit::Result;
+using polar::lit::TestSuite;
+using polar::lit::TestingConfig;
+
+const char *sg_benchOutput =
+      "simple             0.070\n"
+      "mandel             0.135\n"
+      "hash1(50000)       0.021\n"
+      "------------------------\n"
+      "Total              0.226\n";
+
+class BenchmarkTestTest : public ::testing::Test
+{
+public:
+   virtual void SetUp() override
+   {
+      std::error_code errcode;
+      fs::remove_all(sm_tempDir, errcode);
+      if (!fs::create_directories(sm_tempDir, errcode)) {
+         FAIL() << errcode.message();
+      }
+      std::ofstream file(sm_tempDir / "bench.txt");
+      file << sg_benchOutput;
+   }
+
+   virtual void TearDown() override
+   {
+      std::error_code errcode;
+      fs::remove_all(sm_tempDir, errcode);
+   }
+
+   static fs::path sm_tempDir;
+};
+
+fs::path BenchmarkTestTest::sm_tempDir{fs::path(UNITTEST_TEMP_DIR) / "benchmark"};
+
+TEST_F(BenchmarkTestTest, testParseBenchmarkOutput)
+{
+   BenchmarkTimings timings = polar::lit::parse_benchmark_output(sg_benchOutput);
+   BenchmarkTimings expected{{"simple", 0.070}, {"mandel", 0.135}, {"hash1(50000)", 0.021}};
+   ASSERT_EQ(timings, expected);
+   // micro_bench.php prints an overhead adjusted second column
+   timings = polar::lit::parse_benchmark_output("$x = $this->x           0.110    0.052\n"
+                                                "empty_loop              0.058\n"
+                                                "Total                   1,234.500\n");
+   expected = BenchmarkTimings{{"$x = $this->x", 0.110}, {"empty_loop", 0.058}};
+   ASSERT_EQ(timings, expected);
+}
+
+TEST_F(BenchmarkTestTest, testMedianAndMad)
+{
+   ASSERT_DOUBLE_EQ(polar::lit::compute_median({}), 0.0);
+   ASSERT_DOUBLE_EQ(polar::lit::compute_median({3.0, 1.0, 2.0}), 2.0);
+   ASSERT_DOUBLE_EQ(polar::lit::compute_median({4.0, 1.0, 2.0, 3.0}), 2.5);
+   ASSERT_DOUBLE_EQ(polar::lit::compute_median_absolute_deviation({1.0, 2.0, 3.0, 4.0, 100.0}), 1.0);
+}
+
+TEST_F(BenchmarkTestTest, testBaselineRegression)
+{
+   std::string sourcePath = (sm_tempDir / "bench.txt").string();
+   auto config = std::make_shared<TestingConfig>();
+   auto suite = std::make_shared<TestSuite>("bench", sm_tempDir.string(), sm_tempDir.string(), config);
+   auto test = std::make_shared<polar::lit::Test>(suite, std::list<std::string>{"bench.txt"}, config);
+   // "cat" replays the recorded report of the benchmark script
+   BenchmarkTest format("cat", 3, 1, 0.10);
+   {
+      Result result = format.executeTest(test, nullptr);
+      ASSERT_EQ(result.getCode(), polar::lit::PASS);
+      ASSERT_EQ(result.getMicroResults().size(), 3);
+      ASSERT_EQ(result.getMicroResults().at("mandel")->getMetrics().at("median")->format(), "0.1350");
+   }
+   {
+      ASSERT_TRUE(BenchmarkTest::saveBaseline(BenchmarkTest::getBaselinePath(sourcePath),
+                                              {{"simple", 0.069}, {"mandel", 0.100}}));
+      Result result = format.executeTest(test, nullptr);
+      ASSERT_EQ(result.getCode(), polar::lit::FAIL);
+      ASSERT_EQ(result.getMicroResults().at("simple")->getCode(), polar::lit::PASS);
+      ASSERT_EQ(result.getMicroResults().at("mandel")->getCode(), polar::lit::FAIL);
+      ASSERT_NE(result.getOutput().find("mandel regressed"), std::string::npos);
+   }
+}
+
+} // anonymous namespace
@@ -98,6 +98,20 @@ TEST_F(ProcessUtilsTest, testLookPath)
    }
 }
 
+TEST_F(ProcessUtilsTest, testChildResourceUsage)
+{
+   polar::lit::reset_child_resource_usage();
+   ASSERT_EQ(polar::lit::get_child_resource_usage().maxRss, 0);
+   polar::lit::RunCmdResponse response = polar::lit::run_program("ls");
+   ASSERT_EQ(std::get<0>(response), 0);
+   const polar::lit::ProcessResourceUsage &usage = polar::lit::get_child_resource_usage();
+   ASSERT_GT(usage.maxRss, 0);
+   ASSERT_GE(usage.userTime, 0.0);
+   ASSERT_GE(usage.systemTime, 0.0);
+   polar::lit::reset_child_resource_usage();
+   ASSERT_EQ(polar::lit::get_child_resource_usage().maxRss, 0);
+}
+
 TEST_F(ProcessUtilsTest, testCallPgrepCommand)
 {
    std::set<pid_t> processes;
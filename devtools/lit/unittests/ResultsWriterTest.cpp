@@ -0,0 +1,79 @@
+// This source file is part of the polarphp.org open source project
+//
+// Copyright (c) 2017 - 2018 polarphp software foundation
+// Copyright (c) 2017 - 2018 zzu_softboy <zzu_softboy@163.com>
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://polarphp.org/LICENSE.txt for license information
+// See http://polarphp.org/CONTRIBUTORS.txt for the list of polarphp project authors
+//
+// Created by polarboy on 2018/09/21.
+
+#include <gtest/gtest.h>
+#include "ResultsWriter.h"
+#include <string>
+#include <fstream>
+#include <filesystem>
+
+namespace {
+
+namespace fs = std::filesystem;
+using polar::lit::Result;
+using polar::lit::JSONLinesResultsWriter;
+using polar::lit::IntMetricValue;
+using polar::lit::RealMetricValue;
+using polar::lit::JSONMetricValue;
+using polar::lit::ProcessResourceUsage;
+
+TEST(ResultsWriterTest, testResultToJson)
+{
+   Result result(polar::lit::PASS, "", 1.5);
+   ProcessResourceUsage usage;
+   usage.userTime = 0.25;
+   usage.systemTime = 0.5;
+   usage.maxRss = 2048;
+   result.setResourceUsage(usage);
+   result.addMetric("count", std::make_shared<IntMetricValue>(3));
+   result.addMetric("ratio", std::make_shared<RealMetricValue>(0.5));
+   result.addMetric("info", std::make_shared<JSONMetricValue>(nlohmann::json{{"key", "value"}}));
+   auto microResult = std::make_shared<Result>(polar::lit::FAIL);
+   microResult->addMetric("count", std::make_shared<IntMetricValue>(1));
+   result.addMicroResult("sub", microResult);
+   nlohmann::json data = polar::lit::result_to_json(result);
+   ASSERT_EQ(data["code"], "PASS");
+   ASSERT_EQ(data["elapsed"], 1.5);
+   ASSERT_EQ(data["user_time"], 0.25);
+   ASSERT_EQ(data["system_time"], 0.5);
+   ASSERT_EQ(data["peak_rss_kb"], 2048);
+   ASSERT_EQ(data["metrics"]["count"], 3);
+   ASSERT_EQ(data["metrics"]["ratio"], 0.5);
+   ASSERT_EQ(data["metrics"]["info"]["key"], "value");
+   ASSERT_EQ(data["micro_results"]["sub"]["code"], "FAIL");
+   ASSERT_EQ(data["micro_results"]["sub"]["metrics"]["count"], 1);
+}
+
+TEST(ResultsWriterTest, testWriteSummaryLines)
+{
+   fs::path tempDir(UNITTEST_TEMP_DIR);
+   std::error_code errcode;
+   fs::create_directories(tempDir, errcode);
+   fs::path filename = tempDir / "results.jsonl";
+   {
+      JSONLinesResultsWriter writer(filename.string());
+      ASSERT_TRUE(writer.isOpen());
+      writer.writeSummary(2.0, {{"PASS", 2}, {"FAIL", 1}});
+      writer.writeSummary(3.0, {{"PASS", 3}});
+   }
+   std::ifstream stream(filename);
+   std::string line;
+   std::list<nlohmann::json> lines;
+   while (std::getline(stream, line)) {
+      lines.push_back(nlohmann::json::parse(line));
+   }
+   ASSERT_EQ(lines.size(), 2);
+   ASSERT_EQ(lines.front()["summary"]["codes"]["FAIL"], 1);
+   ASSERT_EQ(lines.back()["summary"]["elapsed"], 3.0);
+   fs::remove(filename, errcode);
+}
+
+} // anonymous namespace
@@ -0,0 +1,140 @@
+// This source file is part of the polarphp.org open source project
+//
+// Copyright (c) 2017 - 2018 polarphp software foundation
+// Copyright (c) 2017 - 2018 zzu_softboy <zzu_softboy@163.com>
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See http://polarphp.org/LICENSE.txt for license information
+// See http://polarphp.org/CONTRIBUTORS.txt for the list of polarphp project authors
+//
+// Created by polarboy on 2018/09/20.
+
+#include <gtest/gtest.h>
+#include "TestDatabase.h"
+#include <string>
+#include <fstream>
+#include <filesystem>
+
+namespace {
+
+namespace fs = std::filesystem;
+using polar::lit::TestDatabase;
+using polar::lit::TestSuite;
+using polar::lit::TestPointer;
+using polar::lit::TestList;
+using polar::lit::TestingConfig;
+
+class TestDatabaseTest : public ::testing::Test
+{
+public:
+   virtual void SetUp() override
+   {
+      std::error_code errcode;
+      if (fs::exists(sm_tempDir)) {
+         fs::remove_all(sm_tempDir, errcode);
+      }
+      if (!fs::create_directories(sm_tempDir, errcode)) {
+         FAIL() << errcode.message();
+      }
+      m_config = std::make_shared<TestingConfig>();
+      m_suite = std::make_shared<TestSuite>("suite", sm_tempDir.string(), sm_tempDir.string(), m_config);
+   }
+
+   virtual void TearDown() override
+   {
+      std::error_code errcode;
+      fs::remove_all(sm_tempDir, errcode);
+   }
+
+   void writeFile(const std::string &name, const std::string &content)
+   {
+      std::ofstream file(sm_tempDir / name, std::ios::out | std::ios::trunc);
+      file << content;
+   }
+
+   TestPointer makeTest(const std::string &name)
+   {
+      return std::make_shared<polar::lit::Test>(m_suite, std::list<std::string>{name}, m_config);
+   }
+
+   std::shared_ptr<TestingConfig> m_config;
+   std::shared_ptr<TestSuite> m_suite;
+   static fs::path sm_tempDir;
+};
+
+fs::path TestDatabaseTest::sm_tempDir{fs::path(UNITTEST_TEMP_DIR) / "testdb"};
+
+TEST_F(TestDatabaseTest, testHashFileContent)
+{
+   writeFile("a.txt", "polarphp");
+   writeFile("b.txt", "polarphp");
+   writeFile("c.txt", "polarphp!");
+   auto hashA = polar::lit::hash_file_content((sm_tempDir / "a.txt").string());
+   auto hashB = polar::lit::hash_file_content((sm_tempDir / "b.txt").string());
+   auto hashC = polar::lit::hash_file_content((sm_tempDir / "c.txt").string());
+   ASSERT_TRUE(hashA.has_value());
+   ASSERT_EQ(hashA.value(), hashB.value());
+   ASSERT_NE(hashA.value(), hashC.value());
+   ASSERT_FALSE(polar::lit::hash_file_content((sm_tempDir / "missing.txt").string()).has_value());
+   ASSERT_EQ(polar::lit::hash_to_hex(0x1f), "000000000000001f");
+}
+
+TEST_F(TestDatabaseTest, testCollectDependencies)
+{
+   writeFile("input.txt", "data");
+   writeFile("test.php", "// RUN: polarphp %s < %S/input.txt | FileCheck %s\n"
+                         "// RUN: polarphp -d x=1 %p/missing.txt > %t\n");
+   TestDatabase database((sm_tempDir / "db.json").string());
+   std::list<std::string> deps = database.collectDependencies(makeTest("test.php"));
+   ASSERT_EQ(deps.size(), 2);
+   ASSERT_EQ(deps.front(), (sm_tempDir / "test.php").string());
+   ASSERT_EQ(deps.back(), (sm_tempDir / "input.txt").string());
+}
+
+TEST_F(TestDatabaseTest, testSelectTests)
+{
+   writeFile("input.txt", "data");
+   writeFile("pass.php", "// RUN: polarphp %s < %S/input.txt\n");
+   writeFile("fail.php", "// RUN: polarphp %s\n");
+   writeFile("other.php", "// RUN: polarphp %s\n");
+   std::string dbPath = (sm_tempDir / "db.json").string();
+   TestList tests{makeTest("pass.php"), makeTest("fail.php"), makeTest("other.php")};
+   {
+      TestDatabase database(dbPath);
+      ASSERT_FALSE(database.load());
+      ASSERT_EQ(database.selectTests(tests).size(), 3);
+      auto iter = tests.begin();
+      database.recordResult(*iter++, polar::lit::PASS);
+      database.recordResult(*iter++, polar::lit::FAIL);
+      database.recordResult(*iter++, polar::lit::PASS);
+      ASSERT_TRUE(database.save());
+      ASSERT_FALSE(fs::exists(dbPath + ".tmp"));
+   }
+   {
+      // nothing changed, only the failing test is selected
+      TestDatabase database(dbPath);
+      ASSERT_TRUE(database.load());
+      ASSERT_EQ(database.getEntryCount(), 3);
+      TestList selected = database.selectTests(tests);
+      ASSERT_EQ(selected.size(), 1);
+      ASSERT_EQ(selected.front()->getSourcePath(), (sm_tempDir / "fail.php").string());
+   }
+   {
+      // a modified dependency selects the test again, after the failing one
+      writeFile("input.txt", "changed data");
+      TestDatabase database(dbPath);
+      ASSERT_TRUE(database.load());
+      TestList selected = database.selectTests(tests);
+      ASSERT_EQ(selected.size(), 2);
+      ASSERT_EQ(selected.front()->getSourcePath(), (sm_tempDir / "fail.php").string());
+      ASSERT_EQ(selected.back()->getSourcePath(), (sm_tempDir / "pass.php").string());
+   }
+   {
+      writeFile(dbPath, "{ corrupted");
+      TestDatabase database(dbPath);
+      ASSERT_FALSE(database.load());
+      ASSERT_EQ(database.selectTests(tests).size(), 3);
+   }
+}
+
+} // anonymous namespace
@@ -210,4 +210,9 @@ TEST_F(UtilsTest, testReplaceString)
       polar::lit::replace_string("php", "polarphp", str);
       ASSERT_EQ(str, "aaabbbccc");
    }
+   {
+      std::string str("%s | FileCheck %s");
+      polar::lit::replace_string("%s", "a%s.php", str);
+      ASSERT_EQ(str, "a%s.php | FileCheck a%s.php");
+   }
 }
@@ -176,6 +176,9 @@
 /* whether the compiler supports __attribute__ ((__aligned__)) */
 #cmakedefine HAVE_ATTRIBUTE_ALIGNED
 
+/* whether the compiler supports __attribute__ ((target ("..."))) */
+#cmakedefine HAVE_FUNC_ATTRIBUTE_TARGET
+
 /* Whether you have bcmath */
 #cmakedefine HAVE_BCMATH
 
@@ -1364,6 +1367,12 @@
 /* Define to 1 if you have the <sys/ioctl.h> header file. */
 #cmakedefine01 HAVE_SYS_IOCTL_H
 
+/* Define to 1 if you have the <sys/inotify.h> header file. */
+#cmakedefine01 HAVE_SYS_INOTIFY_H
+
+/* Define if you have the <immintrin.h> header file. */
+#cmakedefine HAVE_IMMINTRIN_H
+
 /* Define to 1 if you have the <sys/ipc.h> header file. */
 #cmakedefine01 HAVE_SYS_IPC_H
 
@@ -1520,6 +1529,9 @@
 /* */
 #cmakedefine HAVE_UNIXODBC
 
+/* Define to 1 if you have the <ucontext.h> header file. */
+#cmakedefine01 HAVE_UCONTEXT_H
+
 /* Define to 1 if you have the <unix.h> header file. */
 #cmakedefine HAVE_UNIX_H
 
@@ -1679,6 +1691,9 @@
 /* Define if your system has fork/vfork/CreateProcess */
 #cmakedefine PHP_CAN_SUPPORT_PROC_OPEN
 
+/* Whether the assembler supports AVX2 instructions */
+#cmakedefine01 PHP_HAVE_AVX2_INSTRUCTIONS
+
 /* Whether the compiler supports __builtin_clz */
 #cmakedefine01 PHP_HAVE_BUILTIN_CLZ
 
@@ -231,6 +231,270 @@ function ternary2($n) {
 	}
 }
 
+function yield_values($n) {
+	for ($i = 0; $i < $n; ++$i) {
+		yield $i;
+	}
+}
+
+function yield_from($gen) {
+	yield from $gen;
+}
+
+function yield_from_chain($n, $depth) {
+	$gen = yield_values($n);
+	for ($i = 0; $i < $depth; ++$i) {
+		$gen = yield_from($gen);
+	}
+	foreach ($gen as $x) {
+	}
+}
+
+function long_string($len, $seed) {
+	$str = "";
+	for ($i = 0; $i < $len; ++$i) {
+		$str .= chr(ord('a') + ($i * 7 + $seed) % 26);
+	}
+	return $str;
+}
+
+function str_casecmp($n) {
+	$a = long_string(256, 0);
+	$b = strtoupper($a);
+	for ($i = 0; $i < $n; ++$i) {
+		$x = strcasecmp($a, $b);
+	}
+}
+
+function str_find($n) {
+	$hay = long_string(1024, 0);
+	$needle = long_string(12, 3) . "!";
+	for ($i = 0; $i < $n; ++$i) {
+		$x = strpos($hay, $needle);
+	}
+}
+
+function str_rfind($n) {
+	$hay = long_string(1024, 0);
+	$needle = long_string(12, 3) . "!";
+	for ($i = 0; $i < $n; ++$i) {
+		$x = strrpos($hay, $needle);
+	}
+}
+
+function lc_lookup($n) {
+	$name = "Long_Mixed_Case_Function_Name_That_Does_Not_Exist";
+	for ($i = 0; $i < $n; ++$i) {
+		$x = function_exists($name);
+	}
+}
+
+function read_hash_long_key($n) {
+	$key = long_string(64, 0);
+	$hash = array($key => 1);
+	$key = long_string(64, 0);
+	for ($i = 0; $i < $n; ++$i) {
+		$x = $hash[$key];
+	}
+}
+
+function float_to_str($n) {
+	$f = 0.1;
+	for ($i = 0; $i < $n; ++$i) {
+		$x = (string)$f;
+		$f += 1.37;
+	}
+}
+
+function str_to_float($n) {
+	$str = "1234.5678901234567";
+	for ($i = 0; $i < $n; ++$i) {
+		$x = (float)$str;
+	}
+}
+
+function int_to_str($n) {
+	for ($i = 0; $i < $n; ++$i) {
+		$x = (string)($i * 7919);
+	}
+}
+
+function read_hash_numeric_str($n) {
+	$hash = array(1234567890123 => 1);
+	$key = "1234567890123";
+	for ($i = 0; $i < $n; ++$i) {
+		$x = $hash[$key];
+	}
+}
+
+interface PolyShape {
+	function area();
+}
+
+class PolyA implements PolyShape {
+	public $w = 1;
+	function area() { return 1; }
+}
+
+class PolyB implements PolyShape {
+	public $h = 0;
+	public $w = 2;
+	function area() { return 2; }
+}
+
+class PolyC implements PolyShape {
+	public $h = 0;
+	public $d = 0;
+	public $w = 3;
+	function area() { return 3; }
+}
+
+class PolyD extends PolyA {
+	function area() { return 4; }
+}
+
+function poly_method_call($n) {
+	$objs = array(new PolyA, new PolyB, new PolyC, new PolyD);
+	for ($i = 0; $i < $n; ++$i) {
+		$x = $objs[$i & 3]->area();
+	}
+}
+
+function poly_prop_read($n) {
+	$objs = array(new PolyA, new PolyB, new PolyC, new PolyD);
+	for ($i = 0; $i < $n; ++$i) {
+		$x = $objs[$i & 3]->w;
+	}
+}
+
+class DynRow {
+	public $id;
+}
+
+function dyn_prop_hydrate($n) {
+	for ($i = 0; $i < $n; ++$i) {
+		$o = new DynRow;
+		$o->name = "x";
+		$o->email = "y";
+		$o->age = $i;
+	}
+}
+
+interface DeepI1 {}
+interface DeepI2 {}
+interface DeepI3 extends DeepI1 {}
+class Deep0 implements DeepI2 {}
+class Deep1 extends Deep0 {}
+class Deep2 extends Deep1 implements DeepI3 {}
+class Deep3 extends Deep2 {}
+class Deep4 extends Deep3 {}
+
+function deep_instanceof($n) {
+	$o = new Deep4;
+	for ($i = 0; $i < $n; ++$i) {
+		$x = $o instanceof Deep0;
+		$x = $o instanceof DeepI1;
+	}
+}
+
+class Point {
+	public $x;
+	public $y;
+}
+
+function object_churn($n) {
+	$ring = array_fill(0, 16, null);
+	for ($i = 0; $i < $n; ++$i) {
+		$ring[$i & 15] = new Point;
+	}
+}
+
+class ResultRow {
+	public $id, $name, $email, $created, $status, $score;
+}
+
+class Money {
+	public $amount = 0;
+	public $currency = "EUR";
+
+	public function withAmount($amount) {
+		$new = clone $this;
+		$new->amount = $amount;
+		return $new;
+	}
+}
+
+class LazyProxy {
+	private $data = ["id" => 1, "name" => "x"];
+
+	public function __get($name) {
+		/* loads go through another magic property */
+		return $name === "row" ? $this->data : $this->row[$name];
+	}
+}
+
+function magic_get_nested($n) {
+	for ($i = 0; $i < $n; ++$i) {
+		$o = new LazyProxy;
+		$x = $o->id;
+		$x = $o->name;
+	}
+}
+
+function packed_append_scan($n) {
+	$list = [];
+	for ($i = 0; $i < $n; ++$i) {
+		$list[] = $i;
+	}
+	$sum = 0;
+	foreach ($list as $k => $v) {
+		$sum += $v;
+	}
+}
+
+function frozen_route_lookup($n) {
+	$routes = [];
+	for ($i = 0; $i < 64; ++$i) {
+		$routes["/page/$i"] = ["controller" => "Page", "action" => "show", "id" => $i];
+	}
+	frozen_array_publish("routes", $routes);
+	for ($i = 0; $i < $n; ++$i) {
+		$r = frozen_array_get("routes");
+		$x = $r["/page/7"]["action"];
+	}
+	frozen_array_publish("routes", null);
+}
+
+function result_rows_to_arrays($n) {
+	$row = new ResultRow;
+	$row->name = "name";
+	$row->email = "name@example.com";
+	$row->created = "2018-01-01 00:00:00";
+	$row->status = 1;
+	$row->score = 0.5;
+	for ($i = 0; $i < $n; ++$i) {
+		$row->id = $i;
+		$x = get_object_vars($row);
+	}
+}
+
+function trace_frame($depth) {
+	return $depth ? trace_frame($depth - 1) : new Exception;
+}
+
+function exception_trace_rows($n) {
+	for ($i = 0; $i < $n; ++$i) {
+		$x = trace_frame(4)->getTrace();
+	}
+}
+
+function clone_wither($n) {
+	$m = new Money;
+	for ($i = 0; $i < $n; ++$i) {
+		$x = $m->withAmount($i);
+	}
+}
+
 /*****/
 
 function empty_loop($n) {
@@ -355,4 +619,50 @@ ternary(N);
 $t = end_test($t, '$x = $f ? $f : $a', $overhead);
 ternary2(N);
 $t = end_test($t, '$x = $f ? $f : tmp', $overhead);
+yield_from_chain(N, 1);
+$t = end_test($t, 'yield from (1 deep)', $overhead);
+yield_from_chain(N, 10);
+$t = end_test($t, 'yield from (10 deep)', $overhead);
+yield_from_chain(N, 100);
+$t = end_test($t, 'yield from (100 deep)', $overhead);
+str_casecmp(N);
+$t = end_test($t, 'strcasecmp(256)', $overhead);
+str_find(N);
+$t = end_test($t, 'strpos(1024)', $overhead);
+str_rfind(N);
+$t = end_test($t, 'strrpos(1024)', $overhead);
+lc_lookup(N);
+$t = end_test($t, 'function_exists()', $overhead);
+read_hash_long_key(N);
+$t = end_test($t, '$x = $hash[$long]', $overhead);
+float_to_str(N);
+$t = end_test($t, '$x = (string)$float', $overhead);
+str_to_float(N);
+$t = end_test($t, '$x = (float)$str', $overhead);
+int_to_str(N);
+$t = end_test($t, '$x = (string)$int', $overhead);
+read_hash_numeric_str(N);
+$t = end_test($t, '$x = $hash["123..."]', $overhead);
+poly_method_call(N);
+$t = end_test($t, '$o->f() (4 cls)', $overhead);
+poly_prop_read(N);
+$t = end_test($t, '$x = $o->p (4 cls)', $overhead);
+dyn_prop_hydrate(N);
+$t = end_test($t, 'new + 3 dyn props', $overhead);
+deep_instanceof(N);
+$t = end_test($t, 'instanceof (deep)', $overhead);
+object_churn(N);
+$t = end_test($t, 'new Point (16 live)', $overhead);
+clone_wither(N);
+$t = end_test($t, 'clone + write', $overhead);
+magic_get_nested(N);
+$t = end_test($t, 'new + nested __get', $overhead);
+packed_append_scan(N);
+$t = end_test($t, '$list[] = $i + foreach', $overhead);
+frozen_route_lookup(N);
+$t = end_test($t, 'frozen_array_get()', $overhead);
+result_rows_to_arrays(N);
+$t = end_test($t, 'get_object_vars($row)', $overhead);
+exception_trace_rows(N);
+$t = end_test($t, 'getTrace() (5 frames)', $overhead);
 total($t0, "Total");
@@ -0,0 +1,61 @@
+--TEST--
+Scripts larger than the scanner window are compiled while they are read
+--FILE--
+<?php
+$block = <<<'BLOCK'
+// line comment with a "quote" and a 'quote'
+/* block comment
+ * spanning lines */
+$r[] = 'single \' quoted';
+$r[] = "double {$n} \"$n\"";
+$r[] = <<<EOT
+    heredoc $n
+      indented
+    EOT;
+$r[] = <<<'EOT'
+nowdoc $n
+EOT;
+$r[] = (function () { return __LINE__; })();
+$n++;
+?>
+<?php
+
+BLOCK;
+
+$filename = dirname(__FILE__)."/chunked_script_scanning.tmp.php";
+$script = "<?php\n" . str_repeat($block, 4000) . "return __COMPILER_HALT_OFFSET__;\n__halt_compiler();trailing data";
+file_put_contents($filename, $script);
+var_dump(strlen($script) > 1024 * 1024);
+
+$n = 0;
+$r = [];
+$offset = include $filename;
+
+var_dump($n, count($r));
+var_dump(array_slice($r, 5, 4));
+$lines = [];
+for ($i = 4; $i < count($r); $i += 5) {
+	$lines[$r[$i]] = true;
+}
+var_dump(count($lines));
+var_dump($offset == strpos($script, "trailing data"));
+?>
+--CLEAN--
+<?php unlink(dirname(__FILE__)."/chunked_script_scanning.tmp.php"); ?>
+--EXPECT--
+bool(true)
+int(4000)
+int(20000)
+array(4) {
+  [0]=>
+  string(15) "single ' quoted"
+  [1]=>
+  string(12) "double 1 "1""
+  [2]=>
+  string(20) "heredoc 1
+  indented"
+  [3]=>
+  string(9) "nowdoc $n"
+}
+int(4000)
+bool(true)
@@ -0,0 +1,89 @@
+--TEST--
+Clones copy the declared properties into an uninitialized table
+--FILE--
+<?php
+class Base {
+	private $secret = "base";
+	protected $kind = "base";
+}
+
+class Money extends Base {
+	public $amount;
+	public $currency;
+	public $unset = 1;
+
+	public function __construct($amount, $currency) {
+		$this->amount = $amount;
+		$this->currency = $currency;
+	}
+
+	public function withAmount($amount) {
+		$new = clone $this;
+		$new->amount = $amount;
+		return $new;
+	}
+}
+
+$a = new Money(10, "EUR");
+unset($a->unset);
+foreach ($a as $k => $v) {} /* builds the properties table the clone copies */
+$b = $a->withAmount(20);
+var_dump($a->amount, $b->amount);
+var_dump(array_keys((array)$a) === array_keys((array)$b));
+var_dump(array_keys(get_object_vars($b)));
+var_dump(isset($b->unset));
+
+$b->extra = "dyn";
+$c = clone $b;
+$c->extra = "changed";
+var_dump($b->extra, $c->extra);
+
+$d = clone $a;
+$ref = &$d->currency;
+$ref = "USD";
+var_dump($a->currency, $d->currency);
+var_dump(count((array)$d));
+
+/* __clone() sees the copied slots */
+class Node {
+	public $children = [1, 2];
+	public $parent;
+
+	public function __clone() {
+		var_dump($this->children, $this->parent);
+		$this->children[] = 3;
+	}
+}
+
+$n = new Node;
+$n->parent = new stdClass;
+$m = clone $n;
+var_dump(count($n->children), count($m->children), $n->parent === $m->parent);
+?>
+--EXPECT--
+int(10)
+int(20)
+bool(true)
+array(2) {
+  [0]=>
+  string(6) "amount"
+  [1]=>
+  string(8) "currency"
+}
+bool(false)
+string(3) "dyn"
+string(7) "changed"
+string(3) "EUR"
+string(3) "USD"
+int(4)
+array(2) {
+  [0]=>
+  int(1)
+  [1]=>
+  int(2)
+}
+object(stdClass)#6 (0) {
+}
+int(2)
+int(3)
+bool(true)
@@ -0,0 +1,59 @@
+--TEST--
+zend_compile_files() compiles files again on the calling thread when a worker fails
+--SKIPIF--
+<?php
+if (!function_exists('zend_compile_files')) die('skip debug build only');
+if (!ZEND_THREAD_SAFE) die('skip thread safe build only');
+if (substr(PHP_OS, 0, 3) == 'WIN') die('skip pthreads only');
+?>
+--FILE--
+<?php
+function write_files($name, $sources) {
+	$files = [];
+	foreach ($sources as $i => $code) {
+		$files[] = $file = __DIR__ . "/compile_files_fallback_{$name}_$i.inc";
+		file_put_contents($file, $code);
+	}
+	return $files;
+}
+
+/* the warning aborts the worker, it is reported once by the calling thread */
+$files = write_files("diag", [
+	'<?php function fb_one() { return "one"; }',
+	'<?php declare(fb_unknown=1); class FbTwo {}',
+	'<?php function fb_three() { return "three"; }',
+]);
+var_dump(zend_compile_files($files, 3));
+var_dump(fb_one(), fb_three(), class_exists('FbTwo', false));
+
+/* a parse error stops at the file that has it */
+$files = write_files("parse", [
+	'<?php function fb_four() { return "four"; }',
+	'<?php function fb_five( { }',
+	'<?php function fb_six() { return "six"; }',
+]);
+try {
+	zend_compile_files($files, 3);
+} catch (ParseError $e) {
+	var_dump(get_class($e), $e->getFile() === $files[1]);
+}
+var_dump(function_exists('fb_four'), function_exists('fb_six'));
+?>
+--CLEAN--
+<?php
+foreach (["diag", "parse"] as $name) {
+	for ($i = 0; $i < 3; $i++) {
+		@unlink(__DIR__ . "/compile_files_fallback_{$name}_$i.inc");
+	}
+}
+?>
+--EXPECTF--
+Warning: Unsupported declare 'fb_unknown' in %scompile_files_fallback_diag_1.inc on line %d
+int(2)
+string(3) "one"
+string(5) "three"
+bool(true)
+string(10) "ParseError"
+bool(true)
+bool(true)
+bool(false)
@@ -0,0 +1,56 @@
+--TEST--
+zend_compile_files() compiles independent files on worker threads
+--SKIPIF--
+<?php
+if (!function_exists('zend_compile_files')) die('skip debug build only');
+if (!ZEND_THREAD_SAFE) die('skip thread safe build only');
+if (substr(PHP_OS, 0, 3) == 'WIN') die('skip pthreads only');
+?>
+--FILE--
+<?php
+$files = [];
+foreach ([
+	'<?php
+	function cf_one() { return "one"; }
+	class CfBase {
+		const KIND = "base";
+		public function name() { return static::class . " " . static::KIND; }
+	}',
+	'<?php
+	/* the parent is only known once the first file is linked */
+	class CfChild extends CfBase {
+		const KIND = "child";
+	}
+	function cf_two() { return strlen("two") . " " . CfChild::KIND; }',
+	'<?php
+	interface CfShape {}
+	function cf_three($x) { return $x instanceof CfShape ? "shape" : "other"; }',
+] as $i => $code) {
+	$files[] = $file = __DIR__ . "/compile_files_parallel_$i.inc";
+	file_put_contents($file, $code);
+}
+
+var_dump(zend_compile_files($files, 3));
+var_dump(cf_one(), cf_two(), cf_three(new CfChild));
+var_dump((new CfChild)->name(), get_parent_class('CfChild'));
+
+/* one thread compiles everything on the calling thread */
+$file = __DIR__ . "/compile_files_parallel_3.inc";
+file_put_contents($file, '<?php function cf_four() { return "four"; }');
+var_dump(zend_compile_files([$file], 1), cf_four());
+?>
+--CLEAN--
+<?php
+for ($i = 0; $i < 4; $i++) {
+	@unlink(__DIR__ . "/compile_files_parallel_$i.inc");
+}
+?>
+--EXPECT--
+int(3)
+string(3) "one"
+string(7) "3 child"
+string(5) "other"
+string(13) "CfChild child"
+string(6) "CfBase"
+int(0)
+string(4) "four"
@@ -0,0 +1,55 @@
+--TEST--
+Strings built by repeated concatenation keep their contents when they grow
+--FILE--
+<?php
+
+$parts = [];
+$s = '';
+for ($i = 0; $i < 20000; $i++) {
+    $s .= "$i,";
+    $parts[] = $i;
+}
+var_dump(strlen($s));
+var_dump($s === implode(',', $parts) . ',');
+
+/* appending a string to itself */
+$t = 'ab';
+for ($i = 0; $i < 16; $i++) {
+    $t .= $t;
+}
+var_dump(strlen($t), substr_count($t, 'ab'));
+
+/* appending to array elements and properties */
+$a = ['x' => ''];
+$o = new stdClass;
+$o->p = '';
+for ($i = 0; $i < 50000; $i++) {
+    $a['x'] .= 'abc';
+    $o->p .= 'de';
+}
+var_dump(strlen($a['x']), strlen($o->p));
+
+/* a copy taken while growing isn't affected by further appends */
+$u = str_repeat('-', 5000);
+$copy = $u;
+$u .= 'tail';
+var_dump(strlen($copy), strlen($u), substr($u, -5));
+
+/* temporaries of a concatenation chain */
+$v = '';
+for ($i = 0; $i < 1000; $i++) {
+    $v = $v . str_repeat('y', 10) . 'z' . $i;
+}
+var_dump(strlen($v));
+?>
+--EXPECT--
+int(108890)
+bool(true)
+int(131072)
+int(65536)
+int(150000)
+int(100000)
+int(5000)
+int(5004)
+string(5) "-tail"
+int(13890)
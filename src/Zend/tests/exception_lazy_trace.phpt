@@ -0,0 +1,83 @@
+--TEST--
+Exception traces built after the frames they were captured from are gone
+--FILE--
+<?php
+class A {
+	function f($n, $s) {
+		if ($n == 0) {
+			throw new Exception("deep");
+		}
+		$s .= "!";
+		return $this->f($n - 1, $s);
+	}
+	static function s($x) {
+		return (new A)->f(1, $x);
+	}
+}
+function g($a) {
+	$a = "changed";
+	return A::s($a);
+}
+function make($arg) {
+	return new Exception;
+}
+
+try {
+	g("orig");
+} catch (Exception $e) {
+	echo $e->getTraceAsString(), "\n";
+	var_dump($e->getTrace()[0]);
+}
+
+$e1 = make(1); $e2 = make(1); $e3 = make(2);
+var_dump($e1 == $e2, $e1 == $e3);
+var_dump(count($e1->getTrace()), (new Exception)->getTrace());
+
+class Holder {
+	public $e;
+}
+function throwWith($h) {
+	throw new Exception;
+}
+for ($i = 0; $i < 3; $i++) {
+	$h = new Holder;
+	try {
+		throwWith($h);
+	} catch (Exception $e) {
+		$h->e = $e;
+	}
+}
+unset($h, $e);
+var_dump(gc_collect_cycles() > 0);
+?>
+--EXPECTF--
+#0 %sexception_lazy_trace.php(8): A->f(0, 'changed!')
+#1 %sexception_lazy_trace.php(11): A->f(1, 'changed!')
+#2 %sexception_lazy_trace.php(16): A::s('changed')
+#3 %sexception_lazy_trace.php(23): g('changed')
+#4 {main}
+array(6) {
+  ["file"]=>
+  string(%d) "%sexception_lazy_trace.php"
+  ["line"]=>
+  int(8)
+  ["function"]=>
+  string(1) "f"
+  ["class"]=>
+  string(1) "A"
+  ["type"]=>
+  string(2) "->"
+  ["args"]=>
+  array(2) {
+    [0]=>
+    int(0)
+    [1]=>
+    string(8) "changed!"
+  }
+}
+bool(true)
+bool(false)
+int(1)
+array(0) {
+}
+bool(true)
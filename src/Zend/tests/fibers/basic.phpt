@@ -0,0 +1,41 @@
+--TEST--
+Values passed through Fiber::start(), Fiber::suspend(), Fiber::resume() and Fiber::getReturn()
+--FILE--
+<?php
+
+$fiber = new Fiber(function ($a, $b) {
+	echo "start($a, $b)\n";
+	$x = Fiber::suspend('first');
+	echo "resumed with $x\n";
+	try {
+		Fiber::suspend('second');
+	} catch (Exception $e) {
+		echo "caught ", $e->getMessage(), "\n";
+	}
+	var_dump(Fiber::getCurrent() instanceof Fiber);
+	return 'done';
+});
+
+var_dump($fiber->isStarted());
+var_dump($fiber->start(1, 2));
+var_dump($fiber->isSuspended());
+var_dump($fiber->resume('foo'));
+var_dump($fiber->throw(new Exception('bar')));
+var_dump($fiber->isTerminated());
+var_dump($fiber->getReturn());
+var_dump(Fiber::getCurrent());
+
+?>
+--EXPECT--
+bool(false)
+start(1, 2)
+string(5) "first"
+bool(true)
+resumed with foo
+string(6) "second"
+caught bar
+bool(true)
+NULL
+bool(true)
+string(4) "done"
+NULL
@@ -0,0 +1,76 @@
+--TEST--
+Destroying a suspended fiber unwinds it, running finally blocks
+--FILE--
+<?php
+
+class Dtor {
+	public function __destruct() {
+		echo "Dtor::__destruct()\n";
+	}
+}
+
+$fiber = new Fiber(function () {
+	$dtor = new Dtor;
+	try {
+		Fiber::suspend();
+		echo "not reached\n";
+	} catch (Throwable $e) {
+		echo "not caught\n";
+	} finally {
+		echo "finally\n";
+	}
+	echo "not reached\n";
+});
+$fiber->start();
+unset($fiber);
+echo "unset\n";
+
+$fiber = new Fiber(function () {
+	try {
+		Fiber::suspend();
+	} finally {
+		throw new Exception('thrown in finally');
+	}
+});
+$fiber->start();
+try {
+	$fiber = null;
+} catch (Exception $e) {
+	echo $e->getMessage(), "\n";
+}
+
+$fiber = new Fiber(function () {
+	try {
+		Fiber::suspend();
+	} finally {
+		Fiber::suspend();
+	}
+});
+$fiber->start();
+try {
+	$fiber = null;
+} catch (FiberError $e) {
+	echo $e->getMessage(), "\n";
+}
+
+$fiber = new Fiber(function () {
+	$self = Fiber::getCurrent();
+	try {
+		Fiber::suspend();
+	} finally {
+		echo "collected\n";
+	}
+});
+$fiber->start();
+$fiber = null;
+var_dump(gc_collect_cycles() > 0);
+
+?>
+--EXPECT--
+finally
+Dtor::__destruct()
+unset
+thrown in finally
+Cannot suspend in a force-closed fiber
+collected
+bool(true)
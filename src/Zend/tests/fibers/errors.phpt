@@ -0,0 +1,75 @@
+--TEST--
+Invalid fiber state transitions throw FiberError
+--FILE--
+<?php
+
+try {
+	Fiber::suspend();
+} catch (FiberError $e) {
+	echo $e->getMessage(), "\n";
+}
+
+$fiber = new Fiber(function () use (&$fiber) {
+	try {
+		$fiber->resume();
+	} catch (FiberError $e) {
+		echo $e->getMessage(), "\n";
+	}
+	Fiber::suspend();
+});
+
+try {
+	$fiber->resume();
+} catch (FiberError $e) {
+	echo $e->getMessage(), "\n";
+}
+try {
+	$fiber->getReturn();
+} catch (FiberError $e) {
+	echo $e->getMessage(), "\n";
+}
+
+$fiber->start();
+
+try {
+	$fiber->start();
+} catch (FiberError $e) {
+	echo $e->getMessage(), "\n";
+}
+try {
+	$fiber->getReturn();
+} catch (FiberError $e) {
+	echo $e->getMessage(), "\n";
+}
+
+$fiber = new Fiber(function () {
+	throw new Exception('uncaught');
+});
+try {
+	$fiber->start();
+} catch (Exception $e) {
+	echo $e->getMessage(), "\n";
+}
+try {
+	$fiber->getReturn();
+} catch (FiberError $e) {
+	echo $e->getMessage(), "\n";
+}
+
+try {
+	clone $fiber;
+} catch (Error $e) {
+	echo $e->getMessage(), "\n";
+}
+
+?>
+--EXPECT--
+Cannot suspend outside of fiber
+Cannot resume a fiber that is not suspended
+Cannot get fiber return value: The fiber has not been started
+Cannot resume a fiber that is not suspended
+Cannot start a fiber that has already been started
+Cannot get fiber return value: The fiber has not returned
+uncaught
+Cannot get fiber return value: The fiber threw an exception
+Trying to clone an uncloneable object of class Fiber
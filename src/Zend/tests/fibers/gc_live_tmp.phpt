@@ -0,0 +1,33 @@
+--TEST--
+A suspended fiber reports temporaries that are live across the suspension to the GC
+--FILE--
+<?php
+
+class Holder {
+	public $fiber;
+	public function __destruct() {
+		echo "Holder::__destruct()\n";
+	}
+}
+
+function holder() {
+	$holder = new Holder;
+	$holder->fiber = Fiber::getCurrent();
+	return $holder;
+}
+
+$fiber = new Fiber(function () {
+	/* The array under construction only lives in a TMP slot */
+	$array = [holder(), Fiber::suspend()];
+	echo "not reached\n";
+});
+$fiber->start();
+$fiber = null;
+var_dump(gc_collect_cycles() > 0);
+echo "done\n";
+
+?>
+--EXPECT--
+Holder::__destruct()
+bool(true)
+done
@@ -0,0 +1,48 @@
+--TEST--
+A fiber can be suspended from a callback invoked by an internal function
+--FILE--
+<?php
+
+$fiber = new Fiber(function (array $values) {
+	usort($values, function ($a, $b) {
+		Fiber::suspend("$a<=>$b");
+		return $a <=> $b;
+	});
+	return $values;
+});
+
+$compared = [$fiber->start([3, 1, 2])];
+while ($fiber->isSuspended()) {
+	$compared[] = $fiber->resume();
+}
+
+var_dump(count($compared) > 1);
+var_dump(implode(',', $fiber->getReturn()));
+
+function thrower() {
+	Fiber::suspend();
+	throw new Exception('from fiber');
+}
+
+$fiber = new Fiber(function () { thrower(); });
+$fiber->start();
+
+function resumer($fiber) {
+	$fiber->resume();
+}
+
+try {
+	resumer($fiber);
+} catch (Exception $e) {
+	echo $e->getTraceAsString(), "\n";
+}
+
+?>
+--EXPECTF--
+bool(true)
+string(5) "1,2,3"
+#0 %s(%d): thrower()
+#1 [internal function]: {closure}()
+#2 %s(%d): Fiber->resume()
+#3 %s(%d): resumer(Object(Fiber))
+#4 {main}
@@ -0,0 +1,100 @@
+--TEST--
+Publishing and reading frozen arrays
+--FILE--
+<?php
+$config = [
+	"db" => ["host" => "localhost", "port" => 3306, "options" => []],
+	"features" => ["a", "b", str_repeat("c", 3)],
+	"ratio" => 0.5,
+	"debug" => false,
+	"nothing" => null,
+];
+$config["features"][] = "d";
+unset($config["features"][1]);
+
+var_dump(frozen_array_get("config"));
+var_dump(frozen_array_publish("config", $config));
+$frozen = frozen_array_get("config");
+var_dump($frozen === $config);
+var_dump(array_keys($frozen["features"]));
+
+/* writes separate a request copy */
+$frozen["db"]["port"] = 5432;
+$frozen["features"][] = "e";
+var_dump($frozen["db"]["port"], count($frozen["features"]));
+$again = frozen_array_get("config");
+var_dump($again["db"]["port"], count($again["features"]));
+var_dump($again === $config);
+
+/* the source is not tied to the frozen copy */
+$config["ratio"] = 1.5;
+var_dump(frozen_array_get("config")["ratio"]);
+
+/* replacing keeps arrays fetched earlier valid */
+var_dump(frozen_array_publish("config", [1, 2, 3]));
+var_dump(frozen_array_get("config"), $again["db"]["host"]);
+
+$ref = [1];
+$with_ref = ["r" => &$ref];
+var_dump(frozen_array_publish("ref", $with_ref));
+var_dump(frozen_array_get("ref"));
+
+var_dump(frozen_array_publish("bad", [new stdClass]));
+var_dump(frozen_array_get("bad"));
+$rec = [1];
+$rec[] = &$rec;
+var_dump(frozen_array_publish("bad", $rec));
+
+var_dump(frozen_array_publish("config", null));
+var_dump(frozen_array_get("config"));
+var_dump(frozen_array_publish("empty", []));
+var_dump(frozen_array_get("empty"));
+?>
+--EXPECTF--
+NULL
+bool(true)
+bool(true)
+array(3) {
+  [0]=>
+  int(0)
+  [1]=>
+  int(2)
+  [2]=>
+  int(3)
+}
+int(5432)
+int(4)
+int(3306)
+int(3)
+bool(true)
+float(0.5)
+bool(true)
+array(3) {
+  [0]=>
+  int(1)
+  [1]=>
+  int(2)
+  [2]=>
+  int(3)
+}
+string(9) "localhost"
+bool(true)
+array(1) {
+  ["r"]=>
+  array(1) {
+    [0]=>
+    int(1)
+  }
+}
+
+Warning: frozen_array_publish(): Only arrays of scalars, strings and arrays can be frozen in %s on line %d
+bool(false)
+NULL
+
+Warning: frozen_array_publish(): Only arrays of scalars, strings and arrays can be frozen in %s on line %d
+bool(false)
+bool(true)
+NULL
+bool(true)
+array(0) {
+}
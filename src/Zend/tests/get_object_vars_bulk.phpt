@@ -0,0 +1,84 @@
+--TEST--
+get_object_vars() on objects with declared properties
+--FILE--
+<?php
+class Row {
+	public $id = 1;
+	protected $name = "row";
+	private $secret = "s";
+	public $gone = "x";
+
+	function vars() {
+		return get_object_vars($this);
+	}
+}
+
+$r = new Row;
+unset($r->gone);
+$r->{"42"} = "numeric";
+$r->extra = [1, 2];
+
+$outside = get_object_vars($r);
+var_dump($outside);
+var_dump($outside[42], isset($outside["gone"]));
+
+$ref = "referenced";
+$r->ref = &$ref;
+$with_ref = get_object_vars($r);
+$ref = "changed";
+var_dump($with_ref["ref"]);
+
+$inside = $r->vars();
+var_dump(array_keys($inside));
+var_dump($inside["secret"], $inside["name"]);
+
+/* the result is a normal array */
+$inside[] = "next";
+$inside["id"] = 2;
+var_dump(array_keys($inside)[6], $inside[43], $r->id);
+
+for ($i = 0; $i < 3; $i++) {
+	$r->id = $i;
+	$row = get_object_vars($r);
+	echo $row["id"], " ", count($row), "\n";
+}
+?>
+--EXPECT--
+array(3) {
+  ["id"]=>
+  int(1)
+  [42]=>
+  string(7) "numeric"
+  ["extra"]=>
+  array(2) {
+    [0]=>
+    int(1)
+    [1]=>
+    int(2)
+  }
+}
+string(7) "numeric"
+bool(false)
+string(7) "changed"
+array(6) {
+  [0]=>
+  string(2) "id"
+  [1]=>
+  string(4) "name"
+  [2]=>
+  string(6) "secret"
+  [3]=>
+  int(42)
+  [4]=>
+  string(5) "extra"
+  [5]=>
+  string(3) "ref"
+}
+string(1) "s"
+string(3) "row"
+int(43)
+string(4) "next"
+int(1)
+0 4
+1 4
+2 4
@@ -0,0 +1,77 @@
+--TEST--
+instanceof, type checks and catch against deep hierarchies and many interfaces
+--FILE--
+<?php
+/* deeper than the ancestors a class keeps, each level with interfaces of
+ * its own, some extending others */
+for ($i = 0; $i < 40; $i++) {
+	$parent = $i ? "interface I$i extends I" . ($i - 1) . " {}" : "interface I0 {}";
+	eval($parent);
+	eval("interface J$i {}");
+}
+for ($i = 0; $i < 20; $i++) {
+	$extends = $i ? "extends C" . ($i - 1) : "";
+	$implements = $i % 3 ? "implements J$i, J" . ($i + 20) : "";
+	eval("class C$i $extends $implements {}");
+}
+eval("class Leaf extends C19 implements I39 {}");
+
+$errors = 0;
+$leaf = new Leaf;
+for ($i = 0; $i < 20; $i++) {
+	$class = "C$i";
+	$obj = new $class;
+	for ($j = 0; $j < 20; $j++) {
+		$c = "C$j";
+		$iface = "J$j";
+		if (($obj instanceof $c) !== ($j <= $i)) {
+			echo "C$i instanceof C$j\n";
+			$errors++;
+		}
+		$expected = false;
+		for ($k = 0; $k <= $i; $k++) {
+			if ($k % 3 && ($j == $k || $j == $k + 20)) {
+				$expected = true;
+			}
+		}
+		if (($obj instanceof $iface) !== $expected || is_subclass_of($obj, $iface) !== $expected) {
+			echo "C$i instanceof J$j\n";
+			$errors++;
+		}
+	}
+	$iface = "I" . ($i * 2);
+	if (!($leaf instanceof $class) || !($leaf instanceof $iface)) {
+		echo "Leaf instanceof C$i\n";
+		$errors++;
+	}
+}
+var_dump($errors);
+
+function take_c3(C3 $c) { return get_class($c); }
+function take_i0(I0 $i) { return get_class($i); }
+
+echo take_c3(new C19), " ", take_c3($leaf), " ", take_i0($leaf), "\n";
+try {
+	take_c3(new C2);
+} catch (TypeError $e) {
+	echo "C2 is not a C3\n";
+}
+var_dump(new C2 instanceof I0, $leaf instanceof Leaf, is_a("Leaf", "C0", true), is_a("C0", "Leaf", true));
+
+class E0 extends Exception implements I5 {}
+class E1 extends E0 {}
+try {
+	throw new E1;
+} catch (I3 $e) {
+	echo "caught ", get_class($e), " as I3\n";
+}
+?>
+--EXPECT--
+int(0)
+C19 Leaf Leaf
+C2 is not a C3
+bool(false)
+bool(true)
+bool(true)
+bool(false)
+caught E1 as I3
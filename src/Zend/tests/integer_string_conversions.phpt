@@ -0,0 +1,104 @@
+--TEST--
+Integers are converted to and from strings of every length
+--SKIPIF--
+<?php if (PHP_INT_SIZE != 8) die("skip 64-bit only"); ?>
+--FILE--
+<?php
+function rnd($max) {
+	static $seed = 7;
+	$seed = ($seed * 1103515245 + 12345) % 2147483648;
+	return $seed % ($max + 1);
+}
+
+function digits($n) {
+	$str = "";
+	for ($i = 0; $i < $n; $i++) {
+		$str .= "0123456789"[rnd(9)];
+	}
+	return $str;
+}
+
+function to_str($n) {
+	$neg = $n < 0;
+	$str = "";
+	do {
+		$d = $n % 10;
+		$str = "0123456789"[$neg ? -$d : $d] . $str;
+		$n = ($n - $d) / 10;
+	} while ($n != 0);
+	return $neg ? "-" . $str : $str;
+}
+
+$errors = 0;
+for ($i = 0; $i < 20000; $i++) {
+	$len = rnd(21);
+	$str = digits($len);
+	$sign = ["", "-", "+", " ", "0"][rnd(4)];
+	$tail = ["", "", "", "x", ".5", "e1", " "][rnd(6)];
+	$s = $sign . $str . $tail;
+
+	/* integer keys are the canonical decimal form of an integer */
+	foreach ([$s => true] as $key => $_) {
+		$canonical = $s === to_str((int) $s);
+		if (($key !== $s) !== $canonical) {
+			echo "key '$s'\n";
+			$errors++;
+		}
+	}
+
+	/* arithmetic uses the same value as a plain (int) cast */
+	if ($len > 0 && $len <= 18 && $tail === "") {
+		if ($s + 0 !== (int) $s || $s != (int) $s) {
+			echo "numeric '$s'\n";
+			$errors++;
+		}
+	}
+	if ($len >= 20 && ($sign === "" || $sign === "-") && $tail === "" && $str[0] !== "0") {
+		if (!($s + 0 === (float) $s)) {
+			echo "overflow '$s'\n";
+			$errors++;
+		}
+	}
+
+	$n = rnd(2147483647) * rnd(2147483647) * (rnd(1) ? 1 : -1) + rnd(99);
+	if ((string) $n !== to_str($n)) {
+		echo "string $n\n";
+		$errors++;
+	}
+}
+var_dump($errors);
+
+var_dump((string) PHP_INT_MAX === to_str(PHP_INT_MAX), (string) PHP_INT_MIN === to_str(PHP_INT_MIN));
+var_dump("0", "9", "10", "99", "100", 1000 . "", -1 . "", -10 . "", -100 . "");
+$a = ["12345678" => 1, "123456789" => 2, "1234567812345678" => 3, "-1234567812345678" => 4, "12345678x" => 5, "x2345678" => 6, "012345678" => 7];
+var_dump($a);
+?>
+--EXPECT--
+int(0)
+bool(true)
+bool(true)
+string(1) "0"
+string(1) "9"
+string(2) "10"
+string(2) "99"
+string(3) "100"
+string(4) "1000"
+string(2) "-1"
+string(3) "-10"
+string(4) "-100"
+array(7) {
+  [12345678]=>
+  int(1)
+  [123456789]=>
+  int(2)
+  [1234567812345678]=>
+  int(3)
+  [-1234567812345678]=>
+  int(4)
+  ["12345678x"]=>
+  int(5)
+  ["x2345678"]=>
+  int(6)
+  ["012345678"]=>
+  int(7)
+}
@@ -0,0 +1,25 @@
+--TEST--
+Strings in the shared tier are found by the request interning of later compilations
+--FILE--
+<?php
+/* built at run time, so the request tier has never seen it */
+$prefix = "shared_tier";
+$key = $prefix . "_key";
+
+/* the keys of frozen arrays are interned in the shared tier */
+frozen_array_publish("shared_tier_test", [$key => 1]);
+$before = interned_strings_status();
+
+eval('$found = "shared_tier_key";');
+$after = interned_strings_status();
+
+var_dump($after['shared'] >= 1);
+var_dump($after['shared_hits'] > $before['shared_hits']);
+var_dump(frozen_array_get("shared_tier_test")[$found]);
+
+frozen_array_publish("shared_tier_test", null);
+?>
+--EXPECT--
+bool(true)
+bool(true)
+int(1)
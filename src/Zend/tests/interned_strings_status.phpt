@@ -0,0 +1,30 @@
+--TEST--
+interned_strings_status() reports the interned string lookups of the request
+--FILE--
+<?php
+$code = '$fresh_variable_name = "a fresh literal" . $code;';
+
+/* the name of eval()'d code includes the line, so both run from the same one */
+for ($i = 0; $i < 2; $i++) {
+	eval($code);
+	$status[] = interned_strings_status();
+}
+list($before, $after) = $status;
+
+foreach ($after as $key => $value) {
+	echo $key, ": ", $value >= $before[$key] ? "ok" : "decreased", "\n";
+}
+/* everything the second compilation needs was interned by the first one */
+var_dump($after['misses'] === $before['misses']);
+var_dump($after['request'] === $before['request']);
+var_dump($after['shared_hits'] <= $after['hits']);
+?>
+--EXPECT--
+shared: ok
+request: ok
+hits: ok
+shared_hits: ok
+misses: ok
+bool(true)
+bool(true)
+bool(true)
@@ -0,0 +1,56 @@
+--TEST--
+Numeric strings are converted to the closest double
+--FILE--
+<?php
+/* int to float conversions and single multiplications or divisions of exact
+ * values are correctly rounded by the FPU, the string conversion must agree */
+function rnd($max) {
+	static $seed = 42;
+	$seed = ($seed * 1103515245 + 12345) % 2147483648;
+	return $seed % ($max + 1);
+}
+
+$errors = 0;
+for ($i = 0; $i < 20000; $i++) {
+	$m = (rnd(2097151) * 4294967296 + rnd(2147483647) * 2 + rnd(1)) % 9007199254740992;
+	$k = rnd(22);
+	$p = (float) ("1e" . $k);
+	if ((float) ("{$m}e-{$k}") !== $m / $p) {
+		echo "{$m}e-{$k}\n";
+		$errors++;
+	}
+	if ((float) ("{$m}e{$k}") !== $m * $p) {
+		echo "{$m}e{$k}\n";
+		$errors++;
+	}
+	$big = 9007199254740992 + rnd(2147483647) * 1024 + rnd(1023);
+	if ((float) "$big" !== (float) $big) {
+		echo "$big\n";
+		$errors++;
+	}
+}
+var_dump($errors);
+
+/* half way between two doubles */
+var_dump((float) "9007199254740993" === 2.0 ** 53);
+var_dump((float) "9007199254740995" === 2.0 ** 53 + 4);
+var_dump((float) "9007199254740993.0000000000000001" === 2.0 ** 53 + 2);
+
+/* near the limits of the range */
+var_dump((float) "1.7976931348623157e308" === (2 - 2 ** -52) * 2 ** 1023);
+var_dump((float) "2.2250738585072014e-308" === 2 ** -1022);
+var_dump((float) "1.7976931348623159e308" === 2.0 ** 1024);
+var_dump((float) "4.9406564584124654e-324" === 2 ** -1074, (float) "2.4703282292062327e-324" === 0.0);
+var_dump((float) "0.1" + (float) "0.2" === 5404319552844596 / 2 ** 54);
+?>
+--EXPECT--
+int(0)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
@@ -0,0 +1,83 @@
+--TEST--
+Appends to and iteration over packed arrays
+--FILE--
+<?php
+$a = [];
+for ($i = 0; $i < 20; $i++) {
+	$a[] = $i * 2;
+}
+unset($a[19]);
+$a[] = "after unset";        /* goes to 20, not 19 */
+unset($a[5]);
+$a[] = "after hole";
+var_dump(array_keys($a) === array_merge(range(0, 4), range(6, 18), [20, 21]));
+
+$b = [1, 2, 3];
+array_pop($b);
+$b[] = "popped";
+var_dump($b);
+
+$c = [10 => "x"];
+$c[] = "y";
+var_dump($c);
+
+$keys = $sum = 0;
+foreach ($a as $k => $v) {
+	$keys += $k;
+	if (is_int($v)) {
+		$sum += $v;
+	}
+}
+var_dump($keys, $sum);
+
+$d = ["a", "b"];
+foreach ($d as $k => $v) {
+	$d[] = $v . $k;          /* iterates over the original copy */
+}
+var_dump($d);
+
+$e = [$d[0], $d[1], [$i, $i + 1]];
+var_dump(count($e), $e[2][1]);
+
+$ref = [];
+$r = &$ref;
+$r[] = 1;
+$r[] = 2;
+var_dump($ref);
+?>
+--EXPECT--
+bool(true)
+array(3) {
+  [0]=>
+  int(1)
+  [1]=>
+  int(2)
+  [2]=>
+  string(6) "popped"
+}
+array(2) {
+  [10]=>
+  string(1) "x"
+  [11]=>
+  string(1) "y"
+}
+int(207)
+int(332)
+array(4) {
+  [0]=>
+  string(1) "a"
+  [1]=>
+  string(1) "b"
+  [2]=>
+  string(2) "a0"
+  [3]=>
+  string(2) "b1"
+}
+int(3)
+int(21)
+array(2) {
+  [0]=>
+  int(1)
+  [1]=>
+  int(2)
+}
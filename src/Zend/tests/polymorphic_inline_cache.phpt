@@ -0,0 +1,81 @@
+--TEST--
+Call sites, property and constant fetches that see many classes
+--FILE--
+<?php
+abstract class Base {
+	private $secret = "base";
+	public $dyn;
+	static $count = 0;
+
+	function name() { return static::class; }
+	function secret() { return $this->secret; }
+	static function make() { static::$count++; return new static; }
+}
+
+/* more classes than a site keeps before it becomes megamorphic, properties
+ * at different offsets, some of them shadowing a private one of the parent */
+for ($i = 0; $i < 40; $i++) {
+	$props = "";
+	for ($j = 0; $j < $i % 5; $j++) {
+		$props .= "public \$pad$j = 0;";
+	}
+	$secret = $i % 3 ? "" : "private \$secret = 'own$i';";
+	eval("class C$i extends Base {
+		$props
+		$secret
+		public \$v = $i;
+		static \$count = 0;
+		const K = 'k$i';
+		function id() { return $i; }
+	}");
+}
+
+function visit($obj) {
+	return $obj->id() . $obj->name() . $obj->v . $obj::K . $obj->secret() . $obj->dyn . isset($obj->nope);
+}
+
+function touch($obj, $i) {
+	$obj->v = $obj->v + 1;
+	$obj->dyn = "d$i";
+	$obj->{"extra"} = $i;
+	$obj::$count++;
+}
+
+$objs = [];
+for ($i = 0; $i < 40; $i++) {
+	$class = "C$i";
+	$objs[] = $class::make();
+}
+
+$errors = 0;
+$seed = 1;
+for ($n = 0; $n < 20000; $n++) {
+	$seed = ($seed * 1103515245 + 12345) % 2147483648;
+	/* mostly a few classes, sometimes any of them */
+	$i = $seed % 8 ? $seed % 3 : $seed % 40;
+	$obj = $objs[$i];
+	$expected = $i . "C$i" . ($i + $obj->v - $i) . "k$i" . "base" . $obj->dyn;
+	if (visit($obj) !== $expected) {
+		echo "visit $i: ", visit($obj), " !== $expected\n";
+		$errors++;
+	}
+	$v = $obj->v;
+	touch($obj, $i);
+	if ($obj->v !== $v + 1 || $obj->dyn !== "d$i" || $obj->extra !== $i) {
+		echo "touch $i\n";
+		$errors++;
+	}
+}
+var_dump($errors);
+
+$total = 0;
+for ($i = 0; $i < 40; $i++) {
+	$class = "C$i";
+	$total += $class::$count;
+}
+var_dump($total, Base::$count);
+?>
+--EXPECT--
+int(0)
+int(20040)
+int(0)
@@ -0,0 +1,82 @@
+--TEST--
+Recursion guards of magic accessors nested over many properties
+--FILE--
+<?php
+class Chain {
+	public $log = [];
+	private $depth;
+
+	public function __construct($depth) {
+		$this->depth = $depth;
+	}
+
+	public function __get($name) {
+		$this->log[] = $name;
+		$n = (int)substr($name, 1);
+		if ($n < $this->depth) {
+			/* nests one more guard on a new name */
+			$inner = $this->{"p" . ($n + 1)};
+		} else {
+			$inner = 0;
+		}
+		/* recursion on the same name reads the undefined property */
+		$self = @$this->$name;
+		return $inner + $n + ($self === null ? 0 : 1000);
+	}
+
+	public function __set($name, $value) {
+		$this->log[] = "set $name";
+		if ($value > 0) {
+			$this->{"q" . ($value - 1)} = $value - 1;
+		}
+	}
+
+	public function __isset($name) {
+		return $name !== "missing";
+	}
+}
+
+foreach ([1, 3, 7, 12] as $depth) {
+	$c = new Chain($depth);
+	var_dump($c->p1);
+	var_dump(count($c->log));
+	/* the same guards are reused afterwards */
+	$c->log = [];
+	var_dump($c->p1, count($c->log));
+}
+
+$c = new Chain(2);
+$c->q10 = 10;
+var_dump(count($c->log), end($c->log));
+var_dump(isset($c->p1), isset($c->missing));
+
+$objs = [];
+for ($i = 0; $i < 100; $i++) {
+	$objs[] = $o = new Chain(9);
+	$o->p1;
+}
+var_dump(array_sum(array_map(function ($o) { return count($o->log); }, $objs)));
+unset($objs);
+?>
+--EXPECT--
+int(1)
+int(1)
+int(1)
+int(1)
+int(6)
+int(3)
+int(6)
+int(3)
+int(28)
+int(7)
+int(28)
+int(7)
+int(78)
+int(12)
+int(78)
+int(12)
+int(11)
+string(6) "set q0"
+bool(true)
+bool(false)
+int(900)
@@ -0,0 +1,52 @@
+--TEST--
+Realpath cache entries of other threads and invalidation by new entries
+--SKIPIF--
+<?php
+if (!function_exists('zend_realpath_cache')) die('skip debug build only');
+if (PHP_OS != 'Linux') die('skip inotify only');
+?>
+--FILE--
+<?php
+$dir = __DIR__ . "/realpath_cache_shared";
+@mkdir($dir);
+file_put_contents("$dir/a", "");
+
+$real = zend_realpath_cache("$dir/a", 16384);
+var_dump($real !== false);
+
+/* a thread whose own table is full still gets the entry another thread
+ * resolved, instead of resolving the path again */
+if (function_exists('zend_thread_id')) {
+	var_dump(zend_realpath_cache("$dir/a", 1, true) === $real);
+} else {
+	var_dump(true);
+}
+
+/* creating an entry in a watched directory drops the cached paths */
+var_dump(zend_realpath_cache("$dir/a", 16384) === $real);
+var_dump(zend_realpath_cache("$dir/a") === $real);
+file_put_contents("$dir/b", "");
+sleep(1);
+var_dump(zend_realpath_cache("$dir/a"));
+
+/* and the directory is watched again once a path is cached again */
+var_dump(zend_realpath_cache("$dir/a", 16384) === $real);
+unlink("$dir/b");
+sleep(1);
+var_dump(zend_realpath_cache("$dir/a"));
+?>
+--CLEAN--
+<?php
+$dir = __DIR__ . "/realpath_cache_shared";
+@unlink("$dir/a");
+@unlink("$dir/b");
+@rmdir($dir);
+?>
+--EXPECT--
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(false)
+bool(true)
+bool(false)
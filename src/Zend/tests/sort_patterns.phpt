@@ -0,0 +1,68 @@
+--TEST--
+zend_sort() on ordered, reversed, equal and mixed type inputs
+--FILE--
+<?php
+function check($name, $a, $orig) {
+	$ok = count($a) == count($orig);
+	for ($i = 1; $ok && $i < count($a); $i++) {
+		if ($a[$i - 1] > $a[$i]) {
+			$ok = false;
+		}
+	}
+	echo $name, ": ", $ok ? "ok" : "failed", "\n";
+}
+
+$n = 1000;
+$inputs = [];
+$inputs["ascending"] = [];
+$inputs["descending"] = [];
+$inputs["organ pipe"] = [];
+$inputs["few unique"] = [];
+$inputs["shuffled"] = [];
+$inputs["doubles"] = [];
+$inputs["strings"] = [];
+$inputs["mixed"] = [];
+for ($i = 0; $i < $n; $i++) {
+	$inputs["ascending"][] = $i;
+	$inputs["descending"][] = $n - $i;
+	$inputs["organ pipe"][] = $i < $n / 2 ? $i : $n - $i;
+	$inputs["few unique"][] = $i % 3;
+	$inputs["shuffled"][] = ($i * 7919) % $n;
+	$inputs["doubles"][] = (($i * 7919) % $n) / 7;
+	$inputs["strings"][] = "s" . (($i * 7919) % $n);
+	$inputs["mixed"][] = $i % 2 ? ($i * 7919) % $n : (($i * 7919) % $n) / 3;
+}
+
+foreach ($inputs as $name => $input) {
+	$a = $input;
+	sort($a);
+	check($name, $a, $input);
+}
+
+$a = $inputs["shuffled"];
+usort($a, function ($x, $y) { return $x > $y; });
+check("boolean comparator", $a, $inputs["shuffled"]);
+
+$a = $inputs["few unique"];
+asort($a);
+$prev = -1;
+$ok = true;
+foreach ($a as $key => $value) {
+	if ($value < $prev || $inputs["few unique"][$key] !== $value) {
+		$ok = false;
+	}
+	$prev = $value;
+}
+echo "asort: ", $ok ? "ok" : "failed", "\n";
+?>
+--EXPECT--
+ascending: ok
+descending: ok
+organ pipe: ok
+few unique: ok
+shuffled: ok
+doubles: ok
+strings: ok
+mixed: ok
+boolean comparator: ok
+asort: ok
@@ -0,0 +1,70 @@
+--TEST--
+Case insensitive comparisons and lookups of strings of various lengths
+--FILE--
+<?php
+$lower = "abcdefghijklmnopqrstuvwxyz0123456789_@[`{\x80\xc0\xe0\xff";
+$upper = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_@[`{\x80\xc0\xe0\xff";
+
+function make($chars, $len, $seed) {
+	$str = "";
+	for ($i = 0; $i < $len; $i++) {
+		$str .= $chars[($i * 7 + $seed) % strlen($chars)];
+	}
+	return $str;
+}
+
+$errors = 0;
+for ($len = 0; $len <= 100; $len++) {
+	$a = make($lower, $len, $len);
+	$b = make($upper, $len, $len);
+	if (strcasecmp($a, $b) !== 0 || strncasecmp($a, $b, $len + 1) !== 0) {
+		echo "equal $len\n";
+		$errors++;
+	}
+	if (strcasecmp($a, $b . "x") >= 0 || strcasecmp($b . "x", $a) <= 0) {
+		echo "prefix $len\n";
+		$errors++;
+	}
+	for ($pos = 0; $pos < $len; $pos++) {
+		$c = $b;
+		$c[$pos] = "!";
+		if (strcasecmp($c, $a) >= 0 || strcasecmp($a, $c) <= 0) {
+			echo "diff $len $pos\n";
+			$errors++;
+		}
+		if (strncasecmp($c, $a, $pos) !== 0 || strncasecmp($c, $a, $pos + 1) >= 0) {
+			echo "ndiff $len $pos\n";
+			$errors++;
+		}
+	}
+}
+echo "compare: $errors\n";
+
+/* bytes outside of ASCII are never folded */
+var_dump(strcasecmp(make($lower, 40, 0) . "\xc0", make($upper, 40, 0) . "\xe0") < 0);
+var_dump(strcasecmp(make($lower, 40, 0) . "[", make($upper, 40, 0) . "{") < 0);
+
+$ident_lower = "abcdefghijklmnopqrstuvwxyz0123456789_\x80\xff";
+$ident_upper = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_\x80\xff";
+$errors = 0;
+for ($len = 1; $len <= 80; $len++) {
+	$name = "f" . make($ident_lower, $len, 3);
+	eval("function $name() { return $len; }");
+	$mixed = "F" . make($ident_upper, $len, 3);
+	if (!function_exists($mixed) || $mixed() !== $len) {
+		echo "lookup $len\n";
+		$errors++;
+	}
+	$mixed[$len] = "!";
+	if (function_exists($mixed)) {
+		echo "miss $len\n";
+		$errors++;
+	}
+}
+echo "lookup: $errors\n";
+?>
+--EXPECT--
+compare: 0
+bool(true)
+bool(true)
+lookup: 0
@@ -32,6 +32,7 @@
 #include "zend_smart_str.h"
 #include "zend_smart_string.h"
 #include "zend_cpuinfo.h"
+#include "zend_frozen_array.h"
 
 #ifdef ZTS
 ZEND_API int compiler_globals_id;
@@ -166,6 +167,8 @@ ZEND_INI_BEGIN()
  	STD_ZEND_INI_BOOLEAN("zend.multibyte", "0", ZEND_INI_PERDIR, OnUpdateBool, multibyte,      zend_compiler_globals, compiler_globals)
  	ZEND_INI_ENTRY("zend.script_encoding",			NULL,		ZEND_INI_ALL,		OnUpdateScriptEncoding)
  	STD_ZEND_INI_BOOLEAN("zend.detect_unicode",			"1",	ZEND_INI_ALL,		OnUpdateBool, detect_unicode, zend_compiler_globals, compiler_globals)
+	STD_ZEND_INI_BOOLEAN("zend.publish_interned_strings",	"0",	ZEND_INI_SYSTEM,	OnUpdateBool, publish_interned_strings, zend_compiler_globals, compiler_globals)
+	STD_ZEND_INI_ENTRY("zend.compile_threads",			"0",	ZEND_INI_SYSTEM,	OnUpdateLong, compile_threads, zend_compiler_globals, compiler_globals)
 #ifdef ZEND_SIGNALS
 	STD_ZEND_INI_BOOLEAN("zend.signal_check", "0", ZEND_INI_SYSTEM, OnUpdateBool, check, zend_signal_globals_t, zend_signal_globals)
 #endif
@@ -691,6 +694,7 @@ static void executor_globals_ctor(zend_executor_globals *executor_globals) /* {{
 	executor_globals->exception_class = NULL;
 	executor_globals->exception = NULL;
 	executor_globals->objects_store.object_buckets = NULL;
+	executor_globals->frozen_array_reader = NULL;
 #ifdef ZEND_WIN32
 	zend_get_windows_version_info(&executor_globals->windows_version_info);
 #endif
@@ -701,6 +705,7 @@ static void executor_globals_ctor(zend_executor_globals *executor_globals) /* {{
 static void executor_globals_dtor(zend_executor_globals *executor_globals) /* {{{ */
 {
 	zend_ini_dtor(executor_globals->ini_directives);
+	zend_frozen_arrays_release_reader(executor_globals->frozen_array_reader);
 
 	if (&executor_globals->persistent_list != global_persistent_list) {
 		zend_destroy_rsrc_list(&executor_globals->persistent_list);
@@ -774,6 +779,7 @@ int zend_startup(zend_utility_functions *utility_functions, char **extensions) /
 #endif
 
 	zend_cpu_startup();
+	zend_startup_string_functions();
 
 #ifdef ZEND_WIN32
 	php_win32_cp_set_by_id(65001);
@@ -887,6 +893,7 @@ int zend_startup(zend_utility_functions *utility_functions, char **extensions) /
 	EG(error_reporting) = E_ALL & ~E_NOTICE;
 
 	zend_interned_strings_init();
+	zend_frozen_arrays_startup();
 	zend_startup_builtin_functions();
 	zend_register_standard_constants();
 	zend_register_auto_global(zend_string_init_interned("GLOBALS", sizeof("GLOBALS") - 1, 1), 1, php_auto_globals_create_globals);
@@ -974,6 +981,7 @@ void zend_shutdown(void) /* {{{ */
 
 	zend_destroy_rsrc_list(&EG(persistent_list));
 	zend_destroy_modules();
+	zend_frozen_arrays_shutdown();
 
 	virtual_cwd_deactivate();
 	virtual_cwd_shutdown();
@@ -1186,6 +1194,10 @@ static ZEND_COLD void zend_error_va_list(int type, const char *format, va_list a
 	zend_stack delayed_oplines_stack;
 	zend_array *symbol_table;
 
+	if (UNEXPECTED(CG(compiler_options) & ZEND_COMPILE_ABORT_ON_ERROR)) {
+		zend_bailout();
+	}
+
 	/* Report about uncaught exception in case of fatal errors */
 	if (EG(exception)) {
 		zend_execute_data *ex;
@@ -1540,21 +1552,56 @@ ZEND_API void zend_try_exception_handler() /* {{{ */
 	}
 } /* }}} */
 
+/* With zend.compile_threads > 1 all files are compiled before the first one
+ * runs, see zend_compile_files(). Diagnostics of a later file are then
+ * reported before the earlier files run, and a compile error stops all of
+ * them. */
 ZEND_API int zend_execute_scripts(int type, zval *retval, int file_count, ...) /* {{{ */
 {
 	va_list files;
-	int i;
+	int i, num_files = 0, failed, ret = SUCCESS;
+	zend_file_handle **file_handles;
 	zend_file_handle *file_handle;
+	zend_op_array **op_arrays = NULL;
 	zend_op_array *op_array;
+	zend_object *exception = NULL;
 
+	file_handles = safe_emalloc(file_count, sizeof(zend_file_handle *), 0);
 	va_start(files, file_count);
 	for (i = 0; i < file_count; i++) {
 		file_handle = va_arg(files, zend_file_handle *);
-		if (!file_handle) {
-			continue;
+		if (file_handle) {
+			file_handles[num_files++] = file_handle;
 		}
+	}
+	va_end(files);
 
-		op_array = zend_compile_file(file_handle, type);
+	failed = num_files;
+	if (CG(compile_threads) > 1 && num_files > 1) {
+		op_arrays = safe_emalloc(num_files, sizeof(zend_op_array *), 0);
+		zend_compile_files(file_handles, num_files, type, (uint32_t) MIN(CG(compile_threads), num_files), op_arrays);
+		/* the file that threw is the first one of the trailing NULL
+		 * op_arrays; its exception is kept until the files before it ran */
+		if (EG(exception)) {
+			exception = EG(exception);
+			EG(exception) = NULL;
+			while (failed > 0 && !op_arrays[failed - 1]) {
+				failed--;
+			}
+		}
+	}
+
+	for (i = 0; i < num_files; i++) {
+		file_handle = file_handles[i];
+		if (op_arrays) {
+			op_array = op_arrays[i];
+			if (i == failed) {
+				EG(exception) = exception;
+				exception = NULL;
+			}
+		} else {
+			op_array = zend_compile_file(file_handle, type);
+		}
 		if (file_handle->opened_path) {
 			zend_hash_add_empty_element(&EG(included_files), file_handle->opened_path);
 		}
@@ -1569,13 +1616,28 @@ ZEND_API int zend_execute_scripts(int type, zval *retval, int file_count, ...) /
 			destroy_op_array(op_array);
 			efree_size(op_array, sizeof(zend_op_array));
 		} else if (type==ZEND_REQUIRE) {
-			va_end(files);
-			return FAILURE;
+			ret = FAILURE;
+			break;
 		}
 	}
-	va_end(files);
 
-	return SUCCESS;
+	if (op_arrays) {
+		if (UNEXPECTED(exception)) {
+			/* a file before the one that threw stopped the script */
+			OBJ_RELEASE(exception);
+		}
+		while (++i < num_files) {
+			if (op_arrays[i]) {
+				destroy_op_array(op_arrays[i]);
+				efree_size(op_arrays[i], sizeof(zend_op_array));
+			}
+			zend_destroy_file_handle(file_handles[i]);
+		}
+		efree(op_arrays);
+	}
+	efree(file_handles);
+
+	return ret;
 }
 /* }}} */
 
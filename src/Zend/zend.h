@@ -107,6 +107,13 @@ typedef struct _zend_trait_alias {
 	uint32_t modifiers;
 } zend_trait_alias;
 
+/* Ancestors a class keeps by depth; subtype checks against deeper classes
+ * walk the parent chain from there */
+#define ZEND_CLASS_DISPLAY_SIZE 8
+
+#define ZEND_INTERFACE_SET_HASH(iface) \
+	((((uint32_t)((zend_uintptr_t)(iface) >> 3)) * 0x9e3779b1U) >> 16)
+
 struct _zend_class_entry {
 	char type;
 	zend_string *name;
@@ -156,6 +163,14 @@ struct _zend_class_entry {
 	uint32_t num_traits;
 	zend_class_entry **interfaces;
 
+	/* all of the interfaces again, as an open addressing hash set */
+	zend_class_entry **interface_set;
+	uint32_t interface_set_mask;
+
+	/* display[depth] is the class itself, the entries above are NULL */
+	uint32_t depth;
+	zend_class_entry *display[ZEND_CLASS_DISPLAY_SIZE];
+
 	zend_class_entry **traits;
 	zend_trait_alias **trait_aliases;
 	zend_trait_precedence **trait_precedences;
@@ -376,6 +376,12 @@ ZEND_API char *zend_get_type_by_const(int type);
 
 #define array_init(arg)				ZVAL_ARR((arg), zend_new_array(0))
 #define array_init_size(arg, size)	ZVAL_ARR((arg), zend_new_array(size))
+/* Fills arrays of a known size through zend_hash_bulk_*(), which see */
+#define array_init_bulk(arg, size, packed) do { \
+		ZVAL_ARR((arg), zend_new_array(0)); \
+		zend_hash_bulk_start(Z_ARRVAL_P(arg), (size), (packed)); \
+	} while (0)
+#define array_bulk_end(arg)			zend_hash_bulk_end(Z_ARRVAL_P(arg))
 ZEND_API int object_init(zval *arg);
 ZEND_API int object_init_ex(zval *arg, zend_class_entry *ce);
 ZEND_API int object_and_properties_init(zval *arg, zend_class_entry *ce, HashTable *properties);
@@ -2335,6 +2335,86 @@ void zend_mm_shutdown(zend_mm_heap *heap, int full, int silent)
 	}
 }
 
+/* Moves all memory of "donor" into "heap". Blocks allocated from the donor
+ * stay valid and may be reallocated or freed through "heap" afterwards.
+ * The donor must not be used by any thread anymore, its own structure lives
+ * inside of its first chunk and is simply abandoned. */
+ZEND_API void zend_mm_adopt_heap(zend_mm_heap *heap, zend_mm_heap *donor)
+{
+	zend_mm_chunk *p, *end;
+	zend_mm_huge_list *list;
+	int i;
+
+#if ZEND_MM_CUSTOM
+	ZEND_ASSERT(!heap->use_custom_heap && !donor->use_custom_heap);
+#endif
+#if ZEND_MM_STORAGE
+	ZEND_ASSERT(heap->storage == donor->storage);
+#endif
+
+	/* cached chunks don't hold anything */
+	while (donor->cached_chunks) {
+		p = donor->cached_chunks;
+		donor->cached_chunks = p->next;
+		zend_mm_chunk_free(donor, p, ZEND_MM_CHUNK_SIZE);
+	}
+
+	/* append free lists, so the remaining elements of the donor's bins are reused */
+	for (i = 0; i < ZEND_MM_BINS; i++) {
+		zend_mm_free_slot *slot = donor->free_slot[i];
+
+		if (slot) {
+			while (slot->next_free_slot) {
+				slot = slot->next_free_slot;
+			}
+			slot->next_free_slot = heap->free_slot[i];
+			heap->free_slot[i] = donor->free_slot[i];
+		}
+	}
+
+	/* huge blocks */
+	list = donor->huge_list;
+	if (list) {
+		while (list->next) {
+			list = list->next;
+		}
+		list->next = heap->huge_list;
+		heap->huge_list = donor->huge_list;
+	}
+
+	/* chunks are appended in their original order */
+	p = donor->main_chunk;
+	end = p;
+	do {
+		zend_mm_chunk *next = p->next;
+
+		p->heap = heap;
+		p->next = heap->main_chunk;
+		p->prev = heap->main_chunk->prev;
+		p->prev->next = p;
+		p->next->prev = p;
+		p->num = p->prev->num + 1;
+		p = next;
+	} while (p != end);
+
+	heap->chunks_count += donor->chunks_count;
+	if (heap->chunks_count > heap->peak_chunks_count) {
+		heap->peak_chunks_count = heap->chunks_count;
+	}
+#if ZEND_MM_STAT || ZEND_MM_LIMIT
+	heap->real_size += donor->real_size;
+#endif
+#if ZEND_MM_STAT
+	if (heap->real_size > heap->real_peak) {
+		heap->real_peak = heap->real_size;
+	}
+	heap->size += donor->size;
+	if (heap->size > heap->peak) {
+		heap->peak = heap->size;
+	}
+#endif
+}
+
 /**************/
 /* PUBLIC API */
 /**************/
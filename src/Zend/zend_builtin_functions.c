@@ -27,6 +27,10 @@
 #include "zend_extensions.h"
 #include "zend_closures.h"
 #include "zend_generators.h"
+#include "zend_frozen_array.h"
+#include "zend_virtual_cwd.h"
+
+#include <time.h>
 
 static ZEND_FUNCTION(zend_version);
 static ZEND_FUNCTION(func_num_args);
@@ -79,17 +83,46 @@ static ZEND_FUNCTION(debug_print_backtrace);
 #if ZEND_DEBUG && defined(ZTS)
 static ZEND_FUNCTION(zend_thread_id);
 #endif
+#if ZEND_DEBUG
+static ZEND_FUNCTION(zend_compile_files);
+static ZEND_FUNCTION(zend_realpath_cache);
+#endif
 static ZEND_FUNCTION(gc_mem_caches);
 static ZEND_FUNCTION(gc_collect_cycles);
 static ZEND_FUNCTION(gc_enabled);
 static ZEND_FUNCTION(gc_enable);
 static ZEND_FUNCTION(gc_disable);
 static ZEND_FUNCTION(gc_status);
+static ZEND_FUNCTION(interned_strings_status);
+static ZEND_FUNCTION(frozen_array_publish);
+static ZEND_FUNCTION(frozen_array_get);
 
 /* {{{ arginfo */
 ZEND_BEGIN_ARG_INFO(arginfo_zend__void, 0)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_frozen_array_publish, 0, 0, 2)
+	ZEND_ARG_INFO(0, name)
+	ZEND_ARG_INFO(0, value)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_frozen_array_get, 0, 0, 1)
+	ZEND_ARG_INFO(0, name)
+ZEND_END_ARG_INFO()
+
+#if ZEND_DEBUG
+ZEND_BEGIN_ARG_INFO_EX(arginfo_zend_compile_files, 0, 0, 1)
+	ZEND_ARG_INFO(0, files)
+	ZEND_ARG_INFO(0, threads)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_zend_realpath_cache, 0, 0, 1)
+	ZEND_ARG_INFO(0, path)
+	ZEND_ARG_INFO(0, size_limit)
+	ZEND_ARG_INFO(0, forget_own_entries)
+ZEND_END_ARG_INFO()
+#endif
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_func_get_arg, 0, 0, 1)
 	ZEND_ARG_INFO(0, arg_num)
 ZEND_END_ARG_INFO()
@@ -287,6 +320,10 @@ static const zend_function_entry builtin_functions[] = { /* {{{ */
 	ZEND_FE(debug_print_backtrace, 		arginfo_debug_print_backtrace)
 #if ZEND_DEBUG && defined(ZTS)
 	ZEND_FE(zend_thread_id,		NULL)
+#endif
+#if ZEND_DEBUG
+	ZEND_FE(zend_compile_files,	arginfo_zend_compile_files)
+	ZEND_FE(zend_realpath_cache,	arginfo_zend_realpath_cache)
 #endif
 	ZEND_FE(gc_mem_caches,      arginfo_zend__void)
 	ZEND_FE(gc_collect_cycles, 	arginfo_zend__void)
@@ -294,6 +331,9 @@ static const zend_function_entry builtin_functions[] = { /* {{{ */
 	ZEND_FE(gc_enable, 		arginfo_zend__void)
 	ZEND_FE(gc_disable, 		arginfo_zend__void)
 	ZEND_FE(gc_status, 		arginfo_zend__void)
+	ZEND_FE(interned_strings_status,	arginfo_zend__void)
+	ZEND_FE(frozen_array_publish,	arginfo_frozen_array_publish)
+	ZEND_FE(frozen_array_get,	arginfo_frozen_array_get)
 	ZEND_FE_END
 };
 /* }}} */
@@ -435,6 +475,74 @@ ZEND_FUNCTION(gc_status)
 }
 /* }}} */
 
+/* {{{ proto array interned_strings_status(void)
+   Returns interned string statistics of the current request */
+ZEND_FUNCTION(interned_strings_status)
+{
+	zend_interned_strings_status status;
+
+	if (zend_parse_parameters_none() == FAILURE) {
+		return;
+	}
+
+	zend_interned_strings_get_status(&status);
+
+	array_init_size(return_value, 5);
+
+	add_assoc_long_ex(return_value, "shared", sizeof("shared")-1, (zend_long)status.shared);
+	add_assoc_long_ex(return_value, "request", sizeof("request")-1, (zend_long)status.request);
+	add_assoc_long_ex(return_value, "hits", sizeof("hits")-1, (zend_long)status.hits);
+	add_assoc_long_ex(return_value, "shared_hits", sizeof("shared_hits")-1, (zend_long)status.shared_hits);
+	add_assoc_long_ex(return_value, "misses", sizeof("misses")-1, (zend_long)status.misses);
+}
+/* }}} */
+
+/* {{{ proto bool frozen_array_publish(string name, ?array value)
+   Publishes an immutable copy of value under name, or removes name if value is null */
+ZEND_FUNCTION(frozen_array_publish)
+{
+	zend_string *name;
+	HashTable *ht = NULL;
+	zend_frozen_array *frozen = NULL;
+
+	ZEND_PARSE_PARAMETERS_START(2, 2)
+		Z_PARAM_STR(name)
+		Z_PARAM_ARRAY_HT_EX(ht, 1, 0)
+	ZEND_PARSE_PARAMETERS_END();
+
+	if (ht) {
+		frozen = zend_array_freeze(ht);
+		if (!frozen) {
+			zend_error(E_WARNING, "frozen_array_publish(): Only arrays of scalars, strings and arrays can be frozen");
+			RETURN_FALSE;
+		}
+	}
+
+	zend_frozen_array_publish(name, frozen);
+	RETURN_TRUE;
+}
+/* }}} */
+
+/* {{{ proto ?array frozen_array_get(string name)
+   Returns the array published under name without copying it */
+ZEND_FUNCTION(frozen_array_get)
+{
+	zend_string *name;
+	HashTable *ht;
+
+	ZEND_PARSE_PARAMETERS_START(1, 1)
+		Z_PARAM_STR(name)
+	ZEND_PARSE_PARAMETERS_END();
+
+	ht = zend_frozen_array_find(name);
+	if (!ht) {
+		RETURN_NULL();
+	}
+	Z_ARR_P(return_value) = ht;
+	Z_TYPE_INFO_P(return_value) = IS_ARRAY;
+}
+/* }}} */
+
 /* {{{ proto int func_num_args(void)
    Get the number of arguments that were passed to the function */
 ZEND_FUNCTION(func_num_args)
@@ -1197,7 +1305,11 @@ ZEND_FUNCTION(get_object_vars)
 		}
 		RETURN_ARR(zend_proptable_to_symtable(properties, 1));
 	} else {
-		array_init_size(return_value, zend_hash_num_elements(properties));
+		HashTable *ht;
+		zend_bool bulk = 1;
+
+		array_init_bulk(return_value, zend_hash_num_elements(properties), 0);
+		ht = Z_ARRVAL_P(return_value);
 
 		ZEND_HASH_FOREACH_KEY_VAL(properties, num_key, key, value) {
 			zend_bool unmangle = 0;
@@ -1220,8 +1332,27 @@ ZEND_FUNCTION(get_object_vars)
 			Z_TRY_ADDREF_P(value);
 
 			if (UNEXPECTED(!key)) {
-				/* This case is only possible due to loopholes, e.g. ArrayObject */
-				zend_hash_index_add(Z_ARRVAL_P(return_value), num_key, value);
+				/* This case is only possible due to loopholes, e.g. ArrayObject.
+				 * Integer keys may repeat numeric names, the rest of the
+				 * properties are added with checked inserts. */
+				if (bulk) {
+					array_bulk_end(return_value);
+					bulk = 0;
+				}
+				if (!zend_hash_index_add(ht, num_key, value)) {
+					zval_ptr_dtor(value);
+				}
+			} else if (UNEXPECTED(!bulk)) {
+				if (unmangle && ZSTR_VAL(key)[0] == 0) {
+					const char *prop_name, *class_name;
+					size_t prop_len;
+					zend_unmangle_property_name_ex(key, &class_name, &prop_name, &prop_len);
+					zend_hash_str_add_new(ht, prop_name, prop_len, value);
+				} else if (!ZEND_HANDLE_NUMERIC(key, num_key)) {
+					zend_hash_add_new(ht, key, value);
+				} else if (!zend_hash_index_add(ht, num_key, value)) {
+					zval_ptr_dtor(value);
+				}
 			} else if (unmangle && ZSTR_VAL(key)[0] == 0) {
 				const char *prop_name, *class_name;
 				size_t prop_len;
@@ -1231,11 +1362,18 @@ ZEND_FUNCTION(get_object_vars)
 				 * theoretically someone might write an extension with
 				 * private, numeric properties. Well, too bad.
 				 */
-				zend_hash_str_add_new(Z_ARRVAL_P(return_value), prop_name, prop_len, value);
+				key = zend_string_init(prop_name, prop_len, 0);
+				zend_hash_bulk_add(ht, key, value);
+				zend_string_release(key);
+			} else if (ZEND_HANDLE_NUMERIC(key, num_key)) {
+				zend_hash_bulk_index_add(ht, num_key, value);
 			} else {
-				zend_symtable_add_new(Z_ARRVAL_P(return_value), key, value);
+				zend_hash_bulk_add(ht, key, value);
 			}
 		} ZEND_HASH_FOREACH_END();
+		if (bulk) {
+			array_bulk_end(return_value);
+		}
 	}
 }
 /* }}} */
@@ -1987,6 +2125,113 @@ ZEND_FUNCTION(zend_thread_id)
 }
 #endif
 
+#if ZEND_DEBUG
+/* {{{ proto int zend_compile_files(array files [, int threads])
+   Compiles the files and declares their functions and classes without running
+   them, returns how many of them were compiled by a worker thread */
+ZEND_FUNCTION(zend_compile_files)
+{
+	HashTable *files;
+	zend_long threads = 2;
+	zend_file_handle *file_handles, **file_handle_ptrs;
+	zend_op_array **op_arrays;
+	zend_string **filenames;
+	zval *file;
+	uint32_t i, num_files = 0, num_compiled;
+
+	ZEND_PARSE_PARAMETERS_START(1, 2)
+		Z_PARAM_ARRAY_HT(files)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_LONG(threads)
+	ZEND_PARSE_PARAMETERS_END();
+
+	if (!zend_hash_num_elements(files)) {
+		RETURN_LONG(0);
+	}
+
+	file_handles = safe_emalloc(zend_hash_num_elements(files), sizeof(zend_file_handle), 0);
+	file_handle_ptrs = safe_emalloc(zend_hash_num_elements(files), sizeof(zend_file_handle *), 0);
+	op_arrays = safe_emalloc(zend_hash_num_elements(files), sizeof(zend_op_array *), 0);
+	filenames = safe_emalloc(zend_hash_num_elements(files), sizeof(zend_string *), 0);
+
+	ZEND_HASH_FOREACH_VAL(files, file) {
+		filenames[num_files] = zval_get_string(file);
+		memset(&file_handles[num_files], 0, sizeof(zend_file_handle));
+		file_handles[num_files].type = ZEND_HANDLE_FILENAME;
+		file_handles[num_files].filename = ZSTR_VAL(filenames[num_files]);
+		file_handle_ptrs[num_files] = &file_handles[num_files];
+		num_files++;
+	} ZEND_HASH_FOREACH_END();
+
+	num_compiled = zend_compile_files(file_handle_ptrs, num_files, ZEND_INCLUDE, threads > 0 ? (uint32_t) MIN(threads, num_files) : 1, op_arrays);
+
+	for (i = 0; i < num_files; i++) {
+		if (op_arrays[i]) {
+			destroy_op_array(op_arrays[i]);
+			efree_size(op_arrays[i], sizeof(zend_op_array));
+		}
+		zend_destroy_file_handle(&file_handles[i]);
+		zend_string_release(filenames[i]);
+	}
+	efree(filenames);
+	efree(op_arrays);
+	efree(file_handle_ptrs);
+	efree(file_handles);
+
+	RETURN_LONG(num_compiled);
+}
+/* }}} */
+
+/* {{{ proto string|false zend_realpath_cache(string path [, int size_limit [, bool forget_own_entries]])
+   Returns the realpath the realpath cache has for an absolute path, or false.
+   With a size_limit the path is resolved first, with the cache limited to that
+   many bytes. forget_own_entries first drops the entries of the calling thread,
+   as if it hadn't used the cache yet */
+ZEND_FUNCTION(zend_realpath_cache)
+{
+	zend_string *path;
+	zend_long size_limit = 0;
+	zend_bool forget_own_entries = 0;
+	realpath_cache_bucket *bucket;
+
+	ZEND_PARSE_PARAMETERS_START(1, 3)
+		Z_PARAM_PATH_STR(path)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_LONG(size_limit)
+		Z_PARAM_BOOL(forget_own_entries)
+	ZEND_PARSE_PARAMETERS_END();
+
+	if (forget_own_entries) {
+		realpath_cache_bucket **buckets = realpath_cache_get_buckets();
+		zend_long i;
+
+		for (i = 0; i < realpath_cache_max_buckets(); i++) {
+			while (buckets[i]) {
+				bucket = buckets[i];
+				buckets[i] = bucket->next;
+				free(bucket);
+			}
+		}
+		CWDG(realpath_cache_size) = 0;
+	}
+	if (size_limit > 0) {
+		zend_long old_limit = CWDG(realpath_cache_size_limit);
+		char resolved[MAXPATHLEN];
+
+		CWDG(realpath_cache_size_limit) = size_limit;
+		tsrm_realpath(ZSTR_VAL(path), resolved);
+		CWDG(realpath_cache_size_limit) = old_limit;
+	}
+
+	bucket = realpath_cache_lookup(ZSTR_VAL(path), ZSTR_LEN(path), time(0));
+	if (!bucket) {
+		RETURN_FALSE;
+	}
+	RETURN_STRINGL(bucket->realpath, bucket->realpath_len);
+}
+/* }}} */
+#endif
+
 /* {{{ proto string get_resource_type(resource res)
    Get the resource type name for a given resource */
 ZEND_FUNCTION(get_resource_type)
@@ -2171,69 +2416,48 @@ ZEND_FUNCTION(get_defined_constants)
 }
 /* }}} */
 
+static zend_always_inline zval *debug_backtrace_get_arg(zend_execute_data *call, uint32_t num_args, uint32_t i) /* {{{ */
+{
+	if (call->func->type == ZEND_USER_FUNCTION) {
+		uint32_t first_extra_arg = MIN(num_args, call->func->op_array.num_args);
+
+		if (i >= first_extra_arg) {
+			return ZEND_CALL_VAR_NUM(call, call->func->op_array.last_var + call->func->op_array.T + (i - first_extra_arg));
+		} else if (UNEXPECTED(ZEND_CALL_INFO(call) & ZEND_CALL_HAS_SYMBOL_TABLE)) {
+			/* In case of attached symbol_table, values on stack may be invalid
+			 * and we have to access them through symbol_table
+			 * See: https://bugs.php.net/bug.php?id=73156
+			 */
+			zval *arg = zend_hash_find_ex_ind(call->symbol_table, call->func->op_array.vars[i], 1);
+
+			return arg ? arg : &EG(uninitialized_zval);
+		}
+	}
+	return ZEND_CALL_ARG(call, i + 1);
+}
+/* }}} */
+
 static void debug_backtrace_get_args(zend_execute_data *call, zval *arg_array) /* {{{ */
 {
 	uint32_t num_args = ZEND_CALL_NUM_ARGS(call);
 
 	if (num_args) {
-		uint32_t i = 0;
-		zval *p = ZEND_CALL_ARG(call, 1);
+		uint32_t i;
+		zval *arg;
 
 		array_init_size(arg_array, num_args);
 		zend_hash_real_init_packed(Z_ARRVAL_P(arg_array));
 		ZEND_HASH_FILL_PACKED(Z_ARRVAL_P(arg_array)) {
-			if (call->func->type == ZEND_USER_FUNCTION) {
-				uint32_t first_extra_arg = MIN(num_args, call->func->op_array.num_args);
-
-				if (UNEXPECTED(ZEND_CALL_INFO(call) & ZEND_CALL_HAS_SYMBOL_TABLE)) {
-					/* In case of attached symbol_table, values on stack may be invalid
-					 * and we have to access them through symbol_table
-					 * See: https://bugs.php.net/bug.php?id=73156
-					 */
-					zend_string *arg_name;
-					zval *arg;
-
-					while (i < first_extra_arg) {
-						arg_name = call->func->op_array.vars[i];
-						arg = zend_hash_find_ex_ind(call->symbol_table, arg_name, 1);
-						if (arg) {
-							if (Z_OPT_REFCOUNTED_P(arg)) {
-								Z_ADDREF_P(arg);
-							}
-							ZEND_HASH_FILL_ADD(arg);
-						} else {
-							ZEND_HASH_FILL_ADD(&EG(uninitialized_zval));
-						}
-						i++;
+			for (i = 0; i < num_args; i++) {
+				arg = debug_backtrace_get_arg(call, num_args, i);
+				if (EXPECTED(Z_TYPE_INFO_P(arg) != IS_UNDEF)) {
+					if (Z_OPT_REFCOUNTED_P(arg)) {
+						Z_ADDREF_P(arg);
 					}
-				} else {
-					while (i < first_extra_arg) {
-						if (EXPECTED(Z_TYPE_INFO_P(p) != IS_UNDEF)) {
-							if (Z_OPT_REFCOUNTED_P(p)) {
-								Z_ADDREF_P(p);
-							}
-							ZEND_HASH_FILL_ADD(p);
-						} else {
-							ZEND_HASH_FILL_ADD(&EG(uninitialized_zval));
-						}
-						p++;
-						i++;
-					}
-				}
-				p = ZEND_CALL_VAR_NUM(call, call->func->op_array.last_var + call->func->op_array.T);
-			}
-
-			while (i < num_args) {
-				if (EXPECTED(Z_TYPE_INFO_P(p) != IS_UNDEF)) {
-					if (Z_OPT_REFCOUNTED_P(p)) {
-						Z_ADDREF_P(p);
-					}
-					ZEND_HASH_FILL_ADD(p);
+					ZEND_HASH_FILL_ADD(arg);
 				} else {
 					ZEND_HASH_FILL_ADD(&EG(uninitialized_zval));
 				}
-				p++;
-				i++;
 			}
 		} ZEND_HASH_FILL_END();
 		Z_ARRVAL_P(arg_array)->nNumOfElements = num_args;
@@ -2243,6 +2467,31 @@ static void debug_backtrace_get_args(zend_execute_data *call, zval *arg_array) /
 }
 /* }}} */
 
+static void debug_backtrace_copy_args(zend_backtrace *trace, uint32_t *args_size, zend_execute_data *call, zend_backtrace_frame *frame) /* {{{ */
+{
+	uint32_t num_args = ZEND_CALL_NUM_ARGS(call);
+	uint32_t i;
+	zval *arg, *dst;
+
+	if (trace->num_args + num_args > *args_size) {
+		*args_size = MAX(*args_size * 2, MAX(trace->num_args + num_args, 8));
+		trace->args = safe_erealloc(trace->args, *args_size, sizeof(zval), 0);
+	}
+	frame->first_arg = trace->num_args;
+	frame->num_args = num_args;
+	dst = trace->args + trace->num_args;
+	for (i = 0; i < num_args; i++, dst++) {
+		arg = debug_backtrace_get_arg(call, num_args, i);
+		if (EXPECTED(Z_TYPE_INFO_P(arg) != IS_UNDEF)) {
+			ZVAL_COPY(dst, arg);
+		} else {
+			ZVAL_NULL(dst);
+		}
+	}
+	trace->num_args += num_args;
+}
+/* }}} */
+
 void debug_print_backtrace_args(zval *arg_array) /* {{{ */
 {
 	zval *tmp;
@@ -2286,6 +2535,12 @@ ZEND_FUNCTION(debug_print_backtrace)
 	ptr = ptr->prev_execute_data;
 
 	while (ptr && (limit == 0 || frameno < limit)) {
+		/* continue from the bottom of a fiber into the frame that resumed it */
+		if (UNEXPECTED(ZEND_CALL_INFO(ptr) & ZEND_CALL_FIBER)) {
+			ptr = ptr->prev_execute_data;
+			continue;
+		}
+
 		frameno++;
 		class_name = NULL;
 		call_type = NULL;
@@ -2456,7 +2711,7 @@ ZEND_FUNCTION(debug_print_backtrace)
 
 /* }}} */
 
-ZEND_API void zend_fetch_debug_backtrace(zval *return_value, int skip_last, int options, int limit) /* {{{ */
+ZEND_API void zend_capture_backtrace(zend_backtrace *trace, int skip_last, int options, int limit) /* {{{ */
 {
 	zend_execute_data *ptr, *skip, *call = NULL;
 	zend_object *object;
@@ -2465,9 +2720,10 @@ ZEND_API void zend_fetch_debug_backtrace(zval *return_value, int skip_last, int
 	zend_string *function_name;
 	zend_string *filename;
 	zend_string *include_filename = NULL;
-	zval stack_frame, tmp;
+	zend_backtrace_frame *frame;
+	uint32_t frames_size = 0, args_size = 0;
 
-	array_init(return_value);
+	memset(trace, 0, sizeof(zend_backtrace));
 
 	if (!(ptr = EG(current_execute_data))) {
 		return;
@@ -2497,8 +2753,19 @@ ZEND_API void zend_fetch_debug_backtrace(zval *return_value, int skip_last, int
 	}
 
 	while (ptr && (limit == 0 || frameno < limit)) {
+		/* continue from the bottom of a fiber into the frame that resumed it */
+		if (UNEXPECTED(ZEND_CALL_INFO(ptr) & ZEND_CALL_FIBER)) {
+			ptr = ptr->prev_execute_data;
+			continue;
+		}
+
 		frameno++;
-		array_init(&stack_frame);
+		if (trace->num_frames == frames_size) {
+			frames_size = frames_size ? frames_size * 2 : 8;
+			trace->frames = safe_erealloc(trace->frames, frames_size, sizeof(zend_backtrace_frame), 0);
+		}
+		frame = &trace->frames[trace->num_frames++];
+		memset(frame, 0, sizeof(zend_backtrace_frame));
 
 		ptr = zend_generator_check_placeholder_frame(ptr);
 
@@ -2527,10 +2794,8 @@ ZEND_API void zend_fetch_debug_backtrace(zval *return_value, int skip_last, int
 			} else {
 				lineno = skip->opline->lineno;
 			}
-			ZVAL_STR_COPY(&tmp, filename);
-			zend_hash_add_new(Z_ARRVAL(stack_frame), ZSTR_KNOWN(ZEND_STR_FILE), &tmp);
-			ZVAL_LONG(&tmp, lineno);
-			zend_hash_add_new(Z_ARRVAL(stack_frame), ZSTR_KNOWN(ZEND_STR_LINE), &tmp);
+			frame->filename = zend_string_copy(filename);
+			frame->lineno = lineno;
 
 			/* try to fetch args only if an FCALL was just made - elsewise we're in the middle of a function
 			 * and debug_baktrace() might have been called by the error_handler. in this case we don't
@@ -2547,10 +2812,8 @@ ZEND_API void zend_fetch_debug_backtrace(zval *return_value, int skip_last, int
 					break;
 				}
 				if (prev->func && ZEND_USER_CODE(prev->func->common.type)) {
-					ZVAL_STR_COPY(&tmp, prev->func->op_array.filename);
-					zend_hash_add_new(Z_ARRVAL(stack_frame), ZSTR_KNOWN(ZEND_STR_FILE), &tmp);
-					ZVAL_LONG(&tmp, prev->opline->lineno);
-					zend_hash_add_new(Z_ARRVAL(stack_frame), ZSTR_KNOWN(ZEND_STR_LINE), &tmp);
+					frame->filename = zend_string_copy(prev->func->op_array.filename);
+					frame->lineno = prev->opline->lineno;
 					break;
 				}
 				prev_call = prev;
@@ -2575,38 +2838,31 @@ ZEND_API void zend_fetch_debug_backtrace(zval *return_value, int skip_last, int
 		}
 
 		if (function_name) {
-			ZVAL_STR_COPY(&tmp, function_name);
-			zend_hash_add_new(Z_ARRVAL(stack_frame), ZSTR_KNOWN(ZEND_STR_FUNCTION), &tmp);
+			frame->function_name = zend_string_copy(function_name);
 
 			if (object) {
 				if (func->common.scope) {
-					ZVAL_STR_COPY(&tmp, func->common.scope->name);
+					frame->class_name = zend_string_copy(func->common.scope->name);
 				} else if (object->handlers->get_class_name == zend_std_get_class_name) {
-					ZVAL_STR_COPY(&tmp, object->ce->name);
+					frame->class_name = zend_string_copy(object->ce->name);
 				} else {
-					ZVAL_STR(&tmp, object->handlers->get_class_name(object));
+					frame->class_name = object->handlers->get_class_name(object);
 				}
-				zend_hash_add_new(Z_ARRVAL(stack_frame), ZSTR_KNOWN(ZEND_STR_CLASS), &tmp);
 				if ((options & DEBUG_BACKTRACE_PROVIDE_OBJECT) != 0) {
-					ZVAL_OBJ(&tmp, object);
-					zend_hash_add_new(Z_ARRVAL(stack_frame), ZSTR_KNOWN(ZEND_STR_OBJECT), &tmp);
-					Z_ADDREF(tmp);
+					frame->object = object;
+					GC_ADDREF(object);
 				}
-
-				ZVAL_INTERNED_STR(&tmp, ZSTR_KNOWN(ZEND_STR_OBJECT_OPERATOR));
-				zend_hash_add_new(Z_ARRVAL(stack_frame), ZSTR_KNOWN(ZEND_STR_TYPE), &tmp);
+				frame->flags |= ZEND_BACKTRACE_FRAME_OBJECT_CALL;
 			} else if (func->common.scope) {
-				ZVAL_STR_COPY(&tmp, func->common.scope->name);
-				zend_hash_add_new(Z_ARRVAL(stack_frame), ZSTR_KNOWN(ZEND_STR_CLASS), &tmp);
-				ZVAL_INTERNED_STR(&tmp, ZSTR_KNOWN(ZEND_STR_PAAMAYIM_NEKUDOTAYIM));
-				zend_hash_add_new(Z_ARRVAL(stack_frame), ZSTR_KNOWN(ZEND_STR_TYPE), &tmp);
+				frame->class_name = zend_string_copy(func->common.scope->name);
+				frame->flags |= ZEND_BACKTRACE_FRAME_STATIC_CALL;
 			}
 
 			if ((options & DEBUG_BACKTRACE_IGNORE_ARGS) == 0 &&
 				func->type != ZEND_EVAL_CODE) {
 
-				debug_backtrace_get_args(call, &tmp);
-				zend_hash_add_new(Z_ARRVAL(stack_frame), ZSTR_KNOWN(ZEND_STR_ARGS), &tmp);
+				debug_backtrace_copy_args(trace, &args_size, call, frame);
+				frame->flags |= ZEND_BACKTRACE_FRAME_HAS_ARGS;
 			}
 		} else {
 			/* i know this is kinda ugly, but i'm trying to avoid extra cycles in the main execution loop */
@@ -2643,31 +2899,152 @@ ZEND_API void zend_fetch_debug_backtrace(zval *return_value, int skip_last, int
 					break;
 			}
 
-			if (build_filename_arg && include_filename) {
-				zval arg_array;
-
-				array_init(&arg_array);
+			frame->function_name = pseudo_function_name;
+			frame->flags |= ZEND_BACKTRACE_FRAME_PSEUDO;
 
+			if (build_filename_arg && include_filename) {
 				/* include_filename always points to the last filename of the last last called-function.
 				   if we have called include in the frame above - this is the file we have included.
 				 */
+				if (trace->num_args == args_size) {
+					args_size = MAX(args_size * 2, 8);
+					trace->args = safe_erealloc(trace->args, args_size, sizeof(zval), 0);
+				}
+				frame->first_arg = trace->num_args;
+				frame->num_args = 1;
+				ZVAL_STR_COPY(&trace->args[trace->num_args++], include_filename);
+				frame->flags |= ZEND_BACKTRACE_FRAME_HAS_ARGS;
+			}
+		}
+
+		include_filename = filename;
 
-				ZVAL_STR_COPY(&tmp, include_filename);
-				zend_hash_next_index_insert_new(Z_ARRVAL(arg_array), &tmp);
-				zend_hash_add_new(Z_ARRVAL(stack_frame), ZSTR_KNOWN(ZEND_STR_ARGS), &arg_array);
+		call = skip;
+		ptr = skip->prev_execute_data;
+	}
+}
+/* }}} */
+
+static void zend_backtrace_args_to_array(zval *arg_array, zval *args, uint32_t num_args) /* {{{ */
+{
+	if (num_args) {
+		uint32_t i;
+
+		array_init_size(arg_array, num_args);
+		zend_hash_real_init_packed(Z_ARRVAL_P(arg_array));
+		ZEND_HASH_FILL_PACKED(Z_ARRVAL_P(arg_array)) {
+			for (i = 0; i < num_args; i++) {
+				ZEND_HASH_FILL_ADD(&args[i]);
 			}
+		} ZEND_HASH_FILL_END();
+		Z_ARRVAL_P(arg_array)->nNumOfElements = num_args;
+	} else {
+		ZVAL_EMPTY_ARRAY(arg_array);
+	}
+}
+/* }}} */
+
+/* Builds the debug_backtrace() array, the values are moved out of the trace
+ * which is left empty */
+ZEND_API void zend_backtrace_to_array(zval *return_value, zend_backtrace *trace) /* {{{ */
+{
+	zend_backtrace_frame *frame, *end;
+	zval stack_frame, tmp;
+
+	array_init_size(return_value, trace->num_frames);
+
+	for (frame = trace->frames, end = frame + trace->num_frames; frame < end; frame++) {
+		array_init(&stack_frame);
+
+		if (frame->filename) {
+			ZVAL_STR(&tmp, frame->filename);
+			zend_hash_add_new(Z_ARRVAL(stack_frame), ZSTR_KNOWN(ZEND_STR_FILE), &tmp);
+			ZVAL_LONG(&tmp, frame->lineno);
+			zend_hash_add_new(Z_ARRVAL(stack_frame), ZSTR_KNOWN(ZEND_STR_LINE), &tmp);
+		}
 
-			ZVAL_INTERNED_STR(&tmp, pseudo_function_name);
+		if (!(frame->flags & ZEND_BACKTRACE_FRAME_PSEUDO)) {
+			ZVAL_STR(&tmp, frame->function_name);
+			zend_hash_add_new(Z_ARRVAL(stack_frame), ZSTR_KNOWN(ZEND_STR_FUNCTION), &tmp);
+
+			if (frame->class_name) {
+				ZVAL_STR(&tmp, frame->class_name);
+				zend_hash_add_new(Z_ARRVAL(stack_frame), ZSTR_KNOWN(ZEND_STR_CLASS), &tmp);
+			}
+			if (frame->object) {
+				ZVAL_OBJ(&tmp, frame->object);
+				zend_hash_add_new(Z_ARRVAL(stack_frame), ZSTR_KNOWN(ZEND_STR_OBJECT), &tmp);
+			}
+			if (frame->flags & ZEND_BACKTRACE_FRAME_OBJECT_CALL) {
+				ZVAL_INTERNED_STR(&tmp, ZSTR_KNOWN(ZEND_STR_OBJECT_OPERATOR));
+				zend_hash_add_new(Z_ARRVAL(stack_frame), ZSTR_KNOWN(ZEND_STR_TYPE), &tmp);
+			} else if (frame->flags & ZEND_BACKTRACE_FRAME_STATIC_CALL) {
+				ZVAL_INTERNED_STR(&tmp, ZSTR_KNOWN(ZEND_STR_PAAMAYIM_NEKUDOTAYIM));
+				zend_hash_add_new(Z_ARRVAL(stack_frame), ZSTR_KNOWN(ZEND_STR_TYPE), &tmp);
+			}
+			if (frame->flags & ZEND_BACKTRACE_FRAME_HAS_ARGS) {
+				zend_backtrace_args_to_array(&tmp, trace->args + frame->first_arg, frame->num_args);
+				zend_hash_add_new(Z_ARRVAL(stack_frame), ZSTR_KNOWN(ZEND_STR_ARGS), &tmp);
+			}
+		} else {
+			if (frame->flags & ZEND_BACKTRACE_FRAME_HAS_ARGS) {
+				zend_backtrace_args_to_array(&tmp, trace->args + frame->first_arg, frame->num_args);
+				zend_hash_add_new(Z_ARRVAL(stack_frame), ZSTR_KNOWN(ZEND_STR_ARGS), &tmp);
+			}
+			ZVAL_INTERNED_STR(&tmp, frame->function_name);
 			zend_hash_add_new(Z_ARRVAL(stack_frame), ZSTR_KNOWN(ZEND_STR_FUNCTION), &tmp);
 		}
 
 		zend_hash_next_index_insert_new(Z_ARRVAL_P(return_value), &stack_frame);
+	}
 
-		include_filename = filename;
+	if (trace->frames) {
+		efree(trace->frames);
+	}
+	if (trace->args) {
+		efree(trace->args);
+	}
+	memset(trace, 0, sizeof(zend_backtrace));
+}
+/* }}} */
 
-		call = skip;
-		ptr = skip->prev_execute_data;
+ZEND_API void zend_backtrace_destroy(zend_backtrace *trace) /* {{{ */
+{
+	zend_backtrace_frame *frame, *end;
+	uint32_t i;
+
+	for (frame = trace->frames, end = frame + trace->num_frames; frame < end; frame++) {
+		if (frame->filename) {
+			zend_string_release_ex(frame->filename, 0);
+		}
+		zend_string_release_ex(frame->function_name, 0);
+		if (frame->class_name) {
+			zend_string_release_ex(frame->class_name, 0);
+		}
+		if (frame->object) {
+			OBJ_RELEASE(frame->object);
+		}
+	}
+	for (i = 0; i < trace->num_args; i++) {
+		zval_ptr_dtor(&trace->args[i]);
+	}
+
+	if (trace->frames) {
+		efree(trace->frames);
+	}
+	if (trace->args) {
+		efree(trace->args);
 	}
+	memset(trace, 0, sizeof(zend_backtrace));
+}
+/* }}} */
+
+ZEND_API void zend_fetch_debug_backtrace(zval *return_value, int skip_last, int options, int limit) /* {{{ */
+{
+	zend_backtrace trace;
+
+	zend_capture_backtrace(&trace, skip_last, options, limit);
+	zend_backtrace_to_array(return_value, &trace);
 }
 /* }}} */
 
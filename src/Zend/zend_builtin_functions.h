@@ -22,8 +22,38 @@
 
 int zend_startup_builtin_functions(void);
 
+#define ZEND_BACKTRACE_FRAME_HAS_ARGS    (1<<0)
+#define ZEND_BACKTRACE_FRAME_PSEUDO      (1<<1) /* include, require or eval */
+#define ZEND_BACKTRACE_FRAME_OBJECT_CALL (1<<2)
+#define ZEND_BACKTRACE_FRAME_STATIC_CALL (1<<3)
+
+/* One frame of a captured backtrace, the strings and the object are owned
+ * by the frame, the arguments are stored in zend_backtrace.args */
+typedef struct _zend_backtrace_frame {
+	zend_string *filename;      /* NULL if the frame has no file and line */
+	zend_string *function_name;
+	zend_string *class_name;    /* NULL unless OBJECT_CALL or STATIC_CALL */
+	zend_object *object;        /* only with DEBUG_BACKTRACE_PROVIDE_OBJECT */
+	uint32_t     lineno;
+	uint32_t     flags;
+	uint32_t     first_arg;
+	uint32_t     num_args;
+} zend_backtrace_frame;
+
+/* A backtrace captured without building the debug_backtrace() array, it can
+ * be turned into that array later, after the frames are gone */
+typedef struct _zend_backtrace {
+	uint32_t              num_frames;
+	uint32_t              num_args;
+	zend_backtrace_frame *frames;
+	zval                 *args;
+} zend_backtrace;
+
 BEGIN_EXTERN_C()
 ZEND_API void zend_fetch_debug_backtrace(zval *return_value, int skip_last, int options, int limit);
+ZEND_API void zend_capture_backtrace(zend_backtrace *trace, int skip_last, int options, int limit);
+ZEND_API void zend_backtrace_to_array(zval *return_value, zend_backtrace *trace);
+ZEND_API void zend_backtrace_destroy(zend_backtrace *trace);
 END_EXTERN_C()
 
 #endif /* ZEND_BUILTIN_FUNCTIONS_H */
@@ -69,7 +69,7 @@ static inline uint32_t zend_alloc_cache_slot(void) {
 	return ret;
 }
 
-#define POLYMORPHIC_CACHE_SLOT_SIZE 2
+#define POLYMORPHIC_CACHE_SLOT_SIZE ZEND_POLYMORPHIC_CACHE_SLOT_SIZE
 
 static inline uint32_t zend_alloc_polymorphic_cache_slot(void) {
 	zend_op_array *op_array = CG(active_op_array);
@@ -129,6 +129,17 @@ static void zend_destroy_property_info_internal(zval *zv) /* {{{ */
 }
 /* }}} */
 
+/* Names that embed the position in the compiled file differ every time the
+ * file is compiled, so they are not worth publishing to other requests */
+static zend_string *zend_request_local_name(zend_string *name) /* {{{ */
+{
+	if (!(GC_FLAGS(name) & IS_STR_PERMANENT)) {
+		GC_ADD_FLAGS(name, IS_STR_REQUEST_LOCAL);
+	}
+	return name;
+}
+/* }}} */
+
 static zend_string *zend_build_runtime_definition_key(zend_string *name, unsigned char *lex_pos) /* {{{ */
 {
 	zend_string *result;
@@ -139,7 +150,7 @@ static zend_string *zend_build_runtime_definition_key(zend_string *name, unsigne
 	/* NULL, name length, filename length, last accepting char position length */
 	result = zend_string_alloc(1 + ZSTR_LEN(name) + ZSTR_LEN(filename) + char_pos_len, 0);
  	sprintf(ZSTR_VAL(result), "%c%s%s%s", '\0', ZSTR_VAL(name), ZSTR_VAL(filename), char_pos_buf);
-	return zend_new_interned_string(result);
+	return zend_request_local_name(zend_new_interned_string(result));
 }
 /* }}} */
 
@@ -620,6 +631,10 @@ void zend_stop_lexing(void)
 	}
 
 	LANG_SCNG(yy_cursor) = LANG_SCNG(yy_limit);
+	if (LANG_SCNG(yy_stream)) {
+		/* the rest of a streamed script is not read */
+		LANG_SCNG(yy_stream)->eof = 1;
+	}
 }
 
 static uint32_t zend_start_live_range(zend_op_array *op_array, uint32_t start) /* {{{ */
@@ -1733,6 +1748,12 @@ ZEND_API void zend_initialize_class_data(zend_class_entry *ce, zend_bool nullify
 	ce->default_properties_count = 0;
 	ce->default_static_members_count = 0;
 
+	ce->interface_set = NULL;
+	ce->interface_set_mask = 0;
+	ce->depth = 0;
+	memset(ce->display, 0, sizeof(ce->display));
+	ce->display[0] = ce;
+
 	if (nullify_handlers) {
 		ce->constructor = NULL;
 		ce->destructor = NULL;
@@ -6306,7 +6327,7 @@ static zend_string *zend_generate_anon_class_name(unsigned char *lex_pos) /* {{{
 	/* NULL, name length, filename length, last accepting char position length */
 	result = zend_string_alloc(sizeof("class@anonymous") + ZSTR_LEN(filename) + char_pos_len, 0);
 	sprintf(ZSTR_VAL(result), "class@anonymous%c%s%s", '\0', ZSTR_VAL(filename), char_pos_buf);
-	return zend_new_interned_string(result);
+	return zend_request_local_name(zend_new_interned_string(result));
 }
 /* }}} */
 
@@ -6349,7 +6370,7 @@ void zend_compile_class_decl(zend_ast *ast) /* {{{ */
 		zend_register_seen_symbol(lcname, ZEND_SYMBOL_CLASS);
 	} else {
 		name = zend_generate_anon_class_name(decl->lex_pos);
-		lcname = zend_string_tolower(name);
+		lcname = zend_request_local_name(zend_new_interned_string(zend_string_tolower(name)));
 	}
 	lcname = zend_new_interned_string(lcname);
 
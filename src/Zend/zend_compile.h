@@ -510,6 +510,7 @@ struct _zend_execute_data {
 #define ZEND_CALL_DYNAMIC            (1 << 9)
 #define ZEND_CALL_FAKE_CLOSURE       (1 << 10)
 #define ZEND_CALL_SEND_ARG_BY_REF    (1 << 11)
+#define ZEND_CALL_FIBER              (1 << 12) /* sentinel frame a fiber's stack starts on */
 
 #define ZEND_CALL_INFO_SHIFT         16
 
@@ -730,6 +731,8 @@ ZEND_API void zend_restore_compiled_filename(zend_string *original_compiled_file
 ZEND_API zend_string *zend_get_compiled_filename(void);
 ZEND_API int zend_get_compiled_lineno(void);
 ZEND_API size_t zend_get_scanned_file_offset(void);
+/* Identifies the current token within the script, used as lex_pos */
+ZEND_API unsigned char *zend_get_scanned_position(void);
 
 ZEND_API zend_string *zend_get_compiled_variable_name(const zend_op_array *op_array, uint32_t var);
 
@@ -780,6 +783,7 @@ ZEND_API void function_add_ref(zend_function *function);
 ZEND_API zend_op_array *compile_file(zend_file_handle *file_handle, int type);
 ZEND_API zend_op_array *compile_string(zval *source_string, char *filename);
 ZEND_API zend_op_array *compile_filename(int type, zval *filename);
+ZEND_API uint32_t zend_compile_files(zend_file_handle **file_handles, uint32_t num_files, int type, uint32_t num_threads, zend_op_array **op_arrays);
 ZEND_API void zend_try_exception_handler();
 ZEND_API int zend_execute_scripts(int type, zval *retval, int file_count, ...);
 ZEND_API int open_file_for_scanning(zend_file_handle *file_handle);
@@ -1048,6 +1052,10 @@ END_EXTERN_C()
 /* result of compilation may be stored in file cache */
 #define ZEND_COMPILE_WITH_FILE_CACHE			(1<<11)
 
+/* abort compilation with a bailout instead of reporting any error, warning
+ * or notice; the file is expected to be compiled again to report them */
+#define ZEND_COMPILE_ABORT_ON_ERROR				(1<<12)
+
 /* The default value for CG(compiler_options) */
 #define ZEND_COMPILE_DEFAULT					ZEND_COMPILE_HANDLE_OP_ARRAY
 
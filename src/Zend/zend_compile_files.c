@@ -0,0 +1,514 @@
+/*
+   +----------------------------------------------------------------------+
+   | Zend Engine                                                          |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 1998-2018 Zend Technologies Ltd. (http://www.zend.com) |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 2.00 of the Zend license,     |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:          |
+   | http://www.zend.com/license/2_00.txt.                                |
+   | If you did not receive a copy of the Zend license and are unable to  |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@zend.com so we can mail you a copy immediately.              |
+   +----------------------------------------------------------------------+
+*/
+
+#include "zend.h"
+#include "zend_compile.h"
+#include "zend_exceptions.h"
+#include "zend_execute.h"
+#include "zend_extensions.h"
+#include "zend_list.h"
+#include "zend_objects_API.h"
+
+/* Files are compiled on worker threads in thread safe builds only. Every
+ * worker is a regular TSRM thread, so the compiler, scanner and executor
+ * globals it uses are its own and the compiler runs unchanged. A worker
+ * allocates everything from a heap of its own, which is merged into the heap
+ * of the calling thread once the worker is done. */
+#if defined(ZTS) && defined(PTHREADS)
+# define ZEND_COMPILE_FILES_PARALLEL 1
+# include <pthread.h>
+#endif
+
+#ifdef ZEND_COMPILE_FILES_PARALLEL
+
+typedef struct _zend_compile_job {
+	zend_file_handle *file_handle;
+	zend_op_array    *op_array;
+	/* functions and classes declared by the file, keyed as in the real tables */
+	HashTable         function_table;
+	HashTable         class_table;
+	zend_bool         scheduled;
+	zend_bool         compiled;
+} zend_compile_job;
+
+typedef struct _zend_compile_batch {
+	zend_compile_job *jobs;
+	uint32_t          num_jobs;
+	uint32_t          next_job;
+	pthread_mutex_t   mutex;
+	int               type;
+	uint32_t          compiler_options;
+	zend_bool         short_tags;
+	/* auto globals of the calling thread, only read by the workers */
+	HashTable        *auto_globals;
+} zend_compile_batch;
+
+typedef struct _zend_compile_worker {
+	pthread_t           thread;
+	zend_compile_batch *batch;
+	/* left behind for the calling thread */
+	zend_mm_heap       *heap;
+	HashTable           interned_strings;
+	zend_arena         *arena;
+	zend_string       **auto_globals;
+	uint32_t            num_auto_globals;
+} zend_compile_worker;
+
+/* JIT auto globals must be created by the thread that runs the code. In a
+ * worker the callback does nothing and leaves the auto global disarmed; the
+ * worker lists the ones it disarmed and the calling thread arms them through
+ * zend_is_auto_global() once the batch is done. */
+static zend_bool zend_compile_files_auto_global(zend_string *name) /* {{{ */
+{
+	return 0;
+}
+/* }}} */
+
+/* Moves the entries added to a function or class table since "first" into
+ * the table of a job. */
+static void zend_compile_files_move_symbols(HashTable *source, uint32_t first, HashTable *target) /* {{{ */
+{
+	dtor_func_t orig_dtor = source->pDestructor;
+	uint32_t idx;
+
+	source->pDestructor = NULL;
+	for (idx = first; idx < source->nNumUsed; idx++) {
+		Bucket *p = source->arData + idx;
+
+		if (Z_TYPE(p->val) == IS_UNDEF) {
+			continue;
+		}
+		if (target) {
+			zend_hash_add_new_ptr(target, p->key, Z_PTR(p->val));
+		}
+		zend_hash_del_bucket(source, p);
+	}
+	source->pDestructor = orig_dtor;
+}
+/* }}} */
+
+static zend_compile_job *zend_compile_files_next_job(zend_compile_batch *batch) /* {{{ */
+{
+	zend_compile_job *job = NULL;
+
+	pthread_mutex_lock(&batch->mutex);
+	while (batch->next_job < batch->num_jobs) {
+		job = &batch->jobs[batch->next_job++];
+		if (job->scheduled) {
+			break;
+		}
+		job = NULL;
+	}
+	pthread_mutex_unlock(&batch->mutex);
+
+	return job;
+}
+/* }}} */
+
+static void *zend_compile_files_worker(void *arg) /* {{{ */
+{
+	zend_compile_worker *worker = (zend_compile_worker *) arg;
+	zend_compile_batch *batch = worker->batch;
+	zend_compile_job *job;
+	zend_mm_heap *orig_heap;
+	zend_auto_global *auto_global;
+	uint32_t first_function, first_class;
+	llist_dtor_func_t orig_dtor;
+
+	(void)ts_resource(0);
+	ZEND_TSRMLS_CACHE_UPDATE();
+
+	worker->heap = zend_mm_startup();
+	orig_heap = zend_mm_set_heap(worker->heap);
+
+	init_compiler();
+	startup_scanner();
+	zend_interned_strings_activate();
+	zend_objects_store_init(&EG(objects_store), 8);
+	/* for parse errors, which are thrown as exceptions */
+	EG(flags) = EG_FLAGS_INITIAL;
+	EG(prev_exception) = NULL;
+	EG(fake_scope) = NULL;
+	EG(function_table) = CG(function_table);
+	EG(class_table) = CG(class_table);
+
+	/* Nothing may be looked up in the tables of the calling thread, so
+	 * constants are fetched and classes inherited from unknown or internal
+	 * parents are bound at run-time or when the file is linked. Diagnostics
+	 * are left to the calling thread, which compiles the file again. */
+	CG(compiler_options) = batch->compiler_options
+		| ZEND_COMPILE_DELAYED_BINDING
+		| ZEND_COMPILE_IGNORE_INTERNAL_CLASSES
+		| ZEND_COMPILE_NO_CONSTANT_SUBSTITUTION
+		| ZEND_COMPILE_ABORT_ON_ERROR;
+	CG(short_tags) = batch->short_tags;
+
+	ZEND_HASH_FOREACH_PTR(CG(auto_globals), auto_global) {
+		zend_auto_global *orig = zend_hash_find_ptr(batch->auto_globals, auto_global->name);
+
+		auto_global->armed = orig && orig->armed;
+		auto_global->auto_global_callback = zend_compile_files_auto_global;
+	} ZEND_HASH_FOREACH_END();
+
+	first_function = CG(function_table)->nNumUsed;
+	first_class = CG(class_table)->nNumUsed;
+
+	while ((job = zend_compile_files_next_job(batch)) != NULL) {
+		/* The handle stays with the calling thread, its contents were read
+		 * in advance and the copy only scans them. */
+		zend_file_handle file_handle = *job->file_handle;
+		zend_bool bailout = 0;
+
+		zend_try {
+			job->op_array = compile_file(&file_handle, batch->type);
+		} zend_catch {
+			job->op_array = NULL;
+			bailout = 1;
+		} zend_end_try();
+
+		if (EG(exception)) {
+			zend_clear_exception();
+			if (job->op_array) {
+				destroy_op_array(job->op_array);
+				efree_size(job->op_array, sizeof(zend_op_array));
+				job->op_array = NULL;
+			}
+		}
+
+		job->compiled = job->op_array != NULL;
+		zend_compile_files_move_symbols(CG(function_table), first_function, job->compiled ? &job->function_table : NULL);
+		zend_compile_files_move_symbols(CG(class_table), first_class, job->compiled ? &job->class_table : NULL);
+
+		orig_dtor = CG(open_files).dtor;
+		CG(open_files).dtor = NULL;
+		zend_llist_clean(&CG(open_files));
+		CG(open_files).dtor = orig_dtor;
+
+		/* The compiler state can't be trusted after a bailout */
+		if (bailout) {
+			break;
+		}
+	}
+
+	worker->interned_strings = CG(interned_strings);
+	worker->arena = CG(arena);
+
+	worker->auto_globals = safe_emalloc(zend_hash_num_elements(CG(auto_globals)), sizeof(zend_string *), 0);
+	worker->num_auto_globals = 0;
+	ZEND_HASH_FOREACH_PTR(CG(auto_globals), auto_global) {
+		zend_auto_global *orig = zend_hash_find_ptr(batch->auto_globals, auto_global->name);
+
+		if (orig && orig->armed && !auto_global->armed) {
+			worker->auto_globals[worker->num_auto_globals++] = auto_global->name;
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	zend_try {
+		shutdown_scanner();
+	} zend_end_try();
+	zend_objects_store_destroy(&EG(objects_store));
+	zend_stack_destroy(&CG(loop_var_stack));
+	zend_stack_destroy(&CG(delayed_oplines_stack));
+	zend_hash_destroy(&CG(filenames_table));
+	zend_destroy_rsrc_list(&EG(regular_list));
+
+	zend_mm_set_heap(orig_heap);
+	ts_free_thread();
+
+	return NULL;
+}
+/* }}} */
+
+/* Registers a handle compiled by a worker like open_file_for_scanning() would */
+static void zend_compile_files_add_open_file(zend_file_handle *file_handle) /* {{{ */
+{
+	zend_llist_add_element(&CG(open_files), file_handle);
+	if (file_handle->handle.stream.handle >= (void*)file_handle && file_handle->handle.stream.handle <= (void*)(file_handle+1)) {
+		zend_file_handle *fh = (zend_file_handle*)zend_llist_get_last(&CG(open_files));
+		size_t diff = (char*)file_handle->handle.stream.handle - (char*)file_handle;
+		fh->handle.stream.handle = (void*)(((char*)fh) + diff);
+		file_handle->handle.stream.handle = fh->handle.stream.handle;
+	}
+}
+/* }}} */
+
+/* A file is only linked if that can't fail, otherwise it is compiled again so
+ * that the error is reported exactly as for a sequential compilation. */
+static zend_bool zend_compile_files_can_link(zend_compile_job *job) /* {{{ */
+{
+	zend_op_array *op_array = job->op_array;
+	zend_string *key;
+
+	ZEND_HASH_FOREACH_STR_KEY(&job->function_table, key) {
+		if (ZSTR_VAL(key)[0] && zend_hash_exists(CG(function_table), key)) {
+			return 0;
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	ZEND_HASH_FOREACH_STR_KEY(&job->class_table, key) {
+		if (ZSTR_VAL(key)[0] && zend_hash_exists(CG(class_table), key)) {
+			return 0;
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	if (op_array->fn_flags & ZEND_ACC_EARLY_BINDING) {
+		const zend_op *opline = op_array->opcodes;
+		const zend_op *end = opline + op_array->last;
+
+		for (; opline < end; opline++) {
+			if (opline->opcode == ZEND_DECLARE_INHERITED_CLASS_DELAYED
+			 && zend_hash_exists(CG(class_table), Z_STR_P(RT_CONSTANT(opline, opline->op1)))) {
+				return 0;
+			}
+		}
+	}
+
+	return 1;
+}
+/* }}} */
+
+static void zend_compile_files_link(zend_compile_job *job) /* {{{ */
+{
+	zend_op_array *op_array = job->op_array;
+	zend_string *key;
+	void *ptr;
+
+	/* runtime definition keys replace the ones of an earlier inclusion */
+	ZEND_HASH_FOREACH_STR_KEY_PTR(&job->function_table, key, ptr) {
+		if (ZSTR_VAL(key)[0]) {
+			zend_hash_add_new_ptr(CG(function_table), key, ptr);
+		} else {
+			zend_hash_update_ptr(CG(function_table), key, ptr);
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	ZEND_HASH_FOREACH_STR_KEY_PTR(&job->class_table, key, ptr) {
+		if (ZSTR_VAL(key)[0]) {
+			zend_hash_add_new_ptr(CG(class_table), key, ptr);
+		} else {
+			zend_hash_update_ptr(CG(class_table), key, ptr);
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	job->function_table.pDestructor = NULL;
+	zend_hash_destroy(&job->function_table);
+	job->class_table.pDestructor = NULL;
+	zend_hash_destroy(&job->class_table);
+
+	/* Classes whose parent was unknown to the worker are bound now, as if
+	 * still compiling the end of their declaration */
+	if (op_array->fn_flags & ZEND_ACC_EARLY_BINDING) {
+		const zend_op *opline = op_array->opcodes;
+		const zend_op *end = opline + op_array->last;
+		zend_string *orig_compiled_filename = CG(compiled_filename);
+		zend_bool orig_in_compilation = CG(in_compilation);
+		uint32_t orig_lineno = CG(zend_lineno);
+
+		CG(compiled_filename) = op_array->filename;
+		CG(in_compilation) = 1;
+		for (; opline < end; opline++) {
+			if (opline->opcode == ZEND_DECLARE_INHERITED_CLASS_DELAYED) {
+				zval *parent_name = RT_CONSTANT(opline, opline->op2);
+				zend_class_entry *parent_ce = zend_lookup_class_ex(Z_STR_P(parent_name), parent_name + 1, 0);
+
+				if (parent_ce) {
+					zend_class_entry *ce = zend_hash_find_ptr(CG(class_table), Z_STR_P(RT_CONSTANT(opline, opline->op1) + 1));
+
+					CG(zend_lineno) = ce->info.user.line_end;
+					do_bind_inherited_class(op_array, opline, CG(class_table), parent_ce, 0);
+				}
+			}
+		}
+		CG(compiled_filename) = orig_compiled_filename;
+		CG(in_compilation) = orig_in_compilation;
+		CG(zend_lineno) = orig_lineno;
+	}
+
+	zend_compile_files_add_open_file(job->file_handle);
+}
+/* }}} */
+
+static void zend_compile_files_discard(zend_compile_job *job) /* {{{ */
+{
+	zend_hash_destroy(&job->function_table);
+	zend_hash_destroy(&job->class_table);
+	if (job->op_array) {
+		destroy_op_array(job->op_array);
+		efree_size(job->op_array, sizeof(zend_op_array));
+		job->op_array = NULL;
+	}
+}
+/* }}} */
+
+/* Returns the number of files linked from the workers, or -1 if no worker
+ * could be set up */
+static int zend_compile_files_parallel(zend_file_handle **file_handles, uint32_t num_files, int type, uint32_t num_threads, zend_op_array **op_arrays) /* {{{ */
+{
+	zend_compile_batch batch;
+	zend_compile_worker *workers;
+	uint32_t i, num_workers = 0;
+	int num_linked = 0;
+
+	if (pthread_mutex_init(&batch.mutex, NULL) != 0) {
+		return -1;
+	}
+
+	batch.jobs = safe_emalloc(num_files, sizeof(zend_compile_job), 0);
+	batch.num_jobs = num_files;
+	batch.next_job = 0;
+	batch.type = type;
+	batch.compiler_options = CG(compiler_options);
+	batch.short_tags = CG(short_tags);
+	batch.auto_globals = CG(auto_globals);
+
+	/* Reading is left to the calling thread, opening a file may involve
+	 * stream wrappers that belong to it. Files that can't be read are
+	 * compiled in order later on, which reports the failure. */
+	for (i = 0; i < num_files; i++) {
+		zend_compile_job *job = &batch.jobs[i];
+		char *buf;
+		size_t size;
+
+		job->file_handle = file_handles[i];
+		job->op_array = NULL;
+		zend_hash_init(&job->function_table, 8, NULL, ZEND_FUNCTION_DTOR, 0);
+		zend_hash_init(&job->class_table, 8, NULL, ZEND_CLASS_DTOR, 0);
+		job->scheduled = zend_stream_fixup(job->file_handle, &buf, &size) == SUCCESS;
+		job->compiled = 0;
+	}
+
+	workers = safe_emalloc(num_threads, sizeof(zend_compile_worker), 0);
+	for (i = 0; i < num_threads; i++) {
+		workers[num_workers].batch = &batch;
+		if (pthread_create(&workers[num_workers].thread, NULL, zend_compile_files_worker, &workers[num_workers]) == 0) {
+			num_workers++;
+		}
+	}
+
+	for (i = 0; i < num_workers; i++) {
+		pthread_join(workers[i].thread, NULL);
+	}
+	pthread_mutex_destroy(&batch.mutex);
+
+	/* Take over everything the workers left behind */
+	for (i = 0; i < num_workers; i++) {
+		zend_compile_worker *worker = &workers[i];
+		zend_arena *arena = worker->arena;
+		uint32_t n;
+
+		zend_mm_adopt_heap(zend_mm_get_heap(), worker->heap);
+		zend_interned_strings_adopt(&worker->interned_strings);
+
+		/* property infos and bound functions live in the compiler arena */
+		while (arena->prev) {
+			arena = arena->prev;
+		}
+		arena->prev = CG(arena)->prev;
+		CG(arena)->prev = worker->arena;
+
+		for (n = 0; n < worker->num_auto_globals; n++) {
+			zend_is_auto_global(worker->auto_globals[n]);
+		}
+		efree(worker->auto_globals);
+	}
+	efree(workers);
+
+	for (i = 0; i < num_files; i++) {
+		zend_compile_job *job = &batch.jobs[i];
+
+		if (job->compiled && zend_compile_files_can_link(job)) {
+			zend_compile_files_link(job);
+			op_arrays[i] = job->op_array;
+			num_linked++;
+		} else {
+			zend_compile_files_discard(job);
+			op_arrays[i] = zend_compile_file(job->file_handle, type);
+		}
+
+		if (UNEXPECTED(EG(exception))) {
+			while (++i < num_files) {
+				zend_compile_files_discard(&batch.jobs[i]);
+				/* opened in advance, but never registered */
+				if (batch.jobs[i].scheduled) {
+					zend_file_handle_dtor(batch.jobs[i].file_handle);
+				}
+				op_arrays[i] = NULL;
+			}
+		}
+	}
+	efree(batch.jobs);
+
+	return num_linked;
+}
+/* }}} */
+
+#endif
+
+/* Compiles a list of files into op_arrays, which are linked into the function
+ * and class tables in the order of the list. With num_threads > 1 the files
+ * are compiled concurrently where that is supported; the result, including
+ * any error, is the same as for compiling them one after another. Compilation
+ * stops at the first file that throws, the remaining op_arrays are NULL.
+ * Returns how many of the files were compiled by a worker thread, the others
+ * were compiled by the calling thread. */
+ZEND_API uint32_t zend_compile_files(zend_file_handle **file_handles, uint32_t num_files, int type, uint32_t num_threads, zend_op_array **op_arrays) /* {{{ */
+{
+	uint32_t i;
+#ifdef ZEND_COMPILE_FILES_PARALLEL
+	int num_linked;
+#endif
+
+#ifdef ZEND_COMPILE_FILES_PARALLEL
+	if (num_threads > num_files) {
+		num_threads = num_files;
+	}
+	if (num_threads > 1
+	 && zend_compile_file == compile_file
+	 && !zend_ast_process
+	 && !(zend_extension_flags & (ZEND_EXTENSIONS_HAVE_OP_ARRAY_CTOR|ZEND_EXTENSIONS_HAVE_OP_ARRAY_HANDLER))
+	 && zend_interned_strings_are_thread_local()
+	 && !zend_mm_is_custom_heap(zend_mm_get_heap())
+	 && !CG(multibyte)
+	 && !CG(start_lineno)
+	 && (num_linked = zend_compile_files_parallel(file_handles, num_files, type, num_threads, op_arrays)) >= 0) {
+		return (uint32_t) num_linked;
+	}
+#else
+	(void) num_threads;
+#endif
+
+	for (i = 0; i < num_files; i++) {
+		op_arrays[i] = zend_compile_file(file_handles[i], type);
+		if (UNEXPECTED(EG(exception))) {
+			while (++i < num_files) {
+				op_arrays[i] = NULL;
+			}
+		}
+	}
+
+	return 0;
+}
+/* }}} */
+
+/*
+ * Local variables:
+ * tab-width: 4
+ * c-basic-offset: 4
+ * indent-tabs-mode: t
+ * End:
+ * vim600: sw=4 ts=4 fdm=marker
+ * vim<600: sw=4 ts=4
+ */
@@ -51,6 +51,32 @@ static void __zend_cpuid(uint32_t func, uint32_t subfunc, zend_cpu_info *cpuinfo
 }
 #endif
 
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+static uint64_t __zend_xgetbv(uint32_t xcr) {
+	uint32_t eax, edx;
+
+	__asm__ volatile (".byte 0x0f, 0x01, 0xd0" : "=a"(eax), "=d"(edx) : "c"(xcr));
+	return ((uint64_t)edx << 32) | eax;
+}
+#elif defined(ZEND_WIN32) && !defined(__clang__)
+static uint64_t __zend_xgetbv(uint32_t xcr) {
+	return _xgetbv(xcr);
+}
+#else
+static uint64_t __zend_xgetbv(uint32_t xcr) {
+	return 0;
+}
+#endif
+
+/* AVX registers are only usable when the OS saves them on context switches */
+static int is_avx_supported(void) {
+	if (!(cpuinfo.ecx & ZEND_CPU_FEATURE_AVX) || !(cpuinfo.ecx & ZEND_CPU_FEATURE_OSXSAVE)) {
+		return 0;
+	}
+	/* XMM and YMM state */
+	return (__zend_xgetbv(0) & 0x6) == 0x6;
+}
+
 void zend_cpu_startup(void)
 {
 	if (!cpuinfo.initialized) {
@@ -65,6 +91,11 @@ void zend_cpu_startup(void)
 		/* for avx2 */
 		__zend_cpuid(7, 0, &ebx);
 		cpuinfo.ebx = ebx.ebx;
+
+		if (!is_avx_supported()) {
+			cpuinfo.ecx &= ~ZEND_CPU_FEATURE_AVX;
+			cpuinfo.ebx &= ~(ZEND_CPU_FEATURE_AVX2 & ~ZEND_CPU_EBX_MASK);
+		}
 	}
 }
 
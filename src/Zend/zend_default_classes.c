@@ -24,6 +24,7 @@
 #include "zend_exceptions.h"
 #include "zend_closures.h"
 #include "zend_generators.h"
+#include "zend_fibers.h"
 
 
 ZEND_API void zend_register_default_classes(void)
@@ -33,6 +34,7 @@ ZEND_API void zend_register_default_classes(void)
 	zend_register_iterator_wrapper();
 	zend_register_closure_ce();
 	zend_register_generator_ce();
+	zend_register_fiber_ce();
 }
 
 /*
@@ -24,6 +24,7 @@
 #include "zend_builtin_functions.h"
 #include "zend_interfaces.h"
 #include "zend_exceptions.h"
+#include "zend_fibers.h"
 #include "zend_vm.h"
 #include "zend_dtrace.h"
 #include "zend_smart_str.h"
@@ -43,6 +44,19 @@ ZEND_API void (*zend_throw_exception_hook)(zval *ex);
 
 static zend_object_handlers default_exception_handlers;
 
+/* The backtrace of a new exception is only captured as frame snapshots, the
+ * "trace" property is built from them the first time it is accessed */
+typedef struct _zend_exception_object {
+	zend_backtrace trace;
+	zend_object    std;
+} zend_exception_object;
+
+static zend_always_inline zend_exception_object *zend_exception_from_obj(zend_object *obj) /* {{{ */
+{
+	return (zend_exception_object *)((char *)(obj) - XtOffsetOf(zend_exception_object, std));
+}
+/* }}} */
+
 /* {{{ zend_implement_throwable */
 static int zend_implement_throwable(zend_class_entry *interface, zend_class_entry *class_type)
 {
@@ -79,6 +93,12 @@ void zend_exception_set_previous(zend_object *exception, zend_object *add_previo
 	if (exception == add_previous || !add_previous || !exception) {
 		return;
 	}
+	if (UNEXPECTED(zend_is_fiber_exit(exception) || zend_is_fiber_exit(add_previous))) {
+		/* The marker unwinding a destroyed fiber is not Throwable and is never
+		 * chained: it is either replaced by a real exception or discards it */
+		OBJ_RELEASE(add_previous);
+		return;
+	}
 	ZVAL_OBJ(&pv, add_previous);
 	if (!instanceof_function(Z_OBJCE(pv), zend_ce_throwable)) {
 		zend_error_noreturn(E_CORE_ERROR, "Previous exception must implement Throwable");
@@ -201,22 +221,23 @@ ZEND_API void zend_clear_exception(void) /* {{{ */
 static zend_object *zend_default_exception_new_ex(zend_class_entry *class_type, int skip_top_traces) /* {{{ */
 {
 	zval obj, tmp;
+	zend_exception_object *intern;
 	zend_object *object;
-	zval trace;
 	zend_class_entry *base_ce;
 	zend_string *filename;
 
-	Z_OBJ(obj) = object = zend_objects_new(class_type);
-	Z_OBJ_HT(obj) = &default_exception_handlers;
+	intern = zend_object_alloc(sizeof(zend_exception_object), class_type);
+	memset(&intern->trace, 0, sizeof(zend_backtrace));
+	object = &intern->std;
+	zend_object_std_init(object, class_type);
+	object->handlers = &default_exception_handlers;
+	ZVAL_OBJ(&obj, object);
 
 	object_properties_init(object, class_type);
 
 	if (EG(current_execute_data)) {
-		zend_fetch_debug_backtrace(&trace, skip_top_traces, 0, 0);
-	} else {
-		array_init(&trace);
+		zend_capture_backtrace(&intern->trace, skip_top_traces, 0, 0);
 	}
-	Z_SET_REFCOUNT(trace, 0);
 
 	base_ce = i_get_exception_base(&obj);
 
@@ -233,12 +254,144 @@ static zend_object *zend_default_exception_new_ex(zend_class_entry *class_type,
 		ZVAL_LONG(&tmp, zend_get_compiled_lineno());
 		zend_update_property_ex(base_ce, &obj, ZSTR_KNOWN(ZEND_STR_LINE), &tmp);
 	}
-	zend_update_property_ex(base_ce, &obj, ZSTR_KNOWN(ZEND_STR_TRACE), &trace);
+	if (!intern->trace.num_frames) {
+		ZVAL_EMPTY_ARRAY(&tmp);
+		zend_update_property_ex(base_ce, &obj, ZSTR_KNOWN(ZEND_STR_TRACE), &tmp);
+	}
 
 	return object;
 }
 /* }}} */
 
+static void zend_exception_build_trace(zend_object *object) /* {{{ */
+{
+	zend_exception_object *intern = zend_exception_from_obj(object);
+	zend_backtrace trace = intern->trace;
+	zend_class_entry *base_ce;
+	zval obj, rv, *current, tmp;
+
+	/* detach the snapshots first, the property access below comes back
+	 * through the handlers */
+	memset(&intern->trace, 0, sizeof(zend_backtrace));
+
+	ZVAL_OBJ(&obj, object);
+	base_ce = i_get_exception_base(&obj);
+	current = zend_read_property_ex(base_ce, &obj, ZSTR_KNOWN(ZEND_STR_TRACE), 1, &rv);
+	if (Z_TYPE_P(current) != IS_NULL) {
+		/* the property was written without going through the handlers */
+		zend_backtrace_destroy(&trace);
+		return;
+	}
+	zend_backtrace_to_array(&tmp, &trace);
+	zend_update_property_ex(base_ce, &obj, ZSTR_KNOWN(ZEND_STR_TRACE), &tmp);
+	zval_ptr_dtor(&tmp);
+}
+/* }}} */
+
+/* Builds a pending trace before "trace" is accessed and keeps the VM from
+ * caching its slot, a cached access would bypass the handlers */
+static zend_always_inline void **zend_exception_check_member(zval *object, zval *member, void **cache_slot) /* {{{ */
+{
+	if (UNEXPECTED(Z_TYPE_P(member) != IS_STRING)
+			|| UNEXPECTED(zend_string_equals(Z_STR_P(member), ZSTR_KNOWN(ZEND_STR_TRACE)))) {
+		if (zend_exception_from_obj(Z_OBJ_P(object))->trace.num_frames) {
+			zend_exception_build_trace(Z_OBJ_P(object));
+		}
+		return NULL;
+	}
+	return cache_slot;
+}
+/* }}} */
+
+static zval *zend_exception_read_property(zval *object, zval *member, int type, void **cache_slot, zval *rv) /* {{{ */
+{
+	return zend_std_read_property(object, member, type, zend_exception_check_member(object, member, cache_slot), rv);
+}
+/* }}} */
+
+static void zend_exception_write_property(zval *object, zval *member, zval *value, void **cache_slot) /* {{{ */
+{
+	zend_std_write_property(object, member, value, zend_exception_check_member(object, member, cache_slot));
+}
+/* }}} */
+
+static zval *zend_exception_get_property_ptr_ptr(zval *object, zval *member, int type, void **cache_slot) /* {{{ */
+{
+	return zend_std_get_property_ptr_ptr(object, member, type, zend_exception_check_member(object, member, cache_slot));
+}
+/* }}} */
+
+static int zend_exception_has_property(zval *object, zval *member, int has_set_exists, void **cache_slot) /* {{{ */
+{
+	return zend_std_has_property(object, member, has_set_exists, zend_exception_check_member(object, member, cache_slot));
+}
+/* }}} */
+
+static void zend_exception_unset_property(zval *object, zval *member, void **cache_slot) /* {{{ */
+{
+	zend_std_unset_property(object, member, zend_exception_check_member(object, member, cache_slot));
+}
+/* }}} */
+
+static HashTable *zend_exception_get_properties(zval *object) /* {{{ */
+{
+	if (zend_exception_from_obj(Z_OBJ_P(object))->trace.num_frames) {
+		zend_exception_build_trace(Z_OBJ_P(object));
+	}
+	return zend_std_get_properties(object);
+}
+/* }}} */
+
+static HashTable *zend_exception_get_gc(zval *object, zval **table, int *n) /* {{{ */
+{
+	zend_object *zobj = Z_OBJ_P(object);
+	zend_exception_object *intern = zend_exception_from_obj(zobj);
+
+	if (!intern->trace.num_args) {
+		if (zobj->properties) {
+			*table = NULL;
+			*n = 0;
+			return zobj->properties;
+		}
+		*table = zobj->properties_table;
+		*n = zobj->ce->default_properties_count;
+		return NULL;
+	}
+
+	/* the captured arguments are reported as the table, the declared
+	 * properties through the property table */
+	if (!zobj->properties) {
+		rebuild_object_properties(zobj);
+	}
+	*table = intern->trace.args;
+	*n = intern->trace.num_args;
+	return zobj->properties;
+}
+/* }}} */
+
+static int zend_exception_compare_objects(zval *o1, zval *o2) /* {{{ */
+{
+	if (zend_exception_from_obj(Z_OBJ_P(o1))->trace.num_frames) {
+		zend_exception_build_trace(Z_OBJ_P(o1));
+	}
+	if (zend_exception_from_obj(Z_OBJ_P(o2))->trace.num_frames) {
+		zend_exception_build_trace(Z_OBJ_P(o2));
+	}
+	return zend_std_compare_objects(o1, o2);
+}
+/* }}} */
+
+static void zend_exception_free_obj(zend_object *object) /* {{{ */
+{
+	zend_exception_object *intern = zend_exception_from_obj(object);
+
+	if (intern->trace.num_frames) {
+		zend_backtrace_destroy(&intern->trace);
+	}
+	zend_object_std_dtor(object);
+}
+/* }}} */
+
 static zend_object *zend_default_exception_new(zend_class_entry *class_type) /* {{{ */
 {
 	return zend_default_exception_new_ex(class_type, 0);
@@ -809,7 +962,17 @@ void zend_register_default_exception(void) /* {{{ */
 	REGISTER_MAGIC_INTERFACE(throwable, Throwable);
 
 	memcpy(&default_exception_handlers, &std_object_handlers, sizeof(zend_object_handlers));
+	default_exception_handlers.offset = XtOffsetOf(zend_exception_object, std);
+	default_exception_handlers.free_obj = zend_exception_free_obj;
 	default_exception_handlers.clone_obj = NULL;
+	default_exception_handlers.read_property = zend_exception_read_property;
+	default_exception_handlers.write_property = zend_exception_write_property;
+	default_exception_handlers.get_property_ptr_ptr = zend_exception_get_property_ptr_ptr;
+	default_exception_handlers.has_property = zend_exception_has_property;
+	default_exception_handlers.unset_property = zend_exception_unset_property;
+	default_exception_handlers.get_properties = zend_exception_get_properties;
+	default_exception_handlers.get_gc = zend_exception_get_gc;
+	default_exception_handlers.compare_objects = zend_exception_compare_objects;
 
 	INIT_CLASS_ENTRY(ce, "Exception", default_exception_functions);
 	zend_ce_exception = zend_register_internal_class_ex(&ce, NULL);
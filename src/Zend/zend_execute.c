@@ -2202,7 +2202,7 @@ static zend_always_inline void zend_fetch_property_address(zval *result, zval *c
 		} while (0);
 	}
 	if (prop_op_type == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(container) == CACHED_PTR_EX(cache_slot))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, Z_OBJCE_P(container)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 		zend_object *zobj = Z_OBJ_P(container);
 		zval *retval;
@@ -3576,6 +3576,237 @@ ZEND_API zval *zend_get_zval_ptr(const zend_op *opline, int op_type, const znode
 	return ret;
 }
 
+/* {{{ Polymorphic inline caches */
+
+/* Sites that saw more classes than a polymorphic cache slot has ways for
+ * share this two-way set associative cache, indexed by (site id, class).
+ * Entries may be evicted by other sites at any time, the site then misses
+ * and looks the value up again. It lives as long as the request, like the class entries
+ * and run-time caches it refers to. */
+#ifndef ZEND_MEGAMORPHIC_CACHE_BITS
+# define ZEND_MEGAMORPHIC_CACHE_BITS 10
+#endif
+#define ZEND_MEGAMORPHIC_CACHE_SIZE (1 << ZEND_MEGAMORPHIC_CACHE_BITS)
+
+typedef struct _zend_megamorphic_cache_entry {
+	uintptr_t  site;
+	void      *ce;
+	void      *ptr;
+} zend_megamorphic_cache_entry;
+
+/* Returns the first of the two entries the pair may be kept in */
+static zend_always_inline zend_megamorphic_cache_entry *zend_megamorphic_cache_bucket(uintptr_t site, void *ce)
+{
+	/* class entries come from the same bins or arena, their low bits hardly
+	 * differ; multiplicative hashing takes the well mixed high bits */
+	uint32_t h = (uint32_t)((uintptr_t)ce >> 3) * 0x9e3779b1U;
+
+	h ^= (uint32_t)site * 0x85ebca77U;
+
+	return EG(megamorphic_cache) + ((h >> (32 - ZEND_MEGAMORPHIC_CACHE_BITS)) & ~1U);
+}
+
+static zend_always_inline zend_megamorphic_cache_entry *zend_megamorphic_cache_find(uintptr_t site, void *ce)
+{
+	zend_megamorphic_cache_entry *entry = zend_megamorphic_cache_bucket(site, ce);
+
+	if (entry[0].ce == ce && entry[0].site == site) {
+		return &entry[0];
+	} else if (entry[1].ce == ce && entry[1].site == site) {
+		return &entry[1];
+	}
+	return NULL;
+}
+
+static void zend_megamorphic_cache_add(uintptr_t site, void *ce, void *ptr)
+{
+	zend_megamorphic_cache_entry *entry;
+
+	if (UNEXPECTED(!EG(megamorphic_cache))) {
+		EG(megamorphic_cache) = ecalloc(ZEND_MEGAMORPHIC_CACHE_SIZE, sizeof(zend_megamorphic_cache_entry));
+	}
+	entry = zend_megamorphic_cache_bucket(site, ce);
+	entry[1] = entry[0];
+	entry[0].site = site;
+	entry[0].ce = ce;
+	entry[0].ptr = ptr;
+}
+
+#if ZEND_POLYMORPHIC_CACHE_STATS
+static zend_polymorphic_cache_stats *zend_polymorphic_cache_get_stats(void **slot)
+{
+	zend_polymorphic_cache_stats *stats = slot[ZEND_POLYMORPHIC_CACHE_STATS_PTR];
+
+	if (!stats) {
+		zend_execute_data *ex = EG(current_execute_data);
+
+		while (ex && (!ex->func || !ZEND_USER_CODE(ex->func->type))) {
+			ex = ex->prev_execute_data;
+		}
+		stats = ecalloc(1, sizeof(zend_polymorphic_cache_stats));
+		if (ex) {
+			stats->filename = zend_string_copy(ex->func->op_array.filename);
+			stats->lineno = ex->opline->lineno;
+			stats->opcode = ex->opline->opcode;
+		}
+		stats->next = EG(polymorphic_cache_stats);
+		EG(polymorphic_cache_stats) = stats;
+		slot[ZEND_POLYMORPHIC_CACHE_STATS_PTR] = stats;
+	}
+	return stats;
+}
+
+static int zend_polymorphic_cache_stats_compare(const void *a, const void *b)
+{
+	const zend_polymorphic_cache_stats *s1 = *(const zend_polymorphic_cache_stats **)a;
+	const zend_polymorphic_cache_stats *s2 = *(const zend_polymorphic_cache_stats **)b;
+
+	return s1->misses < s2->misses ? 1 : (s1->misses > s2->misses ? -1 : 0);
+}
+
+static void zend_polymorphic_cache_stats_swap(void *a, void *b)
+{
+	zend_polymorphic_cache_stats *tmp = *(zend_polymorphic_cache_stats **)a;
+
+	*(zend_polymorphic_cache_stats **)a = *(zend_polymorphic_cache_stats **)b;
+	*(zend_polymorphic_cache_stats **)b = tmp;
+}
+#endif
+
+/* Looks for ce in the ways after the first one and in the megamorphic cache,
+ * what is found is swapped with the first way */
+ZEND_API int ZEND_FASTCALL zend_polymorphic_cache_find_slow(void **slot, void *ce)
+{
+	uintptr_t site;
+	void *ptr;
+	uint32_t i;
+
+	for (i = 2; i < ZEND_POLYMORPHIC_CACHE_SITE && slot[i]; i += 2) {
+		if (slot[i] == ce) {
+			ptr = slot[i + 1];
+			slot[i] = slot[0];
+			slot[i + 1] = slot[1];
+			goto found;
+		}
+	}
+
+	site = (uintptr_t)slot[ZEND_POLYMORPHIC_CACHE_SITE];
+	if (site) {
+		zend_megamorphic_cache_entry *entry = zend_megamorphic_cache_find(site, ce);
+
+		if (entry) {
+			/* the last way is in the megamorphic cache as well */
+			ptr = entry->ptr;
+			slot[ZEND_POLYMORPHIC_CACHE_SITE - 2] = slot[0];
+			slot[ZEND_POLYMORPHIC_CACHE_SITE - 1] = slot[1];
+			goto found;
+		}
+	}
+
+#if ZEND_POLYMORPHIC_CACHE_STATS
+	zend_polymorphic_cache_get_stats(slot)->misses++;
+#endif
+	return 0;
+
+found:
+	slot[0] = ce;
+	slot[1] = ptr;
+#if ZEND_POLYMORPHIC_CACHE_STATS
+	zend_polymorphic_cache_get_stats(slot)->hits++;
+#endif
+	return 1;
+}
+
+ZEND_API void ZEND_FASTCALL zend_polymorphic_cache_add(void **slot, void *ce, void *ptr)
+{
+#if ZEND_POLYMORPHIC_CACHE_STATS
+	zend_polymorphic_cache_stats *stats = zend_polymorphic_cache_get_stats(slot);
+
+	if (slot[0] != ce) {
+		stats->classes++;
+	}
+#endif
+
+	if (slot[0] != ce && slot[0] != NULL) {
+		uint32_t i;
+
+		for (i = 2; i < ZEND_POLYMORPHIC_CACHE_SITE; i += 2) {
+			if (!slot[i]) {
+				break;
+			}
+		}
+		if (i == ZEND_POLYMORPHIC_CACHE_SITE) {
+			/* All the ways are taken, keep everything in the megamorphic
+			 * cache from now on */
+			uintptr_t site = (uintptr_t)slot[ZEND_POLYMORPHIC_CACHE_SITE];
+
+			if (!site) {
+				site = ++EG(megamorphic_sites);
+				slot[ZEND_POLYMORPHIC_CACHE_SITE] = (void*)site;
+				for (i = 0; i < ZEND_POLYMORPHIC_CACHE_SITE; i += 2) {
+					zend_megamorphic_cache_add(site, slot[i], slot[i + 1]);
+				}
+#if ZEND_POLYMORPHIC_CACHE_STATS
+				stats->megamorphic = 1;
+#endif
+			}
+			zend_megamorphic_cache_add(site, ce, ptr);
+			i = ZEND_POLYMORPHIC_CACHE_SITE - 2;
+		}
+		slot[i] = slot[0];
+		slot[i + 1] = slot[1];
+	}
+	slot[0] = ce;
+	slot[1] = ptr;
+}
+
+/* Prints the statistics of the sites used by the request, those with the
+ * most misses first, and forgets them */
+ZEND_API void zend_polymorphic_cache_dump_stats(void)
+{
+#if ZEND_POLYMORPHIC_CACHE_STATS
+	zend_polymorphic_cache_stats *stats, **list;
+	uint32_t count = 0, i;
+
+	for (stats = EG(polymorphic_cache_stats); stats; stats = stats->next) {
+		count++;
+	}
+	if (!count) {
+		return;
+	}
+
+	list = emalloc(count * sizeof(zend_polymorphic_cache_stats*));
+	for (i = 0, stats = EG(polymorphic_cache_stats); stats; stats = stats->next) {
+		list[i++] = stats;
+	}
+	zend_sort(list, count, sizeof(zend_polymorphic_cache_stats*),
+		(compare_func_t) zend_polymorphic_cache_stats_compare,
+		(swap_func_t) zend_polymorphic_cache_stats_swap);
+
+	fprintf(stderr, "%-40s %-24s %10s %10s %8s\n", "site", "opcode", "hits", "misses", "classes");
+	for (i = 0; i < count; i++) {
+		char site[MAXPATHLEN + 16];
+
+		stats = list[i];
+		snprintf(site, sizeof(site), "%s:%u", stats->filename ? ZSTR_VAL(stats->filename) : "[unknown]", stats->lineno);
+		fprintf(stderr, "%-40s %-24s %10" ZEND_ULONG_FMT_SPEC " %10" ZEND_ULONG_FMT_SPEC " %8" ZEND_ULONG_FMT_SPEC "%s\n",
+			site,
+			zend_get_opcode_name(stats->opcode),
+			stats->hits,
+			stats->misses,
+			stats->classes,
+			stats->megamorphic ? " megamorphic" : "");
+		if (stats->filename) {
+			zend_string_release(stats->filename);
+		}
+		efree(stats);
+	}
+	efree(list);
+	EG(polymorphic_cache_stats) = NULL;
+#endif
+}
+/* }}} */
+
 ZEND_API void ZEND_FASTCALL zend_check_internal_arg_type(zend_function *zf, uint32_t arg_num, zval *arg)
 {
 	void *dummy_cache_slot = NULL;
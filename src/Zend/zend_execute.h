@@ -345,16 +345,75 @@ ZEND_API int ZEND_FASTCALL zend_do_fcall_overloaded(zend_execute_data *call, zva
 		((void**)((char*)EX_RUN_TIME_CACHE() + (num)))[0] = (ptr); \
 	} while (0)
 
+/* A polymorphic cache slot keeps the values looked up for up to
+ * ZEND_POLYMORPHIC_CACHE_WAYS classes as (class, value) pairs. The pair of
+ * the class that was looked up last is always moved to the first way, so
+ * after a lookup slot[1] may be read and updated in place. A site that sees
+ * more classes turns megamorphic: it gets an id, stored after the pairs,
+ * and keeps its values in a per-request cache shared by all such sites
+ * (see zend_execute.c).
+ *
+ * Every polymorphic site takes ZEND_POLYMORPHIC_CACHE_SLOT_SIZE pointers of
+ * the run-time cache of its op_array, 9 with the default of 4 ways where a
+ * single (class, value) pair took 2. Builds that care more about the size of
+ * the run-time cache than about sites seeing a few classes may define a
+ * lower number of ways. */
+#ifndef ZEND_POLYMORPHIC_CACHE_WAYS
+# define ZEND_POLYMORPHIC_CACHE_WAYS 4
+#endif
+
+/* Build with ZEND_POLYMORPHIC_CACHE_STATS=1 to count hits and misses of every
+ * site, they are printed to stderr at the end of the request. */
+#ifndef ZEND_POLYMORPHIC_CACHE_STATS
+# define ZEND_POLYMORPHIC_CACHE_STATS 0
+#endif
+
+#define ZEND_POLYMORPHIC_CACHE_SITE      (ZEND_POLYMORPHIC_CACHE_WAYS * 2)
+#define ZEND_POLYMORPHIC_CACHE_STATS_PTR (ZEND_POLYMORPHIC_CACHE_SITE + 1)
+#define ZEND_POLYMORPHIC_CACHE_SLOT_SIZE (ZEND_POLYMORPHIC_CACHE_SITE + 1 + ZEND_POLYMORPHIC_CACHE_STATS)
+
+typedef struct _zend_polymorphic_cache_stats zend_polymorphic_cache_stats;
+
+struct _zend_polymorphic_cache_stats {
+	zend_polymorphic_cache_stats *next;
+	zend_string *filename;
+	uint32_t lineno;
+	zend_uchar opcode;
+	zend_ulong hits;
+	zend_ulong misses;
+	zend_ulong classes;
+	zend_bool megamorphic;
+};
+
+ZEND_API int ZEND_FASTCALL zend_polymorphic_cache_find_slow(void **slot, void *ce);
+ZEND_API void ZEND_FASTCALL zend_polymorphic_cache_add(void **slot, void *ce, void *ptr);
+ZEND_API void zend_polymorphic_cache_dump_stats(void);
+
+/* Whether there is a value for ce; if so, it's moved to slot[1] */
+static zend_always_inline int zend_polymorphic_cache_find(void **slot, void *ce)
+{
+	if (EXPECTED(slot[0] == ce)) {
+#if ZEND_POLYMORPHIC_CACHE_STATS
+		((zend_polymorphic_cache_stats*)slot[ZEND_POLYMORPHIC_CACHE_STATS_PTR])->hits++;
+#endif
+		return 1;
+	}
+	return zend_polymorphic_cache_find_slow(slot, ce);
+}
+
+static zend_always_inline void *zend_polymorphic_cache_lookup(void **slot, void *ce)
+{
+	return zend_polymorphic_cache_find(slot, ce) ? slot[1] : NULL;
+}
+
+#define CACHED_POLYMORPHIC_FIND(num, ce) \
+	zend_polymorphic_cache_find(CACHE_ADDR(num), (void*)(ce))
+
 #define CACHED_POLYMORPHIC_PTR(num, ce) \
-	(EXPECTED(((void**)((char*)EX_RUN_TIME_CACHE() + (num)))[0] == (void*)(ce)) ? \
-		((void**)((char*)EX_RUN_TIME_CACHE() + (num)))[1] : \
-		NULL)
-
-#define CACHE_POLYMORPHIC_PTR(num, ce, ptr) do { \
-		void **slot = (void**)((char*)EX_RUN_TIME_CACHE() + (num)); \
-		slot[0] = (ce); \
-		slot[1] = (ptr); \
-	} while (0)
+	zend_polymorphic_cache_lookup(CACHE_ADDR(num), (void*)(ce))
+
+#define CACHE_POLYMORPHIC_PTR(num, ce, ptr) \
+	zend_polymorphic_cache_add(CACHE_ADDR(num), (void*)(ce), (void*)(ptr))
 
 #define CACHED_PTR_EX(slot) \
 	(slot)[0]
@@ -363,13 +422,14 @@ ZEND_API int ZEND_FASTCALL zend_do_fcall_overloaded(zend_execute_data *call, zva
 		(slot)[0] = (ptr); \
 	} while (0)
 
+#define CACHED_POLYMORPHIC_FIND_EX(slot, ce) \
+	zend_polymorphic_cache_find((slot), (void*)(ce))
+
 #define CACHED_POLYMORPHIC_PTR_EX(slot, ce) \
-	(EXPECTED((slot)[0] == (ce)) ? (slot)[1] : NULL)
+	zend_polymorphic_cache_lookup((slot), (void*)(ce))
 
-#define CACHE_POLYMORPHIC_PTR_EX(slot, ce, ptr) do { \
-		(slot)[0] = (ce); \
-		(slot)[1] = (ptr); \
-	} while (0)
+#define CACHE_POLYMORPHIC_PTR_EX(slot, ce, ptr) \
+	zend_polymorphic_cache_add((slot), (void*)(ce), (void*)(ptr))
 
 #define CACHE_SPECIAL (1<<0)
 
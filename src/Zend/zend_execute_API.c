@@ -33,6 +33,7 @@
 #include "zend_generators.h"
 #include "zend_vm.h"
 #include "zend_float.h"
+#include "zend_frozen_array.h"
 #ifdef HAVE_SYS_TIME_H
 #include <sys/time.h>
 #endif
@@ -156,6 +157,7 @@ void init_executor(void) /* {{{ */
 	ZVAL_UNDEF(&EG(user_exception_handler));
 
 	EG(current_execute_data) = NULL;
+	EG(current_fiber) = NULL;
 
 	zend_stack_init(&EG(user_error_handlers_error_reporting), sizeof(int));
 	zend_stack_init(&EG(user_error_handlers), sizeof(zval));
@@ -179,6 +181,10 @@ void init_executor(void) /* {{{ */
 
 	EG(each_deprecation_thrown) = 0;
 
+	EG(megamorphic_cache) = NULL;
+	EG(megamorphic_sites) = 0;
+	EG(polymorphic_cache_stats) = NULL;
+
 	EG(persistent_constants_count) = EG(zend_constants)->nNumUsed;
 	EG(persistent_functions_count) = EG(function_table)->nNumUsed;
 	EG(persistent_classes_count)   = EG(class_table)->nNumUsed;
@@ -257,6 +263,10 @@ void shutdown_executor(void) /* {{{ */
 	zend_bool fast_shutdown = is_zend_mm() && !EG(full_tables_cleanup);
 #endif
 
+#if ZEND_POLYMORPHIC_CACHE_STATS
+	zend_polymorphic_cache_dump_stats();
+#endif
+
 	zend_try {
 		zend_llist_destroy(&CG(open_files));
 	} zend_end_try();
@@ -379,6 +389,14 @@ void shutdown_executor(void) /* {{{ */
 
 	EG(ht_iterators_used) = 0;
 
+	if (EG(megamorphic_cache)) {
+		efree(EG(megamorphic_cache));
+		EG(megamorphic_cache) = NULL;
+	}
+
+	/* nothing of this request refers to frozen arrays any more */
+	zend_frozen_arrays_deactivate();
+
 	zend_shutdown_fpu();
 }
 /* }}} */
@@ -0,0 +1,829 @@
+/*
+   +----------------------------------------------------------------------+
+   | Zend Engine                                                          |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 1998-2018 Zend Technologies Ltd. (http://www.zend.com) |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 2.00 of the Zend license,     |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.zend.com/license/2_00.txt.                                |
+   | If you did not receive a copy of the Zend license and are unable to  |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@zend.com so we can mail you a copy immediately.              |
+   +----------------------------------------------------------------------+
+*/
+
+#include "zend.h"
+#include "zend_API.h"
+#include "zend_interfaces.h"
+#include "zend_exceptions.h"
+#include "zend_closures.h"
+#include "zend_fibers.h"
+
+#if HAVE_UCONTEXT_H && !defined(ZEND_WIN32)
+# define ZEND_FIBER_UCONTEXT 1
+# include <ucontext.h>
+# include <unistd.h>
+# include <sys/mman.h>
+# if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#  define MAP_ANONYMOUS MAP_ANON
+# endif
+# ifdef MAP_STACK
+#  define ZEND_FIBER_MAP_FLAGS (MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK)
+# else
+#  define ZEND_FIBER_MAP_FLAGS (MAP_PRIVATE | MAP_ANONYMOUS)
+# endif
+
+struct _zend_fiber_context {
+	ucontext_t fiber;
+	ucontext_t caller;
+};
+#endif
+
+ZEND_API zend_class_entry *zend_ce_fiber;
+ZEND_API zend_class_entry *zend_ce_fiber_error;
+
+ZEND_API void (*zend_fiber_switch_hook)(zend_fiber *from, zend_fiber *to) = NULL;
+
+static zend_object_handlers zend_fiber_handlers;
+
+/* Class of the marker thrown into a fiber that is destroyed while suspended.
+ * It is not registered in the class table and is not Throwable, so user code
+ * can neither name nor catch it, while finally blocks still run. */
+static zend_class_entry zend_fiber_exit_ce;
+
+ZEND_API zend_bool zend_is_fiber_exit(zend_object *exception) /* {{{ */
+{
+	return exception && exception->ce == &zend_fiber_exit_ce;
+}
+/* }}} */
+
+ZEND_API zend_fiber *zend_fiber_get_current(void) /* {{{ */
+{
+	return EG(current_fiber);
+}
+/* }}} */
+
+static zend_always_inline void zend_fiber_capture_vm_state(zend_fiber_vm_state *state) /* {{{ */
+{
+	state->vm_stack = EG(vm_stack);
+	state->vm_stack_top = EG(vm_stack_top);
+	state->vm_stack_end = EG(vm_stack_end);
+	state->vm_stack_page_size = EG(vm_stack_page_size);
+	state->current_execute_data = EG(current_execute_data);
+	state->bailout = EG(bailout);
+	state->error_reporting = EG(error_reporting);
+}
+/* }}} */
+
+static zend_always_inline void zend_fiber_restore_vm_state(zend_fiber_vm_state *state) /* {{{ */
+{
+	EG(vm_stack) = state->vm_stack;
+	EG(vm_stack_top) = state->vm_stack_top;
+	EG(vm_stack_end) = state->vm_stack_end;
+	EG(vm_stack_page_size) = state->vm_stack_page_size;
+	EG(current_execute_data) = state->current_execute_data;
+	EG(bailout) = state->bailout;
+	EG(error_reporting) = state->error_reporting;
+}
+/* }}} */
+
+static void zend_fiber_release_stacks(zend_fiber *fiber) /* {{{ */
+{
+	zend_vm_stack stack = fiber->vm_state.vm_stack;
+
+	while (stack != NULL) {
+		zend_vm_stack prev = stack->prev;
+		efree(stack);
+		stack = prev;
+	}
+	fiber->vm_state.vm_stack = NULL;
+
+#ifdef ZEND_FIBER_UCONTEXT
+	if (fiber->c_stack) {
+		munmap(fiber->c_stack, fiber->c_stack_size);
+		fiber->c_stack = NULL;
+	}
+	if (fiber->context) {
+		efree(fiber->context);
+		fiber->context = NULL;
+	}
+#endif
+}
+/* }}} */
+
+#ifdef ZEND_FIBER_UCONTEXT
+static void zend_fiber_execute(void) /* {{{ */
+{
+	zend_fiber *fiber = EG(current_fiber);
+
+	zend_try {
+		fiber->fci.retval = &fiber->result;
+		zend_call_function(&fiber->fci, &fiber->fci_cache);
+	} zend_catch {
+		fiber->flags |= ZEND_FIBER_FLAG_BAILOUT;
+	} zend_end_try();
+
+	if (UNEXPECTED(EG(exception))) {
+		zend_object *exception = EG(exception);
+
+		EG(exception) = NULL;
+		if (zend_is_fiber_exit(exception)) {
+			OBJ_RELEASE(exception);
+		} else {
+			ZVAL_OBJ(&fiber->value, exception);
+			fiber->flags |= ZEND_FIBER_FLAG_TRANSFER_ERROR;
+		}
+	}
+
+	fiber->status = ZEND_FIBER_STATUS_DEAD;
+	zend_fiber_capture_vm_state(&fiber->vm_state);
+
+	/* A dead fiber is never switched to again; the resumer releases both
+	 * stacks, including the one we are still running on. */
+	swapcontext(&fiber->context->fiber, &fiber->context->caller);
+	ZEND_ASSERT(0);
+}
+/* }}} */
+#endif
+
+static zend_bool zend_fiber_init_stacks(zend_fiber *fiber) /* {{{ */
+{
+#ifdef ZEND_FIBER_UCONTEXT
+	static size_t page_size = 0;
+	zend_vm_stack page;
+	zend_fiber_context *context;
+	void *c_stack;
+
+	if (UNEXPECTED(page_size == 0)) {
+		page_size = sysconf(_SC_PAGESIZE);
+	}
+
+	/* The lowest page stays inaccessible so an overflow of the native stack
+	 * faults instead of silently corrupting neighbouring memory */
+	c_stack = mmap(NULL, ZEND_FIBER_DEFAULT_C_STACK_SIZE + page_size,
+		PROT_READ | PROT_WRITE, ZEND_FIBER_MAP_FLAGS, -1, 0);
+	if (UNEXPECTED(c_stack == MAP_FAILED)) {
+		zend_throw_error(zend_ce_fiber_error, "Could not allocate fiber stack");
+		return 0;
+	}
+	mprotect(c_stack, page_size, PROT_NONE);
+
+	context = emalloc(sizeof(zend_fiber_context));
+	if (UNEXPECTED(getcontext(&context->fiber) != 0)) {
+		efree(context);
+		munmap(c_stack, ZEND_FIBER_DEFAULT_C_STACK_SIZE + page_size);
+		zend_throw_error(zend_ce_fiber_error, "Could not create fiber context");
+		return 0;
+	}
+	fiber->context = context;
+	fiber->c_stack = c_stack;
+	fiber->c_stack_size = ZEND_FIBER_DEFAULT_C_STACK_SIZE + page_size;
+	context->fiber.uc_stack.ss_sp = (char *) c_stack + page_size;
+	context->fiber.uc_stack.ss_size = ZEND_FIBER_DEFAULT_C_STACK_SIZE;
+	context->fiber.uc_link = NULL;
+	makecontext(&context->fiber, zend_fiber_execute, 0);
+
+	page = (zend_vm_stack) emalloc(ZEND_FIBER_VM_STACK_SIZE);
+	page->top = ZEND_VM_STACK_ELEMENTS(page);
+	page->end = (zval *) ((char *) page + ZEND_FIBER_VM_STACK_SIZE);
+	page->prev = NULL;
+	page->top++;
+
+	fiber->vm_state.vm_stack = page;
+	fiber->vm_state.vm_stack_top = page->top;
+	fiber->vm_state.vm_stack_end = page->end;
+	fiber->vm_state.vm_stack_page_size = ZEND_FIBER_VM_STACK_SIZE;
+	fiber->vm_state.current_execute_data = &fiber->execute_data;
+	fiber->vm_state.bailout = NULL;
+	fiber->vm_state.error_reporting = EG(error_reporting);
+
+	return 1;
+#else
+	(void) fiber;
+	zend_throw_error(zend_ce_fiber_error, "Fibers are not supported on this platform");
+	return 0;
+#endif
+}
+/* }}} */
+
+/* Consumes the value handed over by the other side of a switch */
+static zend_always_inline void zend_fiber_receive(zend_fiber *fiber, zval *return_value) /* {{{ */
+{
+	if (UNEXPECTED(fiber->flags & ZEND_FIBER_FLAG_TRANSFER_ERROR)) {
+		fiber->flags &= ~ZEND_FIBER_FLAG_TRANSFER_ERROR;
+		zend_throw_exception_internal(&fiber->value);
+		ZVAL_NULL(&fiber->value);
+		ZVAL_NULL(return_value);
+	} else {
+		ZVAL_COPY_VALUE(return_value, &fiber->value);
+		ZVAL_NULL(&fiber->value);
+	}
+}
+/* }}} */
+
+/* Runs the fiber until it suspends or terminates. The value must already be
+ * stored in fiber->value. */
+static void zend_fiber_switch_to(zend_fiber *fiber, zval *return_value) /* {{{ */
+{
+#ifdef ZEND_FIBER_UCONTEXT
+	zend_fiber *previous = EG(current_fiber);
+	zend_fiber_vm_state state;
+
+	if (zend_fiber_switch_hook) {
+		zend_fiber_switch_hook(previous, fiber);
+	}
+
+	GC_ADDREF(&fiber->std);
+
+	zend_fiber_capture_vm_state(&state);
+	fiber->execute_data.prev_execute_data = EG(current_execute_data);
+	zend_fiber_restore_vm_state(&fiber->vm_state);
+	EG(current_fiber) = fiber;
+	fiber->status = ZEND_FIBER_STATUS_RUNNING;
+
+	swapcontext(&fiber->context->caller, &fiber->context->fiber);
+
+	EG(current_fiber) = previous;
+	zend_fiber_restore_vm_state(&state);
+
+	if (zend_fiber_switch_hook) {
+		zend_fiber_switch_hook(fiber, previous);
+	}
+
+	if (fiber->status == ZEND_FIBER_STATUS_DEAD) {
+		zend_fiber_release_stacks(fiber);
+		if (UNEXPECTED(fiber->flags & ZEND_FIBER_FLAG_BAILOUT)) {
+			zend_bailout();
+		}
+	}
+
+	zend_fiber_receive(fiber, return_value);
+	OBJ_RELEASE(&fiber->std);
+#else
+	/* Unreachable, zend_fiber_init_stacks() refuses to start a fiber */
+	(void) fiber;
+	(void) return_value;
+#endif
+}
+/* }}} */
+
+ZEND_API void zend_fiber_resume(zend_fiber *fiber, zval *value, zval *return_value) /* {{{ */
+{
+	if (fiber->status == ZEND_FIBER_STATUS_INIT) {
+		if (UNEXPECTED(Z_ISUNDEF(fiber->fci.function_name))) {
+			zend_throw_error(zend_ce_fiber_error, "Cannot start a fiber that has not been constructed");
+			return;
+		}
+		if (!zend_fiber_init_stacks(fiber)) {
+			return;
+		}
+	} else if (UNEXPECTED(fiber->status != ZEND_FIBER_STATUS_SUSPENDED)) {
+		zend_throw_error(zend_ce_fiber_error, "Cannot resume a fiber that is not suspended");
+		return;
+	}
+
+	if (value) {
+		ZVAL_COPY(&fiber->value, value);
+	} else {
+		ZVAL_NULL(&fiber->value);
+	}
+
+	zend_fiber_switch_to(fiber, return_value);
+}
+/* }}} */
+
+ZEND_API void zend_fiber_suspend(zval *value, zval *return_value) /* {{{ */
+{
+	zend_fiber *fiber = EG(current_fiber);
+
+	if (UNEXPECTED(!fiber)) {
+		zend_throw_error(zend_ce_fiber_error, "Cannot suspend outside of fiber");
+		return;
+	}
+	if (UNEXPECTED(fiber->flags & ZEND_FIBER_FLAG_DESTROYED)) {
+		zend_throw_error(zend_ce_fiber_error, "Cannot suspend in a force-closed fiber");
+		return;
+	}
+
+	ZEND_ASSERT(fiber->status == ZEND_FIBER_STATUS_RUNNING);
+
+	if (value) {
+		ZVAL_COPY(&fiber->value, value);
+	} else {
+		ZVAL_NULL(&fiber->value);
+	}
+
+#ifdef ZEND_FIBER_UCONTEXT
+	fiber->status = ZEND_FIBER_STATUS_SUSPENDED;
+	zend_fiber_capture_vm_state(&fiber->vm_state);
+
+	/* The resumer restores our executor state before switching back */
+	swapcontext(&fiber->context->fiber, &fiber->context->caller);
+#endif
+
+	zend_fiber_receive(fiber, return_value);
+}
+/* }}} */
+
+static zend_object *zend_fiber_object_create(zend_class_entry *ce) /* {{{ */
+{
+	zend_fiber *fiber;
+
+	fiber = emalloc(sizeof(zend_fiber));
+	memset(fiber, 0, sizeof(zend_fiber));
+
+	zend_object_std_init(&fiber->std, ce);
+	fiber->std.handlers = &zend_fiber_handlers;
+
+	fiber->status = ZEND_FIBER_STATUS_INIT;
+	ZEND_ADD_CALL_FLAG(&fiber->execute_data, ZEND_CALL_FIBER);
+	ZVAL_UNDEF(&fiber->fci.function_name);
+	ZVAL_NULL(&fiber->value);
+	ZVAL_UNDEF(&fiber->result);
+
+	return &fiber->std;
+}
+/* }}} */
+
+static void zend_fiber_object_destroy(zend_object *object) /* {{{ */
+{
+	zend_fiber *fiber = (zend_fiber *) object;
+	zend_object *old_exception;
+	zval retval;
+
+	if (fiber->status != ZEND_FIBER_STATUS_SUSPENDED) {
+		return;
+	}
+
+	old_exception = EG(exception);
+	EG(exception) = NULL;
+
+	/* Unwind the fiber so that finally blocks and destructors of its
+	 * variables run; an exception escaping from them is rethrown here. */
+	fiber->flags |= ZEND_FIBER_FLAG_DESTROYED | ZEND_FIBER_FLAG_TRANSFER_ERROR;
+	ZVAL_OBJ(&fiber->value, zend_objects_new(&zend_fiber_exit_ce));
+	zend_fiber_switch_to(fiber, &retval);
+	zval_ptr_dtor(&retval);
+
+	if (old_exception) {
+		if (EG(exception)) {
+			zend_exception_set_previous(EG(exception), old_exception);
+		} else {
+			EG(exception) = old_exception;
+		}
+	}
+}
+/* }}} */
+
+static void zend_fiber_object_free(zend_object *object) /* {{{ */
+{
+	zend_fiber *fiber = (zend_fiber *) object;
+
+	/* A fiber that is still suspended here was skipped by the destructor
+	 * pass after a fatal error. Its frames are not unwound; the request is
+	 * going away and the memory manager reclaims their contents. */
+	zend_fiber_release_stacks(fiber);
+
+	zval_ptr_dtor(&fiber->fci.function_name);
+	zval_ptr_dtor(&fiber->value);
+	zval_ptr_dtor(&fiber->result);
+
+	if (fiber->gc_buffer) {
+		efree(fiber->gc_buffer);
+	}
+
+	zend_object_std_dtor(&fiber->std);
+}
+/* }}} */
+
+/* Silence and rope slots do not contain zvals */
+static zend_always_inline zend_bool zend_fiber_live_range_holds_zval(const zend_live_range *range) /* {{{ */
+{
+	uint32_t kind = range->var & ZEND_LIVE_MASK;
+
+	return kind == ZEND_LIVE_TMPVAR || kind == ZEND_LIVE_LOOP;
+}
+/* }}} */
+
+static uint32_t zend_fiber_frame_gc_size(zend_execute_data *call) /* {{{ */
+{
+	uint32_t size = 0;
+
+	if (!call->func) {
+		return 0;
+	}
+	if (ZEND_USER_CODE(call->func->type)) {
+		zend_op_array *op_array = &call->func->op_array;
+
+		uint32_t op_num = call->opline - op_array->opcodes;
+		int i;
+
+		size += op_array->last_var;
+		if (ZEND_CALL_INFO(call) & ZEND_CALL_FREE_EXTRA_ARGS) {
+			size += ZEND_CALL_NUM_ARGS(call) - op_array->num_args;
+		}
+		for (i = 0; i < op_array->last_live_range; i++) {
+			const zend_live_range *range = &op_array->live_range[i];
+
+			if (range->start > op_num) {
+				break;
+			}
+			if (op_num < range->end && zend_fiber_live_range_holds_zval(range)) {
+				size++;
+			}
+		}
+	} else {
+		size += ZEND_CALL_NUM_ARGS(call);
+	}
+	if (ZEND_CALL_INFO(call) & ZEND_CALL_RELEASE_THIS) {
+		size++;
+	}
+	if (ZEND_CALL_INFO(call) & ZEND_CALL_CLOSURE) {
+		size++;
+	}
+	return size;
+}
+/* }}} */
+
+static zval *zend_fiber_frame_gc_fill(zend_execute_data *call, zval *gc_buffer) /* {{{ */
+{
+	uint32_t i;
+
+	if (!call->func) {
+		return gc_buffer;
+	}
+	if (ZEND_USER_CODE(call->func->type)) {
+		zend_op_array *op_array = &call->func->op_array;
+		uint32_t op_num = call->opline - op_array->opcodes;
+
+		/* With an attached symbol table the CVs are still authoritative, the
+		 * table only holds INDIRECT pointers to them */
+		for (i = 0; i < (uint32_t)op_array->last_var; i++) {
+			ZVAL_COPY_VALUE(gc_buffer++, ZEND_CALL_VAR_NUM(call, i));
+		}
+		if (ZEND_CALL_INFO(call) & ZEND_CALL_FREE_EXTRA_ARGS) {
+			zval *zv = ZEND_CALL_VAR_NUM(call, op_array->last_var + op_array->T);
+			zval *end = zv + (ZEND_CALL_NUM_ARGS(call) - op_array->num_args);
+
+			while (zv != end) {
+				ZVAL_COPY_VALUE(gc_buffer++, zv++);
+			}
+		}
+		/* TMP/VAR slots that are live across the call the frame is
+		 * suspended in, e.g. an operand of "$a . Fiber::suspend()" */
+		for (i = 0; i < (uint32_t)op_array->last_live_range; i++) {
+			const zend_live_range *range = &op_array->live_range[i];
+
+			if (range->start > op_num) {
+				break;
+			}
+			if (op_num < range->end && zend_fiber_live_range_holds_zval(range)) {
+				ZVAL_COPY_VALUE(gc_buffer++, ZEND_CALL_VAR(call, range->var & ~ZEND_LIVE_MASK));
+			}
+		}
+	} else {
+		zval *zv = ZEND_CALL_ARG(call, 1);
+
+		for (i = 0; i < ZEND_CALL_NUM_ARGS(call); i++) {
+			ZVAL_COPY_VALUE(gc_buffer++, zv++);
+		}
+	}
+	if (ZEND_CALL_INFO(call) & ZEND_CALL_RELEASE_THIS) {
+		ZVAL_OBJ(gc_buffer++, Z_OBJ(call->This));
+	}
+	if (ZEND_CALL_INFO(call) & ZEND_CALL_CLOSURE) {
+		ZVAL_OBJ(gc_buffer++, ZEND_CLOSURE_OBJECT(call->func));
+	}
+	return gc_buffer;
+}
+/* }}} */
+
+static HashTable *zend_fiber_object_gc(zval *object, zval **table, int *n) /* {{{ */
+{
+	zend_fiber *fiber = (zend_fiber *) Z_OBJ_P(object);
+	zend_execute_data *call;
+	zval *gc_buffer;
+	uint32_t gc_buffer_size = 3;
+
+	/* Only a suspended fiber holds on to frames; a running one is referenced
+	 * from the native stack of its resumer anyway. Generator frames are
+	 * owned and reported by their generator object. */
+	if (fiber->status == ZEND_FIBER_STATUS_SUSPENDED) {
+		for (call = fiber->vm_state.current_execute_data; call != &fiber->execute_data; call = call->prev_execute_data) {
+			if (!(ZEND_CALL_INFO(call) & ZEND_CALL_GENERATOR)) {
+				gc_buffer_size += zend_fiber_frame_gc_size(call);
+			}
+		}
+	}
+
+	if (fiber->gc_buffer_size < gc_buffer_size) {
+		fiber->gc_buffer = safe_erealloc(fiber->gc_buffer, sizeof(zval), gc_buffer_size, 0);
+		fiber->gc_buffer_size = gc_buffer_size;
+	}
+
+	*table = gc_buffer = fiber->gc_buffer;
+	*n = gc_buffer_size;
+
+	ZVAL_COPY_VALUE(gc_buffer++, &fiber->fci.function_name);
+	ZVAL_COPY_VALUE(gc_buffer++, &fiber->value);
+	ZVAL_COPY_VALUE(gc_buffer++, &fiber->result);
+
+	if (fiber->status == ZEND_FIBER_STATUS_SUSPENDED) {
+		for (call = fiber->vm_state.current_execute_data; call != &fiber->execute_data; call = call->prev_execute_data) {
+			if (!(ZEND_CALL_INFO(call) & ZEND_CALL_GENERATOR)) {
+				gc_buffer = zend_fiber_frame_gc_fill(call, gc_buffer);
+			}
+		}
+	}
+
+	return Z_OBJ_P(object)->properties;
+}
+/* }}} */
+
+/* {{{ proto Fiber::__construct(callable $callable) */
+ZEND_METHOD(Fiber, __construct)
+{
+	zend_fiber *fiber = (zend_fiber *) Z_OBJ_P(getThis());
+	zend_fcall_info fci;
+	zend_fcall_info_cache fcc;
+
+	ZEND_PARSE_PARAMETERS_START(1, 1)
+		Z_PARAM_FUNC(fci, fcc)
+	ZEND_PARSE_PARAMETERS_END();
+
+	if (UNEXPECTED(fiber->status != ZEND_FIBER_STATUS_INIT)) {
+		zend_throw_error(zend_ce_fiber_error, "Cannot call constructor of a started fiber");
+		return;
+	}
+
+	/* Trampolines are allocated per lookup; let zend_call_function() resolve
+	 * the callable again when the fiber starts instead of keeping one alive */
+	if (fcc.function_handler->common.fn_flags & ZEND_ACC_CALL_VIA_TRAMPOLINE) {
+		zend_string_release(fcc.function_handler->common.function_name);
+		zend_free_trampoline(fcc.function_handler);
+		fcc.function_handler = NULL;
+	}
+
+	zval_ptr_dtor(&fiber->fci.function_name);
+	fiber->fci = fci;
+	fiber->fci_cache = fcc;
+	Z_TRY_ADDREF(fiber->fci.function_name);
+}
+/* }}} */
+
+/* {{{ proto mixed Fiber::start(mixed ...$args)
+ * Starts the fiber; returns the value passed to the first Fiber::suspend() or
+ * null if the fiber returned */
+ZEND_METHOD(Fiber, start)
+{
+	zend_fiber *fiber = (zend_fiber *) Z_OBJ_P(getThis());
+	zval *params;
+	uint32_t param_count;
+
+	ZEND_PARSE_PARAMETERS_START(0, -1)
+		Z_PARAM_VARIADIC('*', params, param_count)
+	ZEND_PARSE_PARAMETERS_END();
+
+	if (UNEXPECTED(fiber->status != ZEND_FIBER_STATUS_INIT)) {
+		zend_throw_error(zend_ce_fiber_error, "Cannot start a fiber that has already been started");
+		return;
+	}
+
+	/* The arguments are copied to the fiber's own VM stack before the
+	 * callable runs, so pointing into our frame is fine */
+	fiber->fci.params = params;
+	fiber->fci.param_count = param_count;
+
+	zend_fiber_resume(fiber, NULL, return_value);
+
+	fiber->fci.params = NULL;
+	fiber->fci.param_count = 0;
+}
+/* }}} */
+
+/* {{{ proto mixed Fiber::resume([mixed $value])
+ * Resumes the fiber, making Fiber::suspend() return $value */
+ZEND_METHOD(Fiber, resume)
+{
+	zend_fiber *fiber = (zend_fiber *) Z_OBJ_P(getThis());
+	zval *value = NULL;
+
+	ZEND_PARSE_PARAMETERS_START(0, 1)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_ZVAL(value)
+	ZEND_PARSE_PARAMETERS_END();
+
+	if (UNEXPECTED(fiber->status != ZEND_FIBER_STATUS_SUSPENDED)) {
+		zend_throw_error(zend_ce_fiber_error, "Cannot resume a fiber that is not suspended");
+		return;
+	}
+
+	zend_fiber_resume(fiber, value, return_value);
+}
+/* }}} */
+
+/* {{{ proto mixed Fiber::throw(Throwable $exception)
+ * Resumes the fiber, making Fiber::suspend() throw $exception */
+ZEND_METHOD(Fiber, throw)
+{
+	zend_fiber *fiber = (zend_fiber *) Z_OBJ_P(getThis());
+	zval *exception;
+
+	ZEND_PARSE_PARAMETERS_START(1, 1)
+		Z_PARAM_OBJECT_OF_CLASS(exception, zend_ce_throwable)
+	ZEND_PARSE_PARAMETERS_END();
+
+	if (UNEXPECTED(fiber->status != ZEND_FIBER_STATUS_SUSPENDED)) {
+		zend_throw_error(zend_ce_fiber_error, "Cannot resume a fiber that is not suspended");
+		return;
+	}
+
+	ZVAL_COPY(&fiber->value, exception);
+	fiber->flags |= ZEND_FIBER_FLAG_TRANSFER_ERROR;
+	zend_fiber_switch_to(fiber, return_value);
+}
+/* }}} */
+
+/* {{{ proto mixed Fiber::getReturn()
+ * Returns the value returned by the callable of a terminated fiber */
+ZEND_METHOD(Fiber, getReturn)
+{
+	zend_fiber *fiber = (zend_fiber *) Z_OBJ_P(getThis());
+
+	if (zend_parse_parameters_none() == FAILURE) {
+		return;
+	}
+
+	if (UNEXPECTED(fiber->status != ZEND_FIBER_STATUS_DEAD)) {
+		zend_throw_error(zend_ce_fiber_error, fiber->status == ZEND_FIBER_STATUS_INIT
+			? "Cannot get fiber return value: The fiber has not been started"
+			: "Cannot get fiber return value: The fiber has not returned");
+		return;
+	}
+	if (UNEXPECTED(Z_ISUNDEF(fiber->result))) {
+		zend_throw_error(zend_ce_fiber_error, "Cannot get fiber return value: The fiber threw an exception");
+		return;
+	}
+
+	ZVAL_COPY(return_value, &fiber->result);
+}
+/* }}} */
+
+/* {{{ proto bool Fiber::isStarted() */
+ZEND_METHOD(Fiber, isStarted)
+{
+	zend_fiber *fiber = (zend_fiber *) Z_OBJ_P(getThis());
+
+	if (zend_parse_parameters_none() == FAILURE) {
+		return;
+	}
+
+	RETURN_BOOL(fiber->status != ZEND_FIBER_STATUS_INIT);
+}
+/* }}} */
+
+/* {{{ proto bool Fiber::isSuspended() */
+ZEND_METHOD(Fiber, isSuspended)
+{
+	zend_fiber *fiber = (zend_fiber *) Z_OBJ_P(getThis());
+
+	if (zend_parse_parameters_none() == FAILURE) {
+		return;
+	}
+
+	RETURN_BOOL(fiber->status == ZEND_FIBER_STATUS_SUSPENDED);
+}
+/* }}} */
+
+/* {{{ proto bool Fiber::isRunning() */
+ZEND_METHOD(Fiber, isRunning)
+{
+	zend_fiber *fiber = (zend_fiber *) Z_OBJ_P(getThis());
+
+	if (zend_parse_parameters_none() == FAILURE) {
+		return;
+	}
+
+	RETURN_BOOL(fiber->status == ZEND_FIBER_STATUS_RUNNING);
+}
+/* }}} */
+
+/* {{{ proto bool Fiber::isTerminated() */
+ZEND_METHOD(Fiber, isTerminated)
+{
+	zend_fiber *fiber = (zend_fiber *) Z_OBJ_P(getThis());
+
+	if (zend_parse_parameters_none() == FAILURE) {
+		return;
+	}
+
+	RETURN_BOOL(fiber->status == ZEND_FIBER_STATUS_DEAD);
+}
+/* }}} */
+
+/* {{{ proto mixed Fiber::suspend([mixed $value])
+ * Suspends the current fiber; returns the value it is resumed with */
+ZEND_METHOD(Fiber, suspend)
+{
+	zval *value = NULL;
+
+	ZEND_PARSE_PARAMETERS_START(0, 1)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_ZVAL(value)
+	ZEND_PARSE_PARAMETERS_END();
+
+	zend_fiber_suspend(value, return_value);
+}
+/* }}} */
+
+/* {{{ proto ?Fiber Fiber::getCurrent() */
+ZEND_METHOD(Fiber, getCurrent)
+{
+	zend_fiber *fiber = EG(current_fiber);
+
+	if (zend_parse_parameters_none() == FAILURE) {
+		return;
+	}
+
+	if (!fiber) {
+		RETURN_NULL();
+	}
+
+	ZVAL_OBJ(return_value, &fiber->std);
+	Z_ADDREF_P(return_value);
+}
+/* }}} */
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_fiber_construct, 0, 0, 1)
+	ZEND_ARG_CALLABLE_INFO(0, callable, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_fiber_start, 0, 0, 0)
+	ZEND_ARG_VARIADIC_INFO(0, args)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_fiber_value, 0, 0, 0)
+	ZEND_ARG_INFO(0, value)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_fiber_throw, 0, 0, 1)
+	ZEND_ARG_OBJ_INFO(0, exception, Throwable, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO(arginfo_fiber_void, 0)
+ZEND_END_ARG_INFO()
+
+static const zend_function_entry fiber_functions[] = {
+	ZEND_ME(Fiber, __construct,  arginfo_fiber_construct, ZEND_ACC_PUBLIC)
+	ZEND_ME(Fiber, start,        arginfo_fiber_start,     ZEND_ACC_PUBLIC)
+	ZEND_ME(Fiber, resume,       arginfo_fiber_value,     ZEND_ACC_PUBLIC)
+	ZEND_ME(Fiber, throw,        arginfo_fiber_throw,     ZEND_ACC_PUBLIC)
+	ZEND_ME(Fiber, getReturn,    arginfo_fiber_void,      ZEND_ACC_PUBLIC)
+	ZEND_ME(Fiber, isStarted,    arginfo_fiber_void,      ZEND_ACC_PUBLIC)
+	ZEND_ME(Fiber, isSuspended,  arginfo_fiber_void,      ZEND_ACC_PUBLIC)
+	ZEND_ME(Fiber, isRunning,    arginfo_fiber_void,      ZEND_ACC_PUBLIC)
+	ZEND_ME(Fiber, isTerminated, arginfo_fiber_void,      ZEND_ACC_PUBLIC)
+	ZEND_ME(Fiber, suspend,      arginfo_fiber_value,     ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	ZEND_ME(Fiber, getCurrent,   arginfo_fiber_void,      ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	ZEND_FE_END
+};
+
+void zend_register_fiber_ce(void) /* {{{ */
+{
+	zend_class_entry ce;
+
+	INIT_CLASS_ENTRY(ce, "Fiber", fiber_functions);
+	zend_ce_fiber = zend_register_internal_class(&ce);
+	zend_ce_fiber->ce_flags |= ZEND_ACC_FINAL;
+	zend_ce_fiber->create_object = zend_fiber_object_create;
+	zend_ce_fiber->serialize = zend_class_serialize_deny;
+	zend_ce_fiber->unserialize = zend_class_unserialize_deny;
+
+	memcpy(&zend_fiber_handlers, &std_object_handlers, sizeof(zend_object_handlers));
+	zend_fiber_handlers.free_obj = zend_fiber_object_free;
+	zend_fiber_handlers.dtor_obj = zend_fiber_object_destroy;
+	zend_fiber_handlers.get_gc = zend_fiber_object_gc;
+	zend_fiber_handlers.clone_obj = NULL;
+
+	INIT_CLASS_ENTRY(ce, "FiberError", NULL);
+	zend_ce_fiber_error = zend_register_internal_class_ex(&ce, zend_ce_error);
+	zend_ce_fiber_error->ce_flags |= ZEND_ACC_FINAL;
+
+	INIT_CLASS_ENTRY(zend_fiber_exit_ce, "FiberExit", NULL);
+	zend_fiber_exit_ce.type = ZEND_INTERNAL_CLASS;
+	zend_initialize_class_data(&zend_fiber_exit_ce, 0);
+	zend_fiber_exit_ce.ce_flags |= ZEND_ACC_FINAL | ZEND_ACC_CONSTANTS_UPDATED;
+}
+/* }}} */
+
+/*
+ * Local variables:
+ * tab-width: 4
+ * c-basic-offset: 4
+ * indent-tabs-mode: t
+ * End:
+ * vim600: sw=4 ts=4 fdm=marker
+ * vim<600: sw=4 ts=4
+ */
@@ -0,0 +1,134 @@
+/*
+   +----------------------------------------------------------------------+
+   | Zend Engine                                                          |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 1998-2018 Zend Technologies Ltd. (http://www.zend.com) |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 2.00 of the Zend license,     |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.zend.com/license/2_00.txt.                                |
+   | If you did not receive a copy of the Zend license and are unable to  |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@zend.com so we can mail you a copy immediately.              |
+   +----------------------------------------------------------------------+
+*/
+
+#ifndef ZEND_FIBERS_H
+#define ZEND_FIBERS_H
+
+BEGIN_EXTERN_C()
+
+extern ZEND_API zend_class_entry *zend_ce_fiber;
+extern ZEND_API zend_class_entry *zend_ce_fiber_error;
+
+typedef struct _zend_fiber zend_fiber;
+typedef struct _zend_fiber_vm_state zend_fiber_vm_state;
+typedef struct _zend_fiber_context zend_fiber_context;
+
+/* Size of the native stack every fiber runs on. The pages are reserved with
+ * mmap() and only become resident when touched, so the reservation is cheap. */
+#define ZEND_FIBER_DEFAULT_C_STACK_SIZE  (4096 * (((sizeof(void *)) < 8) ? 256 : 512))
+
+/* Size of the first VM stack page of a fiber, further pages are added on
+ * demand by zend_vm_stack_extend() exactly as for the main VM stack. */
+#define ZEND_FIBER_VM_STACK_SIZE         (1024 * sizeof(zval))
+
+typedef enum _zend_fiber_status {
+	ZEND_FIBER_STATUS_INIT,
+	ZEND_FIBER_STATUS_RUNNING,
+	ZEND_FIBER_STATUS_SUSPENDED,
+	ZEND_FIBER_STATUS_DEAD
+} zend_fiber_status;
+
+/* The value being transferred is an exception that has to be thrown on the
+ * other side of the switch. */
+#define ZEND_FIBER_FLAG_TRANSFER_ERROR   (1<<0)
+/* A fatal error occurred inside of the fiber; the bailout is continued by
+ * whoever resumed it. */
+#define ZEND_FIBER_FLAG_BAILOUT          (1<<1)
+/* The fiber object is destroyed while suspended and is being unwound. */
+#define ZEND_FIBER_FLAG_DESTROYED        (1<<2)
+
+/* The part of the executor globals owned by whoever is currently running.
+ * It is swapped in and out on every switch. */
+struct _zend_fiber_vm_state {
+	zend_vm_stack vm_stack;
+	zval *vm_stack_top;
+	zval *vm_stack_end;
+	size_t vm_stack_page_size;
+	zend_execute_data *current_execute_data;
+	JMP_BUF *bailout;
+	int error_reporting;
+};
+
+struct _zend_fiber {
+	zend_object std;
+
+	zend_fiber_status status;
+	uint32_t flags;
+
+	/* The callable the fiber runs */
+	zend_fcall_info fci;
+	zend_fcall_info_cache fci_cache;
+
+	/* Native context of the fiber and of whoever resumed it last, private
+	 * to zend_fibers.c */
+	zend_fiber_context *context;
+	void *c_stack;
+	size_t c_stack_size;
+
+	/* Executor state of the fiber while it is not running */
+	zend_fiber_vm_state vm_state;
+
+	/* Sentinel frame at the bottom of the fiber's VM stack. Its
+	 * prev_execute_data is pointed at the resuming frame on every switch, so
+	 * backtraces taken inside the fiber continue into the resumer. */
+	zend_execute_data execute_data;
+
+	/* Value passed by the last resume()/suspend(), or the exception to throw
+	 * when ZEND_FIBER_FLAG_TRANSFER_ERROR is set */
+	zval value;
+
+	/* Return value of the callable */
+	zval result;
+
+	zval *gc_buffer;
+	uint32_t gc_buffer_size;
+};
+
+/* Called right before switching away from "from" into "to" and again after
+ * control came back. NULL denotes the main (non-fiber) context. Schedulers
+ * and profilers can use it to track which fiber is running. */
+extern ZEND_API void (*zend_fiber_switch_hook)(zend_fiber *from, zend_fiber *to);
+
+void zend_register_fiber_ce(void);
+
+ZEND_API zend_fiber *zend_fiber_get_current(void);
+
+/* Starts or resumes a fiber, passing value into it. On return, return_value
+ * contains the value the fiber suspended with (NULL if it terminated) and
+ * EG(exception) is set if the fiber terminated with an exception. */
+ZEND_API void zend_fiber_resume(zend_fiber *fiber, zval *value, zval *return_value);
+
+/* Suspends the current fiber, handing value to the resumer. Works from any
+ * depth, including callbacks invoked by internal functions. On return,
+ * return_value contains the value the fiber was resumed with, or
+ * EG(exception) is set. */
+ZEND_API void zend_fiber_suspend(zval *value, zval *return_value);
+
+ZEND_API zend_bool zend_is_fiber_exit(zend_object *exception);
+
+END_EXTERN_C()
+
+#endif
+
+/*
+ * Local variables:
+ * tab-width: 4
+ * c-basic-offset: 4
+ * indent-tabs-mode: t
+ * End:
+ * vim600: sw=4 ts=4 fdm=marker
+ * vim<600: sw=4 ts=4
+ */
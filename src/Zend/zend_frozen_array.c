@@ -0,0 +1,393 @@
+/*
+   +----------------------------------------------------------------------+
+   | Zend Engine                                                          |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 1998-2018 Zend Technologies Ltd. (http://www.zend.com) |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 2.00 of the Zend license,     |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.zend.com/license/2_00.txt.                                |
+   | If you did not receive a copy of the Zend license and are unable to  |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@zend.com so we can mail you a copy immediately.              |
+   +----------------------------------------------------------------------+
+*/
+
+#include "zend.h"
+#include "zend_globals.h"
+#include "zend_frozen_array.h"
+
+#define ZEND_FROZEN_CHUNK_SIZE (64 * 1024)
+
+typedef struct _zend_frozen_chunk {
+	struct _zend_frozen_chunk *next;
+	size_t used;
+	size_t size;
+} zend_frozen_chunk;
+
+#define ZEND_FROZEN_CHUNK_HEADER ZEND_MM_ALIGNED_SIZE(sizeof(zend_frozen_chunk))
+
+struct _zend_frozen_array {
+	HashTable                 *ht;
+	zend_frozen_chunk         *chunks;
+	uint64_t                   retired;  /* epoch the array was replaced in */
+	struct _zend_frozen_array *next;     /* retired list */
+};
+
+/* One per thread that looked up a frozen array. Readers are never unlinked,
+ * the one of an exiting thread is taken over by the next new thread. */
+struct _zend_frozen_array_reader {
+	uint64_t                          epoch;   /* 0 outside of requests that looked something up */
+	zend_bool                         in_use;
+	struct _zend_frozen_array_reader *next;
+};
+
+/* Lookups, publishing and reclamation all happen under one lock; reading the
+ * arrays themselves doesn't need it */
+static HashTable frozen_arrays;
+static zend_frozen_array *frozen_retired = NULL;
+static zend_frozen_array_reader *frozen_readers = NULL;
+static uint64_t frozen_epoch = 1;
+
+#ifdef ZTS
+static MUTEX_T frozen_arrays_mutex = NULL;
+# define FROZEN_ARRAYS_LOCK()   tsrm_mutex_lock(frozen_arrays_mutex)
+# define FROZEN_ARRAYS_UNLOCK() tsrm_mutex_unlock(frozen_arrays_mutex)
+#else
+# define FROZEN_ARRAYS_LOCK()
+# define FROZEN_ARRAYS_UNLOCK()
+#endif
+
+/* {{{ Freezing */
+static void *zend_frozen_alloc(zend_frozen_array *frozen, size_t size)
+{
+	zend_frozen_chunk *chunk = frozen->chunks;
+	void *ptr;
+
+	size = ZEND_MM_ALIGNED_SIZE(size);
+	if (!chunk || chunk->used + size > chunk->size) {
+		size_t chunk_size = MAX(ZEND_FROZEN_CHUNK_SIZE, ZEND_FROZEN_CHUNK_HEADER + size);
+
+		chunk = pemalloc(chunk_size, 1);
+		chunk->next = frozen->chunks;
+		chunk->used = ZEND_FROZEN_CHUNK_HEADER;
+		chunk->size = chunk_size;
+		frozen->chunks = chunk;
+	}
+	ptr = (char*)chunk + chunk->used;
+	chunk->used += size;
+	return ptr;
+}
+
+static zend_string *zend_frozen_copy_string(zend_frozen_array *frozen, zend_string *str)
+{
+	zend_string *copy;
+
+	if (ZSTR_IS_INTERNED(str) && (GC_FLAGS(str) & IS_STR_PERMANENT)) {
+		return str;
+	}
+	/* readers in other threads must never have to store the hash value */
+	zend_string_hash_val(str);
+	copy = zend_frozen_alloc(frozen, _ZSTR_STRUCT_SIZE(ZSTR_LEN(str)));
+	memcpy(copy, str, _ZSTR_STRUCT_SIZE(ZSTR_LEN(str)));
+	GC_SET_REFCOUNT(copy, 1);
+	/* interned: nothing refcounts it or frees it on its own */
+	GC_TYPE_INFO(copy) = IS_STRING | ((IS_STR_INTERNED | IS_STR_PERSISTENT) << GC_FLAGS_SHIFT);
+	return copy;
+}
+
+static HashTable *zend_frozen_copy_array(zend_frozen_array *frozen, HashTable *source)
+{
+	HashTable *ht;
+	Bucket *p, *end;
+	zend_bool protect = !(GC_FLAGS(source) & GC_IMMUTABLE);
+
+	if (zend_hash_num_elements(source) == 0) {
+		return (HashTable*)&zend_empty_array;
+	}
+	if (protect) {
+		if (GC_IS_RECURSIVE(source)) {
+			return NULL;
+		}
+		GC_PROTECT_RECURSION(source);
+	}
+
+	ht = zend_frozen_alloc(frozen, sizeof(HashTable));
+	memcpy(ht, source, sizeof(HashTable));
+	GC_SET_REFCOUNT(ht, 2);
+	GC_TYPE_INFO(ht) = IS_ARRAY | (IS_ARRAY_IMMUTABLE << GC_FLAGS_SHIFT);
+	HT_FLAGS(ht) = (HT_FLAGS(source) & (HASH_FLAG_INITIALIZED|HASH_FLAG_PACKED)) | HASH_FLAG_STATIC_KEYS;
+	ht->pDestructor = ZVAL_PTR_DTOR;
+	if (ht->nInternalPointer >= ht->nNumUsed) {
+		ht->nInternalPointer = 0;
+	}
+	HT_SET_DATA_ADDR(ht, zend_frozen_alloc(frozen, HT_USED_SIZE(source)));
+	memcpy(HT_GET_DATA_ADDR(ht), HT_GET_DATA_ADDR(source), HT_USED_SIZE(source));
+
+	p = ht->arData;
+	end = p + ht->nNumUsed;
+	for (; p != end; p++) {
+		zval *data = &p->val;
+
+		if (Z_TYPE_P(data) == IS_UNDEF) {
+			/* a hole, its key is gone */
+			p->key = NULL;
+			continue;
+		}
+		ZVAL_DEREF(data);
+		if (p->key) {
+			zend_string *key = zend_interned_string_share(p->key);
+
+			/* once the shared tier is full, keys live in the region */
+			p->key = key ? key : zend_frozen_copy_string(frozen, p->key);
+		}
+		switch (Z_TYPE_P(data)) {
+			case IS_STRING:
+				ZVAL_INTERNED_STR(&p->val, zend_frozen_copy_string(frozen, Z_STR_P(data)));
+				break;
+			case IS_ARRAY: {
+				HashTable *nested = zend_frozen_copy_array(frozen, Z_ARRVAL_P(data));
+
+				if (!nested) {
+					ht = NULL;
+					goto exit;
+				}
+				Z_ARR(p->val) = nested;
+				Z_TYPE_INFO(p->val) = IS_ARRAY;
+				break;
+			}
+			case IS_UNDEF:      /* through a reference */
+			case IS_INDIRECT:   /* symbol tables */
+			case IS_OBJECT:
+			case IS_RESOURCE:
+			case IS_CONSTANT_AST:
+				ht = NULL;
+				goto exit;
+			default:
+				ZVAL_COPY_VALUE(&p->val, data);
+				break;
+		}
+	}
+
+exit:
+	if (protect) {
+		GC_UNPROTECT_RECURSION(source);
+	}
+	return ht;
+}
+
+ZEND_API zend_frozen_array *zend_array_freeze(HashTable *ht)
+{
+	zend_frozen_array *frozen = pemalloc(sizeof(zend_frozen_array), 1);
+
+	frozen->chunks = NULL;
+	frozen->retired = 0;
+	frozen->next = NULL;
+	frozen->ht = zend_frozen_copy_array(frozen, ht);
+	if (!frozen->ht) {
+		zend_frozen_array_free(frozen);
+		return NULL;
+	}
+	return frozen;
+}
+
+ZEND_API HashTable *zend_frozen_array_ht(zend_frozen_array *frozen)
+{
+	return frozen->ht;
+}
+
+ZEND_API void zend_frozen_array_free(zend_frozen_array *frozen)
+{
+	zend_frozen_chunk *chunk = frozen->chunks;
+
+	while (chunk) {
+		zend_frozen_chunk *next = chunk->next;
+
+		pefree(chunk, 1);
+		chunk = next;
+	}
+	pefree(frozen, 1);
+}
+/* }}} */
+
+/* {{{ Publishing and reclamation */
+static void zend_frozen_array_dtor(zval *zv)
+{
+	if (Z_PTR_P(zv)) {
+		zend_frozen_array_free((zend_frozen_array*)Z_PTR_P(zv));
+	}
+}
+
+/* Must be called with the lock held */
+static void zend_frozen_arrays_reclaim(void)
+{
+	zend_frozen_array_reader *reader;
+	zend_frozen_array **prev, *frozen;
+	uint64_t oldest = (uint64_t)-1;
+
+	for (reader = frozen_readers; reader; reader = reader->next) {
+		if (reader->epoch && reader->epoch < oldest) {
+			oldest = reader->epoch;
+		}
+	}
+
+	prev = &frozen_retired;
+	while ((frozen = *prev) != NULL) {
+		/* requests that pinned an epoch >= retired found the replacement */
+		if (frozen->retired <= oldest) {
+			*prev = frozen->next;
+			zend_frozen_array_free(frozen);
+		} else {
+			prev = &frozen->next;
+		}
+	}
+}
+
+ZEND_API void zend_frozen_array_publish(zend_string *name, zend_frozen_array *frozen)
+{
+	zend_frozen_array *old = NULL;
+	zval *zv;
+
+	FROZEN_ARRAYS_LOCK();
+	zv = zend_hash_find(&frozen_arrays, name);
+	if (zv) {
+		old = (zend_frozen_array*)Z_PTR_P(zv);
+		Z_PTR_P(zv) = frozen;
+		if (!frozen) {
+			zend_hash_del(&frozen_arrays, name);
+		}
+		old->retired = ++frozen_epoch;
+		old->next = frozen_retired;
+		frozen_retired = old;
+		zend_frozen_arrays_reclaim();
+	} else if (frozen) {
+		zend_string *key = zend_string_init(ZSTR_VAL(name), ZSTR_LEN(name), 1);
+
+		zend_hash_add_new_ptr(&frozen_arrays, key, frozen);
+		zend_string_release(key);
+	}
+	FROZEN_ARRAYS_UNLOCK();
+}
+
+ZEND_API HashTable *zend_frozen_array_find(zend_string *name)
+{
+	zend_frozen_array *frozen;
+	zend_frozen_array_reader *reader;
+
+	FROZEN_ARRAYS_LOCK();
+	frozen = zend_hash_find_ptr(&frozen_arrays, name);
+	if (frozen) {
+		reader = EG(frozen_array_reader);
+		if (!reader) {
+			for (reader = frozen_readers; reader; reader = reader->next) {
+				if (!reader->in_use) {
+					break;
+				}
+			}
+			if (!reader) {
+				reader = pemalloc(sizeof(zend_frozen_array_reader), 1);
+				reader->next = frozen_readers;
+				frozen_readers = reader;
+			}
+			reader->epoch = 0;
+			reader->in_use = 1;
+			EG(frozen_array_reader) = reader;
+		}
+		if (!reader->epoch) {
+			reader->epoch = frozen_epoch;
+		}
+	}
+	FROZEN_ARRAYS_UNLOCK();
+
+	return frozen ? frozen->ht : NULL;
+}
+
+ZEND_API uint32_t zend_frozen_arrays_retired(void)
+{
+	zend_frozen_array *frozen;
+	uint32_t count = 0;
+
+	FROZEN_ARRAYS_LOCK();
+	for (frozen = frozen_retired; frozen; frozen = frozen->next) {
+		count++;
+	}
+	FROZEN_ARRAYS_UNLOCK();
+
+	return count;
+}
+
+/* Called at the end of every request, after the last zval is gone */
+void zend_frozen_arrays_deactivate(void)
+{
+	zend_frozen_array_reader *reader = EG(frozen_array_reader);
+
+	if (reader && reader->epoch) {
+		FROZEN_ARRAYS_LOCK();
+		reader->epoch = 0;
+		zend_frozen_arrays_reclaim();
+		FROZEN_ARRAYS_UNLOCK();
+	}
+}
+
+void zend_frozen_arrays_release_reader(zend_frozen_array_reader *reader)
+{
+#ifdef ZTS
+	/* Threads whose globals outlive zend_shutdown() had their reader freed there */
+	if (!frozen_arrays_mutex) {
+		return;
+	}
+#endif
+	if (reader) {
+		FROZEN_ARRAYS_LOCK();
+		reader->epoch = 0;
+		reader->in_use = 0;
+		FROZEN_ARRAYS_UNLOCK();
+	}
+}
+/* }}} */
+
+void zend_frozen_arrays_startup(void)
+{
+	zend_hash_init(&frozen_arrays, 8, NULL, zend_frozen_array_dtor, 1);
+#ifdef ZTS
+	frozen_arrays_mutex = tsrm_mutex_alloc();
+#endif
+}
+
+void zend_frozen_arrays_shutdown(void)
+{
+	zend_frozen_array_reader *reader = frozen_readers;
+
+	zend_hash_destroy(&frozen_arrays);
+	while (frozen_retired) {
+		zend_frozen_array *next = frozen_retired->next;
+
+		zend_frozen_array_free(frozen_retired);
+		frozen_retired = next;
+	}
+	while (reader) {
+		zend_frozen_array_reader *next = reader->next;
+
+		pefree(reader, 1);
+		reader = next;
+	}
+	frozen_readers = NULL;
+	/* In NTS the executor globals outlive this, so don't leave them
+	 * pointing at a freed reader if the engine starts up again. */
+	EG(frozen_array_reader) = NULL;
+#ifdef ZTS
+	tsrm_mutex_free(frozen_arrays_mutex);
+	frozen_arrays_mutex = NULL;
+#endif
+}
+
+/*
+ * Local variables:
+ * tab-width: 4
+ * c-basic-offset: 4
+ * indent-tabs-mode: t
+ * End:
+ * vim600: sw=4 ts=4 fdm=marker
+ * vim<600: sw=4 ts=4
+ */
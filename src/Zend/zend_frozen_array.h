@@ -0,0 +1,68 @@
+/*
+   +----------------------------------------------------------------------+
+   | Zend Engine                                                          |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 1998-2018 Zend Technologies Ltd. (http://www.zend.com) |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 2.00 of the Zend license,     |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.zend.com/license/2_00.txt.                                |
+   | If you did not receive a copy of the Zend license and are unable to  |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@zend.com so we can mail you a copy immediately.              |
+   +----------------------------------------------------------------------+
+*/
+
+#ifndef ZEND_FROZEN_ARRAY_H
+#define ZEND_FROZEN_ARRAY_H
+
+/* A frozen array is an immutable copy of a request array graph in persistent
+ * memory. Keys are interned in the shared tier of interned strings, or copied
+ * like the values when that tier is full (see ZEND_INTERNED_STRINGS_SHARED_MAX);
+ * string values and nested arrays are copied into the region of the frozen
+ * array.
+ * Nothing in it is refcounted, so any thread can read it in place; writes
+ * separate a request copy as for any other immutable array.
+ *
+ * Frozen arrays are published under a name. Replacing one retires the old
+ * copy, which is freed once no request that may have looked it up is running
+ * any more: a lookup pins the current epoch for the rest of the request, and
+ * retired copies are only freed when all pinned epochs are past the one they
+ * were retired in. */
+
+typedef struct _zend_frozen_array zend_frozen_array;
+typedef struct _zend_frozen_array_reader zend_frozen_array_reader;
+
+BEGIN_EXTERN_C()
+
+void zend_frozen_arrays_startup(void);
+void zend_frozen_arrays_shutdown(void);
+void zend_frozen_arrays_deactivate(void);
+void zend_frozen_arrays_release_reader(zend_frozen_array_reader *reader);
+
+/* Returns NULL if the graph holds objects, resources or a recursion */
+ZEND_API zend_frozen_array *zend_array_freeze(HashTable *ht);
+ZEND_API HashTable *zend_frozen_array_ht(zend_frozen_array *frozen);
+/* Only for frozen arrays that were never published */
+ZEND_API void zend_frozen_array_free(zend_frozen_array *frozen);
+
+/* Takes over frozen; NULL removes the name */
+ZEND_API void zend_frozen_array_publish(zend_string *name, zend_frozen_array *frozen);
+/* The array stays valid until the end of the request */
+ZEND_API HashTable *zend_frozen_array_find(zend_string *name);
+ZEND_API uint32_t zend_frozen_arrays_retired(void);
+
+END_EXTERN_C()
+
+#endif /* ZEND_FROZEN_ARRAY_H */
+
+/*
+ * Local variables:
+ * tab-width: 4
+ * c-basic-offset: 4
+ * indent-tabs-mode: t
+ * End:
+ * vim600: sw=4 ts=4 fdm=marker
+ * vim<600: sw=4 ts=4
+ */
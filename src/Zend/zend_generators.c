@@ -276,14 +276,8 @@ static uint32_t calc_gc_buffer_size(zend_generator *generator) /* {{{ */
 		size += Z_TYPE(execute_data->This) == IS_OBJECT; /* $this */
 		size += (EX_CALL_INFO() & ZEND_CALL_CLOSURE) != 0; /* Closure object */
 
-		/* Yield from root references */
-		if (generator->node.children == 0) {
-			zend_generator *root = generator->node.ptr.root;
-			while (root != generator) {
-				root = zend_generator_get_child(&root->node, generator);
-				size++;
-			}
-		}
+		/* Yield from root references are counted while zend_generator_get_gc()
+		 * adds them, so the path to the root is only walked once */
 	}
 	return size;
 }
@@ -312,8 +306,7 @@ static HashTable *zend_generator_get_gc(zval *object, zval **table, int *n) /* {
 		generator->gc_buffer_size = gc_buffer_size;
 	}
 
-	*n = gc_buffer_size;
-	*table = gc_buffer = generator->gc_buffer;
+	gc_buffer = generator->gc_buffer;
 
 	ZVAL_COPY_VALUE(gc_buffer++, &generator->value);
 	ZVAL_COPY_VALUE(gc_buffer++, &generator->key);
@@ -345,11 +338,20 @@ static HashTable *zend_generator_get_gc(zval *object, zval **table, int *n) /* {
 	if (generator->node.children == 0) {
 		zend_generator *root = generator->node.ptr.root;
 		while (root != generator) {
+			if (UNEXPECTED(gc_buffer == generator->gc_buffer + generator->gc_buffer_size)) {
+				gc_buffer_size = generator->gc_buffer_size * 2;
+				generator->gc_buffer = safe_erealloc(generator->gc_buffer, sizeof(zval), gc_buffer_size, 0);
+				gc_buffer = generator->gc_buffer + generator->gc_buffer_size;
+				generator->gc_buffer_size = gc_buffer_size;
+			}
 			ZVAL_OBJ(gc_buffer++, &root->std);
 			root = zend_generator_get_child(&root->node, generator);
 		}
 	}
 
+	*table = generator->gc_buffer;
+	*n = gc_buffer - generator->gc_buffer;
+
 	if (EX_CALL_INFO() & ZEND_CALL_HAS_SYMBOL_TABLE) {
 		return execute_data->symbol_table;
 	} else {
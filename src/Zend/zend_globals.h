@@ -109,6 +109,11 @@ struct _zend_compiler_globals {
 	zend_arena *arena;
 
 	HashTable interned_strings;
+	zend_ulong interned_strings_hits;
+	zend_ulong interned_strings_shared_hits;
+	zend_ulong interned_strings_misses;
+	zend_bool publish_interned_strings;
+	zend_long compile_threads;
 
 	const zend_encoding **script_encoding_list;
 	size_t script_encoding_list_size;
@@ -156,6 +161,7 @@ struct _zend_executor_globals {
 	size_t         vm_stack_page_size;
 
 	struct _zend_execute_data *current_execute_data;
+	struct _zend_fiber *current_fiber;
 	zend_class_entry *fake_scope; /* used to avoid checks accessing properties */
 
 	zend_long precision;
@@ -230,6 +236,13 @@ struct _zend_executor_globals {
 
 	zend_bool each_deprecation_thrown;
 
+	struct _zend_megamorphic_cache_entry *megamorphic_cache;
+	uintptr_t                             megamorphic_sites;
+	struct _zend_polymorphic_cache_stats *polymorphic_cache_stats;
+
+	/* survives requests, see zend_frozen_array.c */
+	struct _zend_frozen_array_reader *frozen_array_reader;
+
 	void *reserved[ZEND_MAX_RESERVED_RESOURCES];
 };
 
@@ -273,6 +286,7 @@ struct _zend_php_scanner_globals {
 	unsigned char *yy_marker;
 	unsigned char *yy_limit;
 	int yy_state;
+	struct _zend_lex_stream *yy_stream;
 	zend_stack state_stack;
 	zend_ptr_stack heredoc_label_stack;
 	zend_bool heredoc_scan_ahead;
@@ -325,6 +325,33 @@ ZEND_API void ZEND_FASTCALL zend_hash_extend(HashTable *ht, uint32_t nSize, zend
 	}
 }
 
+ZEND_API void ZEND_FASTCALL zend_hash_bulk_start(HashTable *ht, uint32_t nSize, zend_bool packed)
+{
+	HT_ASSERT_RC1(ht);
+	if (UNEXPECTED(!(HT_FLAGS(ht) & HASH_FLAG_INITIALIZED))) {
+		if (nSize > ht->nTableSize) {
+			ht->nTableSize = zend_hash_check_size(nSize);
+		}
+		zend_hash_real_init_ex(ht, packed);
+		return;
+	}
+	/* appends to a packed table must land on the bucket of their index */
+	if ((HT_FLAGS(ht) & HASH_FLAG_PACKED)
+	 && (!packed || (zend_ulong)ht->nNextFreeElement != ht->nNumUsed)) {
+		zend_hash_packed_to_hash(ht);
+	}
+	if (nSize > ht->nTableSize - ht->nNumUsed) {
+		zend_hash_extend(ht, ht->nNumUsed + nSize, HT_FLAGS(ht) & HASH_FLAG_PACKED);
+	}
+}
+
+ZEND_API void ZEND_FASTCALL zend_hash_bulk_end(HashTable *ht)
+{
+	if (!(HT_FLAGS(ht) & HASH_FLAG_PACKED)) {
+		zend_hash_rehash(ht);
+	}
+}
+
 ZEND_API void ZEND_FASTCALL zend_hash_discard(HashTable *ht, uint32_t nNumUsed)
 {
 	Bucket *p, *end, *arData;
@@ -2636,8 +2663,19 @@ ZEND_API int ZEND_FASTCALL _zend_handle_numeric_str_ex(const char *key, size_t l
 		return 0;
 	}
 	*idx = (*tmp - '0');
+	++tmp;
+#ifdef ZEND_SWAR_DIGITS
+	while (end - tmp >= 8) {
+		uint64_t chunk = zend_load_8_bytes(tmp);
+
+		if (!zend_is_8_digits(chunk)) {
+			return 0;
+		}
+		*idx = (*idx * 100000000) + zend_parse_8_digits(chunk);
+		tmp += 8;
+	}
+#endif
 	while (1) {
-		++tmp;
 		if (tmp == end) {
 			if (*key == '-') {
 				if (*idx-1 > ZEND_LONG_MAX) { /* overflow */
@@ -2654,6 +2692,7 @@ ZEND_API int ZEND_FASTCALL _zend_handle_numeric_str_ex(const char *key, size_t l
 		} else {
 			return 0;
 		}
+		++tmp;
 	}
 }
 
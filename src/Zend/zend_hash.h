@@ -103,6 +103,8 @@ ZEND_API void ZEND_FASTCALL zend_hash_packed_to_hash(HashTable *ht);
 ZEND_API void ZEND_FASTCALL zend_hash_to_packed(HashTable *ht);
 ZEND_API void ZEND_FASTCALL zend_hash_extend(HashTable *ht, uint32_t nSize, zend_bool packed);
 ZEND_API void ZEND_FASTCALL zend_hash_discard(HashTable *ht, uint32_t nNumUsed);
+ZEND_API void ZEND_FASTCALL zend_hash_bulk_start(HashTable *ht, uint32_t nSize, zend_bool packed);
+ZEND_API void ZEND_FASTCALL zend_hash_bulk_end(HashTable *ht);
 
 /* additions/updates/changes */
 ZEND_API zval* ZEND_FASTCALL zend_hash_add_or_update(HashTable *ht, zend_string *key, zval *pData, uint32_t flag);
@@ -195,6 +197,79 @@ static zend_always_inline zval *zend_hash_find_ex(const HashTable *ht, zend_stri
 		} \
 	} while (0)
 
+/* Appends to a packed array that has room for it without going through
+ * zend_hash_next_index_insert(), everything else takes the slow path */
+static zend_always_inline zval *zend_hash_next_index_insert_fast(HashTable *ht, zval *pData)
+{
+	uint32_t idx = ht->nNumUsed;
+
+	if (EXPECTED(HT_FLAGS(ht) & HASH_FLAG_PACKED)
+	 && EXPECTED(idx < ht->nTableSize)
+	 && EXPECTED((zend_ulong)ht->nNextFreeElement == idx)) {
+		Bucket *p = ht->arData + idx;
+
+		ht->nNumUsed = idx + 1;
+		ht->nNextFreeElement = idx + 1;
+		ht->nNumOfElements++;
+		p->h = idx;
+		p->key = NULL;
+		ZVAL_COPY_VALUE(&p->val, pData);
+		return &p->val;
+	}
+	return zend_hash_next_index_insert(ht, pData);
+}
+
+/* Bulk insertion. zend_hash_bulk_start() makes room for the elements to come,
+ * the appends below neither grow the table nor look for duplicates, and
+ * zend_hash_bulk_end() links all of them into the hash at once. Keys must be
+ * distinct and string keys must not be numeric (see ZEND_HANDLE_NUMERIC). The
+ * table must not be read or modified otherwise in between. */
+static zend_always_inline zval *zend_hash_bulk_append(HashTable *ht, zval *pData)
+{
+	uint32_t idx = ht->nNumUsed++;
+	Bucket *p = ht->arData + idx;
+
+	ZEND_ASSERT(idx < ht->nTableSize);
+	p->h = ht->nNextFreeElement++;
+	p->key = NULL;
+	ZVAL_COPY_VALUE(&p->val, pData);
+	ht->nNumOfElements++;
+	return &p->val;
+}
+
+static zend_always_inline zval *zend_hash_bulk_index_add(HashTable *ht, zend_ulong h, zval *pData)
+{
+	uint32_t idx = ht->nNumUsed++;
+	Bucket *p = ht->arData + idx;
+
+	ZEND_ASSERT(idx < ht->nTableSize && !(HT_FLAGS(ht) & HASH_FLAG_PACKED));
+	if ((zend_long)h >= (zend_long)ht->nNextFreeElement) {
+		ht->nNextFreeElement = h < ZEND_LONG_MAX ? h + 1 : ZEND_LONG_MAX;
+	}
+	p->h = h;
+	p->key = NULL;
+	ZVAL_COPY_VALUE(&p->val, pData);
+	ht->nNumOfElements++;
+	return &p->val;
+}
+
+static zend_always_inline zval *zend_hash_bulk_add(HashTable *ht, zend_string *key, zval *pData)
+{
+	uint32_t idx = ht->nNumUsed++;
+	Bucket *p = ht->arData + idx;
+
+	ZEND_ASSERT(idx < ht->nTableSize && !(HT_FLAGS(ht) & HASH_FLAG_PACKED));
+	if (!ZSTR_IS_INTERNED(key)) {
+		HT_FLAGS(ht) &= ~HASH_FLAG_STATIC_KEYS;
+		zend_string_addref(key);
+	}
+	p->h = zend_string_hash_val(key);
+	p->key = key;
+	ZVAL_COPY_VALUE(&p->val, pData);
+	ht->nNumOfElements++;
+	return &p->val;
+}
+
 
 /* Misc */
 ZEND_API zend_bool ZEND_FASTCALL zend_hash_exists(const HashTable *ht, zend_string *key);
@@ -206,6 +206,13 @@ static int zend_do_perform_type_hint_check(const zend_function *fe, zend_arg_inf
 		size_t class_name_len;
 
 		fe_class_name = ZEND_TYPE_NAME(fe_arg_info->type);
+		if (fe_class_name == ZEND_TYPE_NAME(proto_arg_info->type)
+		 && ZSTR_LEN(fe_class_name) != sizeof("self")-1
+		 && ZSTR_LEN(fe_class_name) != sizeof("parent")-1) {
+			/* the same interned name, which is neither relative to fe nor to proto */
+			return 1;
+		}
+
 		class_name = ZSTR_VAL(fe_class_name);
 		class_name_len = ZSTR_LEN(fe_class_name);
 		if (class_name_len == sizeof("parent")-1 && !strcasecmp(class_name, "parent") && proto->common.scope) {
@@ -731,10 +738,69 @@ static inline void do_implement_interface(zend_class_entry *ce, zend_class_entry
 }
 /* }}} */
 
+static void zend_interface_set_insert(zend_class_entry *ce, zend_class_entry *iface) /* {{{ */
+{
+	uint32_t h = ZEND_INTERFACE_SET_HASH(iface) & ce->interface_set_mask;
+
+	while (ce->interface_set[h]) {
+		if (ce->interface_set[h] == iface) {
+			return;
+		}
+		h = (h + 1) & ce->interface_set_mask;
+	}
+	ce->interface_set[h] = iface;
+}
+/* }}} */
+
+static zend_always_inline zend_bool zend_interface_set_has(const zend_class_entry *ce, const zend_class_entry *iface) /* {{{ */
+{
+	uint32_t h;
+
+	if (!ce->interface_set) {
+		return 0;
+	}
+	h = ZEND_INTERFACE_SET_HASH(iface) & ce->interface_set_mask;
+	while (ce->interface_set[h]) {
+		if (ce->interface_set[h] == iface) {
+			return 1;
+		}
+		h = (h + 1) & ce->interface_set_mask;
+	}
+	return 0;
+}
+/* }}} */
+
+/* Expects iface to be appended to ce's interface list already */
+static void zend_interface_set_add(zend_class_entry *ce, zend_class_entry *iface) /* {{{ */
+{
+	if (!ce->interface_set || ce->num_interfaces * 2 > ce->interface_set_mask + 1) {
+		zend_bool persistent = ce->type == ZEND_INTERNAL_CLASS;
+		uint32_t i, size = 8;
+
+		/* keep it at most half full */
+		while (size < ce->num_interfaces * 2) {
+			size <<= 1;
+		}
+		if (ce->interface_set) {
+			pefree(ce->interface_set, persistent);
+		}
+		ce->interface_set = pecalloc(size, sizeof(zend_class_entry*), persistent);
+		ce->interface_set_mask = size - 1;
+		for (i = 0; i < ce->num_interfaces; i++) {
+			if (ce->interfaces[i]) {
+				zend_interface_set_insert(ce, ce->interfaces[i]);
+			}
+		}
+	} else {
+		zend_interface_set_insert(ce, iface);
+	}
+}
+/* }}} */
+
 ZEND_API void zend_do_inherit_interfaces(zend_class_entry *ce, const zend_class_entry *iface) /* {{{ */
 {
 	/* expects interface to be contained in ce's interface list already */
-	uint32_t i, ce_num, if_num = iface->num_interfaces;
+	uint32_t ce_num, if_num = iface->num_interfaces;
 	zend_class_entry *entry;
 
 	if (if_num==0) {
@@ -751,13 +817,9 @@ ZEND_API void zend_do_inherit_interfaces(zend_class_entry *ce, const zend_class_
 	/* Inherit the interfaces, only if they're not already inherited by the class */
 	while (if_num--) {
 		entry = iface->interfaces[if_num];
-		for (i = 0; i < ce_num; i++) {
-			if (ce->interfaces[i] == entry) {
-				break;
-			}
-		}
-		if (i == ce_num) {
+		if (!zend_interface_set_has(ce, entry)) {
 			ce->interfaces[ce->num_interfaces++] = entry;
+			zend_interface_set_add(ce, entry);
 		}
 	}
 
@@ -820,6 +882,13 @@ ZEND_API void zend_do_inheritance(zend_class_entry *ce, zend_class_entry *parent
 
 	ce->parent = parent_ce;
 
+	/* Inherit the ancestor display */
+	ce->depth = parent_ce->depth + 1;
+	memcpy(ce->display, parent_ce->display, sizeof(ce->display));
+	if (ce->depth < ZEND_CLASS_DISPLAY_SIZE) {
+		ce->display[ce->depth] = ce;
+	}
+
 	/* Inherit interfaces */
 	zend_do_inherit_interfaces(ce, parent_ce);
 
@@ -1065,6 +1134,7 @@ ZEND_API void zend_do_implement_interface(zend_class_entry *ce, zend_class_entry
 			}
 		}
 		ce->interfaces[ce->num_interfaces++] = iface;
+		zend_interface_set_add(ce, iface);
 
 		ZEND_HASH_FOREACH_STR_KEY_PTR(&iface->constants_table, key, c) {
 			do_inherit_iface_constant(key, c, ce, iface);
@@ -20,6 +20,22 @@
 #ifndef ZEND_SCANNER_H
 #define ZEND_SCANNER_H
 
+/* Window onto a script that is scanned while it is being read, see
+ * zend_stream_fixup_chunked(). Only the current token onwards is kept, so it
+ * only grows beyond ZEND_LEX_STREAM_CHUNK_SIZE for larger tokens. */
+typedef struct _zend_lex_stream {
+	zend_file_handle *in;
+	unsigned char *buf;
+	size_t size;
+	/* number of bytes of the script preceding buf */
+	size_t offset;
+	/* position in the script that must be kept while scanning ahead */
+	size_t pin;
+	zend_bool eof;
+} zend_lex_stream;
+
+#define ZEND_LEX_STREAM_CHUNK_SIZE (64 * 1024)
+
 typedef struct _zend_lex_state {
 	unsigned int yy_leng;
 	unsigned char *yy_start;
@@ -32,6 +48,7 @@ typedef struct _zend_lex_state {
 	zend_ptr_stack heredoc_label_stack;
 
 	zend_file_handle *in;
+	zend_lex_stream *stream;
 	uint32_t lineno;
 	zend_string *filename;
 
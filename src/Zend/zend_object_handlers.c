@@ -365,7 +365,7 @@ static zend_always_inline uintptr_t zend_get_property_offset(zend_class_entry *c
 	uint32_t flags;
 	zend_class_entry *scope;
 
-	if (cache_slot && EXPECTED(ce == CACHED_PTR_EX(cache_slot))) {
+	if (cache_slot && EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, ce))) {
 		return (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 	}
 
@@ -552,47 +552,106 @@ ZEND_API int zend_check_property_access(zend_object *zobj, zend_string *prop_inf
 /* }}} */
 
 static void zend_property_guard_dtor(zval *el) /* {{{ */ {
-	uint32_t *ptr = (uint32_t*)Z_PTR_P(el);
-	if (EXPECTED(!(((zend_uintptr_t)ptr) & 1))) {
-		efree_size(ptr, sizeof(uint32_t));
+	efree_size(Z_PTR_P(el), sizeof(uint32_t));
+}
+/* }}} */
+
+static zend_always_inline zend_bool zend_property_guard_name_equals(zend_string *str, zend_string *member) /* {{{ */
+{
+	return EXPECTED(str == member) ||
+		/* hash values are always pred-calculated here */
+		(EXPECTED(ZSTR_H(str) == ZSTR_H(member)) &&
+		 EXPECTED(zend_string_equal_content(str, member)));
+}
+/* }}} */
+
+ZEND_API void zend_property_guards_free(zend_property_guards *guards) /* {{{ */
+{
+	uint32_t i;
+
+	zend_string_release(guards->first);
+	for (i = 0; i < ZEND_PROPERTY_GUARDS_INLINE && guards->names[i]; i++) {
+		zend_string_release(guards->names[i]);
 	}
+	if (guards->overflow) {
+		zend_hash_destroy(guards->overflow);
+		FREE_HASHTABLE(guards->overflow);
+	}
+	efree_size(guards, sizeof(zend_property_guards));
 }
 /* }}} */
 
 ZEND_API uint32_t *zend_get_property_guard(zend_object *zobj, zend_string *member) /* {{{ */
 {
-	HashTable *guards;
+	zend_property_guards *guards;
 	zval *zv;
-	uint32_t *ptr;
+	uint32_t *ptr, *free_guard;
+	uint32_t i;
 
 	ZEND_ASSERT(zobj->ce->ce_flags & ZEND_ACC_USE_GUARDS);
 	zv = zobj->properties_table + zobj->ce->default_properties_count;
 	if (EXPECTED(Z_TYPE_P(zv) == IS_STRING)) {
 		zend_string *str = Z_STR_P(zv);
-		if (EXPECTED(str == member) ||
-		     /* hash values are always pred-calculated here */
-		    (EXPECTED(ZSTR_H(str) == ZSTR_H(member)) &&
-		     EXPECTED(zend_string_equal_content(str, member)))) {
+		if (zend_property_guard_name_equals(str, member)) {
 			return &Z_PROPERTY_GUARD_P(zv);
 		} else if (EXPECTED(Z_PROPERTY_GUARD_P(zv) == 0)) {
 			zval_ptr_dtor_str(zv);
 			ZVAL_STR_COPY(zv, member);
 			return &Z_PROPERTY_GUARD_P(zv);
-		} else {
-			ALLOC_HASHTABLE(guards);
-			zend_hash_init(guards, 8, NULL, zend_property_guard_dtor, 0);
-			/* mark pointer as "special" using low bit */
-			zend_hash_add_new_ptr(guards, str,
-				(void*)(((zend_uintptr_t)&Z_PROPERTY_GUARD_P(zv)) | 1));
-			zval_ptr_dtor_str(zv);
-			ZVAL_ARR(zv, guards);
 		}
-	} else if (EXPECTED(Z_TYPE_P(zv) == IS_ARRAY)) {
-		guards = Z_ARRVAL_P(zv);
-		ZEND_ASSERT(guards != NULL);
-		zv = zend_hash_find(guards, member);
-		if (zv != NULL) {
-			return (uint32_t*)(((zend_uintptr_t)Z_PTR_P(zv)) & ~1);
+		/* the guard of the first property stays in the zval */
+		guards = emalloc(sizeof(zend_property_guards));
+		guards->first = str;
+		guards->overflow = NULL;
+		memset(guards->names, 0, sizeof(guards->names));
+		guards->names[0] = zend_string_copy(member);
+		guards->guards[0] = 0;
+		ZVAL_PTR(zv, guards);
+		return &guards->guards[0];
+	} else if (EXPECTED(Z_TYPE_P(zv) == IS_PTR)) {
+		guards = (zend_property_guards*)Z_PTR_P(zv);
+		if (zend_property_guard_name_equals(guards->first, member)) {
+			return &Z_PROPERTY_GUARD_P(zv);
+		}
+		free_guard = NULL;
+		if (Z_PROPERTY_GUARD_P(zv) == 0) {
+			free_guard = &Z_PROPERTY_GUARD_P(zv);
+		}
+		for (i = 0; i < ZEND_PROPERTY_GUARDS_INLINE; i++) {
+			if (!guards->names[i]) {
+				if (!free_guard) {
+					guards->names[i] = zend_string_copy(member);
+					guards->guards[i] = 0;
+					return &guards->guards[i];
+				}
+				break;
+			} else if (zend_property_guard_name_equals(guards->names[i], member)) {
+				return &guards->guards[i];
+			} else if (!free_guard && guards->guards[i] == 0) {
+				free_guard = &guards->guards[i];
+			}
+		}
+		if (UNEXPECTED(guards->overflow)) {
+			ptr = (uint32_t*)zend_hash_find_ptr(guards->overflow, member);
+			if (ptr != NULL) {
+				return ptr;
+			}
+		}
+		if (EXPECTED(free_guard)) {
+			/* nothing runs for the old name, give its guard to this one */
+			if (free_guard == &Z_PROPERTY_GUARD_P(zv)) {
+				zend_string_release(guards->first);
+				guards->first = zend_string_copy(member);
+			} else {
+				i = (uint32_t)(free_guard - guards->guards);
+				zend_string_release(guards->names[i]);
+				guards->names[i] = zend_string_copy(member);
+			}
+			return free_guard;
+		}
+		if (!guards->overflow) {
+			ALLOC_HASHTABLE(guards->overflow);
+			zend_hash_init(guards->overflow, 8, NULL, zend_property_guard_dtor, 0);
 		}
 	} else {
 		ZEND_ASSERT(Z_TYPE_P(zv) == IS_UNDEF);
@@ -603,7 +662,7 @@ ZEND_API uint32_t *zend_get_property_guard(zend_object *zobj, zend_string *membe
 	/* we have to allocate uint32_t separately because ht->arData may be reallocated */
 	ptr = (uint32_t*)emalloc(sizeof(uint32_t));
 	*ptr = 0;
-	return (uint32_t*)zend_hash_add_new_ptr(guards, member, ptr);
+	return (uint32_t*)zend_hash_add_new_ptr(guards->overflow, member, ptr);
 }
 /* }}} */
 
@@ -207,7 +207,20 @@ ZEND_API int zend_check_property_access(zend_object *zobj, zend_string *prop_inf
 
 ZEND_API zend_function *zend_get_call_trampoline_func(zend_class_entry *ce, zend_string *method_name, int is_static);
 
+/* Guards of objects that run magic accessors on more than one property at a
+ * time. The guard of the first property stays in the u2 of the trailing zval,
+ * a few more live inline and only deeper nesting falls back to a hash. */
+#define ZEND_PROPERTY_GUARDS_INLINE 6
+
+typedef struct _zend_property_guards {
+	zend_string *first;
+	HashTable   *overflow;
+	zend_string *names[ZEND_PROPERTY_GUARDS_INLINE];
+	uint32_t     guards[ZEND_PROPERTY_GUARDS_INLINE];
+} zend_property_guards;
+
 ZEND_API uint32_t *zend_get_property_guard(zend_object *zobj, zend_string *member);
+ZEND_API void zend_property_guards_free(zend_property_guards *guards);
 
 #define zend_free_trampoline(func) do { \
 		if ((func) == &EG(trampoline)) { \
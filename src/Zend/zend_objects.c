@@ -59,13 +59,8 @@ ZEND_API void zend_object_std_dtor(zend_object *object)
 	if (UNEXPECTED(object->ce->ce_flags & ZEND_ACC_USE_GUARDS)) {
 		if (EXPECTED(Z_TYPE_P(p) == IS_STRING)) {
 			zval_ptr_dtor_str(p);
-		} else if (Z_TYPE_P(p) == IS_ARRAY) {
-			HashTable *guards;
-
-			guards = Z_ARRVAL_P(p);
-			ZEND_ASSERT(guards != NULL);
-			zend_hash_destroy(guards);
-			FREE_HASHTABLE(guards);
+		} else if (Z_TYPE_P(p) == IS_PTR) {
+			zend_property_guards_free((zend_property_guards*)Z_PTR_P(p));
 		}
 	}
 }
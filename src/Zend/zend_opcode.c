@@ -261,6 +261,9 @@ ZEND_API void destroy_zend_class(zval *zv)
 			if (ce->num_interfaces > 0 && ce->interfaces) {
 				efree(ce->interfaces);
 			}
+			if (ce->interface_set) {
+				efree(ce->interface_set);
+			}
 			if (ce->info.user.doc_comment) {
 				zend_string_release_ex(ce->info.user.doc_comment, 0);
 			}
@@ -322,6 +325,9 @@ ZEND_API void destroy_zend_class(zval *zv)
 			if (ce->num_interfaces > 0) {
 				free(ce->interfaces);
 			}
+			if (ce->interface_set) {
+				free(ce->interface_set);
+			}
 			free(ce);
 			break;
 	}
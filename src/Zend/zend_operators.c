@@ -29,6 +29,15 @@
 #include "zend_strtod.h"
 #include "zend_exceptions.h"
 #include "zend_closures.h"
+#include "zend_bitset.h"
+#include "zend_cpuinfo.h"
+
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+#if ZEND_INTRIN_AVX2_NATIVE || ZEND_INTRIN_AVX2_RESOLVER
+# include <immintrin.h>
+#endif
 
 #if ZEND_USE_TOLOWER_L
 #include <locale.h>
@@ -78,6 +87,210 @@ static const unsigned char tolower_map[256] = {
 		zend_binary_strncasecmp
  */
 
+/* The ASCII case conversions, case insensitive comparisons and substring
+ * searches work on 16 bytes at a time with SSE2. When the compiler can emit
+ * AVX2 code, a variant for 32 bytes at a time is compiled as well; unless
+ * AVX2 is targeted by the whole build, it is only used when
+ * zend_cpu_supports() reports AVX2 at startup. */
+#if ZEND_INTRIN_AVX2_NATIVE
+# define ZEND_STRING_AVX2 1
+# define ZEND_AVX2_FUNC
+# define zend_string_use_avx2 1
+#elif ZEND_INTRIN_AVX2_RESOLVER
+# define ZEND_STRING_AVX2 1
+# ifdef HAVE_FUNC_ATTRIBUTE_TARGET
+#  define ZEND_AVX2_FUNC __attribute__((target("avx2")))
+# else
+#  define ZEND_AVX2_FUNC
+# endif
+static zend_bool zend_string_use_avx2 = 0;
+#endif
+
+void zend_startup_string_functions(void) /* {{{ */
+{
+#if ZEND_INTRIN_AVX2_RESOLVER
+	zend_string_use_avx2 = zend_cpu_supports_avx2() != 0;
+#endif
+}
+/* }}} */
+
+/* Index of the highest bit of a non zero mask */
+static zend_always_inline int zend_mask_last_bit(uint32_t mask) /* {{{ */
+{
+#if PHP_HAVE_BUILTIN_CLZ
+	return 31 - __builtin_clz(mask);
+#else
+	int n = 31;
+
+	while (!(mask & 0x80000000)) {
+		mask <<= 1;
+		n--;
+	}
+	return n;
+#endif
+}
+/* }}} */
+
+#ifdef __SSE2__
+/* 'A'..'Z' are moved to the lowest signed byte values, so that a single signed
+ * compare selects the upper case letters and nothing else */
+static zend_always_inline __m128i zend_sse2_upper_mask(__m128i in) /* {{{ */
+{
+	return _mm_cmplt_epi8(_mm_add_epi8(in, _mm_set1_epi8(128 - 'A')), _mm_set1_epi8(-128 + 26));
+}
+/* }}} */
+
+static zend_always_inline __m128i zend_sse2_tolower(__m128i in) /* {{{ */
+{
+	return _mm_add_epi8(in, _mm_and_si128(zend_sse2_upper_mask(in), _mm_set1_epi8('a' - 'A')));
+}
+/* }}} */
+#endif
+
+#ifdef ZEND_STRING_AVX2
+static zend_always_inline ZEND_AVX2_FUNC __m256i zend_avx2_upper_mask(__m256i in) /* {{{ */
+{
+	return _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 26), _mm256_add_epi8(in, _mm256_set1_epi8(128 - 'A')));
+}
+/* }}} */
+
+static zend_always_inline ZEND_AVX2_FUNC __m256i zend_avx2_tolower(__m256i in) /* {{{ */
+{
+	return _mm256_add_epi8(in, _mm256_and_si256(zend_avx2_upper_mask(in), _mm256_set1_epi8('a' - 'A')));
+}
+/* }}} */
+
+/* The AVX2 loops only handle whole blocks of 32 bytes and return how far they
+ * got, the SSE2 and scalar code finishes the rest */
+static ZEND_AVX2_FUNC size_t zend_str_tolower_avx2(unsigned char *dest, const unsigned char *source, size_t length) /* {{{ */
+{
+	size_t i;
+
+	for (i = 0; i + 32 <= length; i += 32) {
+		__m256i block = _mm256_loadu_si256((const __m256i *)(source + i));
+
+		_mm256_storeu_si256((__m256i *)(dest + i), zend_avx2_tolower(block));
+	}
+	return i;
+}
+/* }}} */
+
+static ZEND_AVX2_FUNC size_t zend_str_find_upper_avx2(const unsigned char *str, size_t length) /* {{{ */
+{
+	size_t i;
+
+	for (i = 0; i + 32 <= length; i += 32) {
+		__m256i block = _mm256_loadu_si256((const __m256i *)(str + i));
+		uint32_t mask = (uint32_t)_mm256_movemask_epi8(zend_avx2_upper_mask(block));
+
+		if (mask) {
+			return i + zend_ulong_ntz(mask);
+		}
+	}
+	return i;
+}
+/* }}} */
+
+static ZEND_AVX2_FUNC size_t zend_strcasecmp_skip_avx2(const unsigned char *s1, const unsigned char *s2, size_t length) /* {{{ */
+{
+	size_t i;
+
+	for (i = 0; i + 32 <= length; i += 32) {
+		__m256i b1 = zend_avx2_tolower(_mm256_loadu_si256((const __m256i *)(s1 + i)));
+		__m256i b2 = zend_avx2_tolower(_mm256_loadu_si256((const __m256i *)(s2 + i)));
+
+		if ((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(b1, b2)) != 0xffffffff) {
+			break;
+		}
+	}
+	return i;
+}
+/* }}} */
+#endif
+
+/* Lower cases length bytes of source into dest, which may be the same buffer */
+static zend_always_inline void zend_str_tolower_impl(unsigned char *dest, const unsigned char *source, size_t length) /* {{{ */
+{
+	const unsigned char *end = source + length;
+
+#ifdef ZEND_STRING_AVX2
+	if (zend_string_use_avx2 && length >= 32) {
+		size_t done = zend_str_tolower_avx2(dest, source, length);
+
+		source += done;
+		dest += done;
+	}
+#endif
+#ifdef __SSE2__
+	while (end - source >= 16) {
+		__m128i block = _mm_loadu_si128((const __m128i *)source);
+
+		_mm_storeu_si128((__m128i *)dest, zend_sse2_tolower(block));
+		source += 16;
+		dest += 16;
+	}
+#endif
+	while (source < end) {
+		*dest++ = zend_tolower_ascii(*source++);
+	}
+}
+/* }}} */
+
+/* Returns the first upper case ASCII letter of str, or end if there is none */
+static zend_always_inline const unsigned char *zend_str_find_upper(const unsigned char *str, const unsigned char *end) /* {{{ */
+{
+#ifdef ZEND_STRING_AVX2
+	if (zend_string_use_avx2 && end - str >= 32) {
+		str += zend_str_find_upper_avx2(str, end - str);
+	}
+#endif
+#ifdef __SSE2__
+	while (end - str >= 16) {
+		uint32_t mask = (uint32_t)_mm_movemask_epi8(zend_sse2_upper_mask(_mm_loadu_si128((const __m128i *)str)));
+
+		if (mask) {
+			return str + zend_ulong_ntz(mask);
+		}
+		str += 16;
+	}
+#endif
+	while (str < end) {
+		if (*str != zend_tolower_ascii(*str)) {
+			return str;
+		}
+		str++;
+	}
+	return end;
+}
+/* }}} */
+
+/* Returns the length of a prefix of s1 and s2 that is equal ignoring ASCII
+ * case. The prefix is not necessarily the longest one, the caller compares
+ * the rest byte by byte. */
+static zend_always_inline size_t zend_strcasecmp_skip(const unsigned char *s1, const unsigned char *s2, size_t length) /* {{{ */
+{
+	size_t i = 0;
+
+#ifdef ZEND_STRING_AVX2
+	if (zend_string_use_avx2 && length >= 32) {
+		i = zend_strcasecmp_skip_avx2(s1, s2, length);
+	}
+#endif
+#ifdef __SSE2__
+	while (length - i >= 16) {
+		__m128i b1 = zend_sse2_tolower(_mm_loadu_si128((const __m128i *)(s1 + i)));
+		__m128i b2 = zend_sse2_tolower(_mm_loadu_si128((const __m128i *)(s2 + i)));
+
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(b1, b2)) != 0xffff) {
+			break;
+		}
+		i += 16;
+	}
+#endif
+	return i;
+}
+/* }}} */
+
 ZEND_API int ZEND_FASTCALL zend_atoi(const char *str, size_t str_len) /* {{{ */
 {
 	int retval;
@@ -2274,59 +2487,51 @@ ZEND_API int ZEND_FASTCALL is_smaller_or_equal_function(zval *result, zval *op1,
 }
 /* }}} */
 
-static zend_bool ZEND_FASTCALL instanceof_interface_only(const zend_class_entry *instance_ce, const zend_class_entry *ce) /* {{{ */
+static zend_always_inline zend_bool instanceof_class(const zend_class_entry *instance_ce, const zend_class_entry *ce) /* {{{ */
 {
-	uint32_t i;
+	uint32_t depth = ce->depth;
 
-	for (i = 0; i < instance_ce->num_interfaces; i++) {
-		if (instanceof_interface_only(instance_ce->interfaces[i], ce)) {
-			return 1;
-		}
+	if (EXPECTED(depth < ZEND_CLASS_DISPLAY_SIZE)) {
+		return instance_ce->display[depth] == ce;
 	}
-	return 0;
-}
-/* }}} */
-
-static zend_always_inline zend_bool instanceof_class(const zend_class_entry *instance_ce, const zend_class_entry *ce) /* {{{ */
-{
-	while (instance_ce) {
-		if (instance_ce == ce) {
-			return 1;
-		}
+	if (instance_ce->depth < depth) {
+		return 0;
+	}
+	for (depth = instance_ce->depth - depth; depth; depth--) {
 		instance_ce = instance_ce->parent;
 	}
-	return 0;
+	return instance_ce == ce;
 }
 /* }}} */
 
-static zend_bool ZEND_FASTCALL instanceof_interface(const zend_class_entry *instance_ce, const zend_class_entry *ce) /* {{{ */
+static zend_always_inline zend_bool instanceof_interface(const zend_class_entry *instance_ce, const zend_class_entry *ce) /* {{{ */
 {
-	uint32_t i;
+	zend_class_entry **set = instance_ce->interface_set;
+	uint32_t h;
 
-	for (i = 0; i < instance_ce->num_interfaces; i++) {
-		if (instanceof_interface(instance_ce->interfaces[i], ce)) {
+	if (instance_ce == ce) {
+		return 1;
+	}
+	if (!set) {
+		return 0;
+	}
+	h = ZEND_INTERFACE_SET_HASH(ce) & instance_ce->interface_set_mask;
+	while (set[h]) {
+		if (set[h] == ce) {
 			return 1;
 		}
+		h = (h + 1) & instance_ce->interface_set_mask;
 	}
-	return instanceof_class(instance_ce, ce);
+	return 0;
 }
 /* }}} */
 
 ZEND_API zend_bool ZEND_FASTCALL instanceof_function_ex(const zend_class_entry *instance_ce, const zend_class_entry *ce, zend_bool interfaces_only) /* {{{ */
 {
-	if (ce->ce_flags & ZEND_ACC_INTERFACE) {
-		if (!interfaces_only) {
-			if (instanceof_interface_only(instance_ce, ce)) {
-				return 1;
-			}
-		} else {
-			return instanceof_interface(instance_ce, ce);
-		}
+	if (interfaces_only) {
+		return (ce->ce_flags & ZEND_ACC_INTERFACE) && instanceof_interface(instance_ce, ce);
 	}
-	if (!interfaces_only) {
-		return instanceof_class(instance_ce, ce);
-	}
-	return 0;
+	return instanceof_class(instance_ce, ce);
 }
 /* }}} */
 
@@ -2608,14 +2813,8 @@ ZEND_API void zend_update_current_locale(void) /* {{{ */
 
 ZEND_API char* ZEND_FASTCALL zend_str_tolower_copy(char *dest, const char *source, size_t length) /* {{{ */
 {
-	register unsigned char *str = (unsigned char*)source;
-	register unsigned char *result = (unsigned char*)dest;
-	register unsigned char *end = str + length;
-
-	while (str < end) {
-		*result++ = zend_tolower_ascii(*str++);
-	}
-	*result = '\0';
+	zend_str_tolower_impl((unsigned char*)dest, (const unsigned char*)source, length);
+	dest[length] = '\0';
 
 	return dest;
 }
@@ -2629,69 +2828,49 @@ ZEND_API char* ZEND_FASTCALL zend_str_tolower_dup(const char *source, size_t len
 
 ZEND_API void ZEND_FASTCALL zend_str_tolower(char *str, size_t length) /* {{{ */
 {
-	register unsigned char *p = (unsigned char*)str;
-	register unsigned char *end = p + length;
-
-	while (p < end) {
-		*p = zend_tolower_ascii(*p);
-		p++;
-	}
+	zend_str_tolower_impl((unsigned char*)str, (const unsigned char*)str, length);
 }
 /* }}} */
 
 ZEND_API char* ZEND_FASTCALL zend_str_tolower_dup_ex(const char *source, size_t length) /* {{{ */
 {
-	register const unsigned char *p = (const unsigned char*)source;
-	register const unsigned char *end = p + length;
+	const unsigned char *end = (const unsigned char*)source + length;
+	const unsigned char *p = zend_str_find_upper((const unsigned char*)source, end);
+	size_t prefix;
+	char *res;
 
-	while (p < end) {
-		if (*p != zend_tolower_ascii(*p)) {
-			char *res = (char*)emalloc(length + 1);
-			register unsigned char *r;
+	if (p == end) {
+		return NULL;
+	}
 
-			if (p != (const unsigned char*)source) {
-				memcpy(res, source, p - (const unsigned char*)source);
-			}
-			r = (unsigned char*)p + (res - source);
-			while (p < end) {
-				*r = zend_tolower_ascii(*p);
-				p++;
-				r++;
-			}
-			*r = '\0';
-			return res;
-		}
-		p++;
+	res = (char*)emalloc(length + 1);
+	prefix = p - (const unsigned char*)source;
+	if (prefix) {
+		memcpy(res, source, prefix);
 	}
-	return NULL;
+	zend_str_tolower_copy(res + prefix, (const char*)p, length - prefix);
+	return res;
 }
 /* }}} */
 
 ZEND_API zend_string* ZEND_FASTCALL zend_string_tolower_ex(zend_string *str, int persistent) /* {{{ */
 {
-	register unsigned char *p = (unsigned char*)ZSTR_VAL(str);
-	register unsigned char *end = p + ZSTR_LEN(str);
+	const unsigned char *end = (const unsigned char*)ZSTR_VAL(str) + ZSTR_LEN(str);
+	const unsigned char *p = zend_str_find_upper((const unsigned char*)ZSTR_VAL(str), end);
+	zend_string *res;
+	size_t prefix;
 
-	while (p < end) {
-		if (*p != zend_tolower_ascii(*p)) {
-			zend_string *res = zend_string_alloc(ZSTR_LEN(str), persistent);
-			register unsigned char *r;
+	if (p == end) {
+		return zend_string_copy(str);
+	}
 
-			if (p != (unsigned char*)ZSTR_VAL(str)) {
-				memcpy(ZSTR_VAL(res), ZSTR_VAL(str), p - (unsigned char*)ZSTR_VAL(str));
-			}
-			r = p + (ZSTR_VAL(res) - ZSTR_VAL(str));
-			while (p < end) {
-				*r = zend_tolower_ascii(*p);
-				p++;
-				r++;
-			}
-			*r = '\0';
-			return res;
-		}
-		p++;
+	res = zend_string_alloc(ZSTR_LEN(str), persistent);
+	prefix = p - (const unsigned char*)ZSTR_VAL(str);
+	if (prefix) {
+		memcpy(ZSTR_VAL(res), ZSTR_VAL(str), prefix);
 	}
-	return zend_string_copy(str);
+	zend_str_tolower_copy(ZSTR_VAL(res) + prefix, (const char*)p, ZSTR_LEN(str) - prefix);
+	return res;
 }
 /* }}} */
 
@@ -2730,6 +2909,7 @@ ZEND_API int ZEND_FASTCALL zend_binary_strncmp(const char *s1, size_t len1, cons
 ZEND_API int ZEND_FASTCALL zend_binary_strcasecmp(const char *s1, size_t len1, const char *s2, size_t len2) /* {{{ */
 {
 	size_t len;
+	size_t skip;
 	int c1, c2;
 
 	if (s1 == s2) {
@@ -2737,6 +2917,10 @@ ZEND_API int ZEND_FASTCALL zend_binary_strcasecmp(const char *s1, size_t len1, c
 	}
 
 	len = MIN(len1, len2);
+	skip = zend_strcasecmp_skip((const unsigned char *)s1, (const unsigned char *)s2, len);
+	s1 += skip;
+	s2 += skip;
+	len -= skip;
 	while (len--) {
 		c1 = zend_tolower_ascii(*(unsigned char *)s1++);
 		c2 = zend_tolower_ascii(*(unsigned char *)s2++);
@@ -2752,12 +2936,17 @@ ZEND_API int ZEND_FASTCALL zend_binary_strcasecmp(const char *s1, size_t len1, c
 ZEND_API int ZEND_FASTCALL zend_binary_strncasecmp(const char *s1, size_t len1, const char *s2, size_t len2, size_t length) /* {{{ */
 {
 	size_t len;
+	size_t skip;
 	int c1, c2;
 
 	if (s1 == s2) {
 		return 0;
 	}
 	len = MIN(length, MIN(len1, len2));
+	skip = zend_strcasecmp_skip((const unsigned char *)s1, (const unsigned char *)s2, len);
+	s1 += skip;
+	s2 += skip;
+	len -= skip;
 	while (len--) {
 		c1 = zend_tolower_ascii(*(unsigned char *)s1++);
 		c2 = zend_tolower_ascii(*(unsigned char *)s2++);
@@ -2982,6 +3171,19 @@ ZEND_API void ZEND_FASTCALL zend_locale_sprintf_double(zval *op ZEND_FILE_LINE_D
 }
 /* }}} */
 
+ZEND_API const char zend_digit_pairs[200] = {
+	'0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+	'1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+	'2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+	'3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+	'4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+	'5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+	'6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+	'7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+	'8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+	'9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9'
+};
+
 ZEND_API zend_string* ZEND_FASTCALL zend_long_to_str(zend_long num) /* {{{ */
 {
 	if ((zend_ulong)num <= 9) {
@@ -3037,6 +3239,20 @@ ZEND_API zend_uchar ZEND_FASTCALL _is_numeric_string_ex(const char *str, size_t
 			ptr++;
 		}
 
+#ifdef ZEND_SWAR_DIGITS
+		/* Blocks of eight digits, as long as the value can not overflow */
+		while (digits + 8 <= MAX_LENGTH_OF_LONG - 2 && str + length - ptr >= 8) {
+			uint64_t chunk = zend_load_8_bytes(ptr);
+
+			if (!zend_is_8_digits(chunk)) {
+				break;
+			}
+			tmp_lval = tmp_lval * 100000000 + zend_parse_8_digits(chunk);
+			digits += 8;
+			ptr += 8;
+		}
+#endif
+
 		/* Count the number of digits. If a decimal point/exponent is found,
 		 * it's a double. Otherwise, if there's a dval or no need to check for
 		 * a full match, stop when there are too many digits for a long */
@@ -3152,8 +3368,125 @@ static zend_always_inline void zend_memnstr_ex_pre(unsigned int td[], const char
 }
 /* }}} */
 
+/*
+ * String matching - SIMD filter
+ * The first and the last byte of the needle are compared against 16 (or 32)
+ * consecutive candidate positions at once; only the positions where both
+ * match are compared in full.
+ * http://0x80.pl/articles/simd-strfind.html
+ */
+#ifdef ZEND_STRING_AVX2
+static ZEND_AVX2_FUNC const char *zend_memnstr_avx2(const char **pos, const char *needle, size_t needle_len, const char *last) /* {{{ */
+{
+	const char *p = *pos;
+	__m256i first = _mm256_set1_epi8(needle[0]);
+	__m256i final = _mm256_set1_epi8(needle[needle_len - 1]);
+
+	while (last - p >= 31) {
+		__m256i b1 = _mm256_loadu_si256((const __m256i *)p);
+		__m256i b2 = _mm256_loadu_si256((const __m256i *)(p + needle_len - 1));
+		uint32_t mask = (uint32_t)_mm256_movemask_epi8(
+			_mm256_and_si256(_mm256_cmpeq_epi8(b1, first), _mm256_cmpeq_epi8(b2, final)));
+
+		while (mask) {
+			int bit = zend_ulong_ntz(mask);
+
+			if (memcmp(p + bit + 1, needle + 1, needle_len - 2) == 0) {
+				return p + bit;
+			}
+			mask &= mask - 1;
+		}
+		p += 32;
+	}
+	*pos = p;
+	return NULL;
+}
+/* }}} */
+
+static ZEND_AVX2_FUNC const char *zend_memnrstr_avx2(size_t *count, const char *haystack, const char *needle, size_t needle_len) /* {{{ */
+{
+	size_t n = *count;
+	__m256i first = _mm256_set1_epi8(needle[0]);
+	__m256i final = _mm256_set1_epi8(needle[needle_len - 1]);
+
+	while (n >= 32) {
+		const char *p = haystack + n - 32;
+		__m256i b1 = _mm256_loadu_si256((const __m256i *)p);
+		__m256i b2 = _mm256_loadu_si256((const __m256i *)(p + needle_len - 1));
+		uint32_t mask = (uint32_t)_mm256_movemask_epi8(
+			_mm256_and_si256(_mm256_cmpeq_epi8(b1, first), _mm256_cmpeq_epi8(b2, final)));
+
+		while (mask) {
+			int bit = zend_mask_last_bit(mask);
+
+			if (memcmp(p + bit + 1, needle + 1, needle_len - 2) == 0) {
+				return p + bit;
+			}
+			mask &= ~(1U << bit);
+		}
+		n -= 32;
+	}
+	*count = n;
+	return NULL;
+}
+/* }}} */
+#endif
+
 ZEND_API const char* ZEND_FASTCALL zend_memnstr_ex(const char *haystack, const char *needle, size_t needle_len, const char *end) /* {{{ */
 {
+#ifdef __SSE2__
+	const char *p = haystack;
+	const char *last;
+	__m128i first, final;
+
+	if (needle_len == 0 || (end - haystack) < needle_len) {
+		return NULL;
+	}
+	if (needle_len == 1) {
+		return (const char *)memchr(haystack, *needle, end - haystack);
+	}
+
+	/* last candidate position */
+	last = end - needle_len;
+
+# ifdef ZEND_STRING_AVX2
+	if (zend_string_use_avx2 && last - p >= 31) {
+		const char *found = zend_memnstr_avx2(&p, needle, needle_len, last);
+
+		if (found) {
+			return found;
+		}
+	}
+# endif
+
+	first = _mm_set1_epi8(needle[0]);
+	final = _mm_set1_epi8(needle[needle_len - 1]);
+	while (last - p >= 15) {
+		__m128i b1 = _mm_loadu_si128((const __m128i *)p);
+		__m128i b2 = _mm_loadu_si128((const __m128i *)(p + needle_len - 1));
+		uint32_t mask = (uint32_t)_mm_movemask_epi8(
+			_mm_and_si128(_mm_cmpeq_epi8(b1, first), _mm_cmpeq_epi8(b2, final)));
+
+		while (mask) {
+			int bit = zend_ulong_ntz(mask);
+
+			if (memcmp(p + bit + 1, needle + 1, needle_len - 2) == 0) {
+				return p + bit;
+			}
+			mask &= mask - 1;
+		}
+		p += 16;
+	}
+
+	while (p <= last) {
+		if (*p == needle[0] && memcmp(p + 1, needle + 1, needle_len - 1) == 0) {
+			return p;
+		}
+		p++;
+	}
+
+	return NULL;
+#else
 	unsigned int td[256];
 	register size_t i;
 	register const char *p;
@@ -3183,11 +3516,67 @@ ZEND_API const char* ZEND_FASTCALL zend_memnstr_ex(const char *haystack, const c
 	}
 
 	return NULL;
+#endif
 }
 /* }}} */
 
 ZEND_API const char* ZEND_FASTCALL zend_memnrstr_ex(const char *haystack, const char *needle, size_t needle_len, const char *end) /* {{{ */
 {
+#ifdef __SSE2__
+	size_t n;
+	__m128i first, final;
+
+	if (needle_len == 0 || (end - haystack) < needle_len) {
+		return NULL;
+	}
+	if (needle_len == 1) {
+		return (const char *)zend_memrchr(haystack, *needle, end - haystack);
+	}
+
+	/* number of candidate positions not searched yet, they are walked
+	 * from the end */
+	n = (end - haystack) - needle_len + 1;
+
+# ifdef ZEND_STRING_AVX2
+	if (zend_string_use_avx2 && n >= 32) {
+		const char *found = zend_memnrstr_avx2(&n, haystack, needle, needle_len);
+
+		if (found) {
+			return found;
+		}
+	}
+# endif
+
+	first = _mm_set1_epi8(needle[0]);
+	final = _mm_set1_epi8(needle[needle_len - 1]);
+	while (n >= 16) {
+		const char *p = haystack + n - 16;
+		__m128i b1 = _mm_loadu_si128((const __m128i *)p);
+		__m128i b2 = _mm_loadu_si128((const __m128i *)(p + needle_len - 1));
+		uint32_t mask = (uint32_t)_mm_movemask_epi8(
+			_mm_and_si128(_mm_cmpeq_epi8(b1, first), _mm_cmpeq_epi8(b2, final)));
+
+		while (mask) {
+			int bit = zend_mask_last_bit(mask);
+
+			if (memcmp(p + bit + 1, needle + 1, needle_len - 2) == 0) {
+				return p + bit;
+			}
+			mask &= ~(1U << bit);
+		}
+		n -= 16;
+	}
+
+	while (n > 0) {
+		const char *p = haystack + --n;
+
+		if (*p == needle[0] && memcmp(p + 1, needle + 1, needle_len - 1) == 0) {
+			return p;
+		}
+	}
+
+	return NULL;
+#else
 	unsigned int td[256];
 	register size_t i;
 	register const char *p;
@@ -3220,6 +3609,7 @@ ZEND_API const char* ZEND_FASTCALL zend_memnrstr_ex(const char *haystack, const
 	}
 
 	return NULL;
+#endif
 }
 /* }}} */
 
@@ -133,6 +133,36 @@ static zend_always_inline zend_long zend_dval_to_lval_cap(double d)
 #define ZEND_IS_DIGIT(c) ((c) >= '0' && (c) <= '9')
 #define ZEND_IS_XDIGIT(c) (((c) >= 'A' && (c) <= 'F') || ((c) >= 'a' && (c) <= 'f'))
 
+/* Eight ASCII digits are checked and converted at once, as one 64 bit word
+ * (SWAR). The byte at the lowest address must be the least significant one. */
+#ifndef WORDS_BIGENDIAN
+# define ZEND_SWAR_DIGITS 1
+
+static zend_always_inline uint64_t zend_load_8_bytes(const char *str)
+{
+	uint64_t chunk;
+
+	memcpy(&chunk, str, sizeof(chunk));
+	return chunk;
+}
+
+static zend_always_inline int zend_is_8_digits(uint64_t chunk)
+{
+	/* every byte must be 0x3X, and still be 0x3X after adding 6 */
+	return ((chunk & UINT64_C(0xf0f0f0f0f0f0f0f0))
+		| (((chunk + UINT64_C(0x0606060606060606)) & UINT64_C(0xf0f0f0f0f0f0f0f0)) >> 4))
+		== UINT64_C(0x3333333333333333);
+}
+
+static zend_always_inline uint32_t zend_parse_8_digits(uint64_t chunk)
+{
+	/* combine neighbouring digits into pairs, quads and finally eight */
+	chunk = ((chunk & UINT64_C(0x0f0f0f0f0f0f0f0f)) * 2561) >> 8;
+	chunk = ((chunk & UINT64_C(0x00ff00ff00ff00ff)) * 6553601) >> 16;
+	return (uint32_t)(((chunk & UINT64_C(0x0000ffff0000ffff)) * UINT64_C(42949672960001)) >> 32);
+}
+#endif
+
 static zend_always_inline zend_uchar is_numeric_string_ex(const char *str, size_t length, zend_long *lval, double *dval, int allow_errors, int *oflow_info)
 {
 	if (*str > '9') {
@@ -166,7 +196,14 @@ zend_memnstr(const char *haystack, const char *needle, size_t needle_len, const
 		return NULL;
 	}
 
+#ifdef __SSE2__
+	/* zend_memnstr_ex() compares the first and the last byte of the needle
+	 * against 16 positions at once, which beats memchr() for all but the
+	 * shortest haystacks */
+	if (off_s < 64) {
+#else
 	if (EXPECTED(off_s < 1024 || needle_len < 9)) {	/* glibc memchr is faster when needle is too short */
+#endif
 		end -= needle_len;
 
 		while (p <= end) {
@@ -224,7 +261,11 @@ zend_memnrstr(const char *haystack, const char *needle, size_t needle_len, const
         return NULL;
     }
 
+#ifdef __SSE2__
+	if (off_s < 64) {
+#else
 	if (EXPECTED(off_s < 1024 || needle_len < 3)) {
+#endif
 		p -= needle_len;
 
 		do {
@@ -365,6 +406,10 @@ ZEND_API int ZEND_FASTCALL string_case_compare_function(zval *op1, zval *op2);
 ZEND_API int ZEND_FASTCALL string_locale_compare_function(zval *op1, zval *op2);
 #endif
 
+/* Selects the SIMD variants of the string functions below, called once at
+ * startup after zend_cpu_startup() */
+void zend_startup_string_functions(void);
+
 ZEND_API void         ZEND_FASTCALL zend_str_tolower(char *str, size_t length);
 ZEND_API char*        ZEND_FASTCALL zend_str_tolower_copy(char *dest, const char *source, size_t length);
 ZEND_API char*        ZEND_FASTCALL zend_str_tolower_dup(const char *source, size_t length);
@@ -840,13 +885,23 @@ static zend_always_inline int fast_is_not_identical_function(zval *op1, zval *op
 		return SUCCESS;                                                                                    \
 	}
 
+/* "00" to "99" */
+extern ZEND_API const char zend_digit_pairs[200];
+
 /* buf points to the END of the buffer */
 static zend_always_inline char *zend_print_ulong_to_buf(char *buf, zend_ulong num) {
 	*buf = '\0';
-	do {
-		*--buf = (char) (num % 10) + '0';
-		num /= 10;
-	} while (num > 0);
+	while (num >= 100) {
+		buf -= 2;
+		memcpy(buf, &zend_digit_pairs[(num % 100) * 2], 2);
+		num /= 100;
+	}
+	if (num >= 10) {
+		buf -= 2;
+		memcpy(buf, &zend_digit_pairs[num * 2], 2);
+	} else {
+		*--buf = (char) num + '0';
+	}
 	return buf;
 }
 
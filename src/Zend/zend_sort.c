@@ -229,149 +229,307 @@ ZEND_API void zend_insert_sort(void *base, size_t nmemb, size_t siz, compare_fun
 }
 /* }}} */
 
-/* {{{ ZEND_API void zend_sort(void *base, size_t nmemb, size_t siz, compare_func_t cmp, swap_func_t swp)
+/* {{{ Pattern-defeating quicksort
  *
- * Derived from LLVM's libc++ implementation of std::sort.
+ * Derived from Orson Peters' pdqsort (https://github.com/orlp/pdqsort), altered
+ * to work on the compare_func_t/swap_func_t interface: every comparison is
+ * written as cmp(x, y) > 0 like in the rest of this file, so comparators
+ * returning only 0/1 keep working, and all the scanning loops are bounds
+ * checked because user comparators may be inconsistent.
  *
  * ===========================================================================
- * libc++ License
+ * pdqsort License
  * ===========================================================================
  *
- * The libc++ library is dual licensed under both the University of Illinois
- * "BSD-Like" license and the MIT license. As a user of this code you may
- * choose to use it under either license. As a contributor, you agree to allow
- * your code to be used under both.
- *
- * Full text of the relevant licenses is included below.
- *
- * ===========================================================================
- *
- * University of Illinois/NCSA
- * Open Source License
- *
- * Copyright (c) 2009-2012 by the contributors listed at
- * http://llvm.org/svn/llvm-project/libcxx/trunk/CREDITS.TXT
- *
- * All rights reserved.
+ * Copyright (c) 2015 Orson Peters
  *
- * Developed by:
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
  *
- *     LLVM Team
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
  *
- *     University of Illinois at Urbana-Champaign
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
  *
- *     http://llvm.org
- *
- * Permission is hereby granted, free of charge, to any person obtaining a copy
- * of this software and associated documentation files (the "Software"), to
- * deal with the Software without restriction, including without limitation the
- * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
- * sell copies of the Software, and to permit persons to whom the Software is
- * furnished to do so, subject to the following conditions:
- *
- *     * Redistributions of source code must retain the above copyright notice,
- *       this list of conditions and the following disclaimers.
- *
- *     * Redistributions in binary form must reproduce the above copyright
- *       notice, this list of conditions and the following disclaimers in the
- *       documentation and/or other materials provided with the distribution.
- *
- *     * Neither the names of the LLVM Team, University of Illinois at
- *       Urbana-Champaign, nor the names of its contributors may be used to
- *       endorse or promote products derived from this Software without
- *       specific prior written permission.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
- * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
- * CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
- * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
- * WITH THE SOFTWARE.
- *
- * ===========================================================================
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
  *
- * Copyright (c) 2009-2012 by the contributors listed at
- * http://llvm.org/svn/llvm-project/libcxx/trunk/CREDITS.TXT
- *
- * Permission is hereby granted, free of charge, to any person obtaining a copy
- * of this software and associated documentation files (the "Software"), to
- * deal in the Software without restriction, including without limitation the
- * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
- * sell copies of the Software, and to permit persons to whom the Software is
- * furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included in
- * all copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
- * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
- * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
- * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
- * IN THE SOFTWARE.
+ * 3. This notice may not be removed or altered from any source distribution.
  */
-ZEND_API void zend_sort(void *base, size_t nmemb, size_t siz, compare_func_t cmp, swap_func_t swp)
+
+/* Ranges below this size are insertion sorted */
+#define ZEND_PDQ_INSERTION_THRESHOLD 24
+/* Ranges above this size use Tukey's ninther as pivot */
+#define ZEND_PDQ_NINTHER_THRESHOLD 128
+/* partial insertion sort gives up after this many element moves */
+#define ZEND_PDQ_PARTIAL_INSERTION_LIMIT 8
+
+#define ZEND_PDQ_AT(p, n) ((char *)(p) + (n) * siz)
+#define ZEND_PDQ_GT(a, b) (cmp((a), (b)) > 0)
+
+static zend_always_inline void zend_pdq_insert_sort(char *begin, char *end, size_t siz, compare_func_t cmp, swap_func_t swp) /* {{{ */
 {
-	while (1) {
-		if (nmemb <= 16) {
-			zend_insert_sort(base, nmemb, siz, cmp, swp);
-			return;
-		} else {
-			char *i, *j;
-			char *start = (char *)base;
-			char *end = start + (nmemb * siz);
-			size_t offset = (nmemb >> Z_L(1));
-			char *pivot = start + (offset * siz);
-
-			if ((nmemb >> Z_L(10))) {
-				size_t delta = (offset >> Z_L(1)) * siz;
-				zend_sort_5(start, start + delta, pivot, pivot + delta, end - siz, cmp, swp);
+	char *cur, *sift;
+
+	for (cur = begin + siz; cur < end; cur += siz) {
+		for (sift = cur; sift != begin && ZEND_PDQ_GT(sift - siz, sift); sift -= siz) {
+			swp(sift - siz, sift);
+		}
+	}
+}
+/* }}} */
+
+/* Insertion sort which gives up once more than ZEND_PDQ_PARTIAL_INSERTION_LIMIT
+ * elements had to be moved, returns whether the range is sorted. */
+static zend_always_inline int zend_pdq_partial_insert_sort(char *begin, char *end, size_t siz, compare_func_t cmp, swap_func_t swp) /* {{{ */
+{
+	char *cur, *sift;
+	size_t moves = 0;
+
+	for (cur = begin + siz; cur < end; cur += siz) {
+		for (sift = cur; sift != begin && ZEND_PDQ_GT(sift - siz, sift); sift -= siz) {
+			swp(sift - siz, sift);
+		}
+		moves += (cur - sift) / siz;
+		if (moves > ZEND_PDQ_PARTIAL_INSERTION_LIMIT) {
+			return cur + siz == end;
+		}
+	}
+	return 1;
+}
+/* }}} */
+
+static zend_always_inline void zend_pdq_heap_sort(char *begin, size_t nmemb, size_t siz, compare_func_t cmp, swap_func_t swp) /* {{{ */
+{
+	size_t i, root, child;
+
+	for (i = nmemb / 2; i > 0; i--) {
+		for (root = i - 1; (child = 2 * root + 1) < nmemb; root = child) {
+			if (child + 1 < nmemb && ZEND_PDQ_GT(ZEND_PDQ_AT(begin, child + 1), ZEND_PDQ_AT(begin, child))) {
+				child++;
+			}
+			if (!ZEND_PDQ_GT(ZEND_PDQ_AT(begin, child), ZEND_PDQ_AT(begin, root))) {
+				break;
+			}
+			swp(ZEND_PDQ_AT(begin, root), ZEND_PDQ_AT(begin, child));
+		}
+	}
+	for (i = nmemb - 1; i > 0; i--) {
+		swp(begin, ZEND_PDQ_AT(begin, i));
+		for (root = 0; (child = 2 * root + 1) < i; root = child) {
+			if (child + 1 < i && ZEND_PDQ_GT(ZEND_PDQ_AT(begin, child + 1), ZEND_PDQ_AT(begin, child))) {
+				child++;
+			}
+			if (!ZEND_PDQ_GT(ZEND_PDQ_AT(begin, child), ZEND_PDQ_AT(begin, root))) {
+				break;
+			}
+			swp(ZEND_PDQ_AT(begin, root), ZEND_PDQ_AT(begin, child));
+		}
+	}
+}
+/* }}} */
+
+/* Partitions [begin, end) around the pivot at begin, elements equal to the
+ * pivot go to the right. Returns the final pivot position and stores in
+ * *partitioned whether the range already was partitioned. */
+static zend_always_inline char *zend_pdq_partition_right(char *begin, char *end, size_t siz, compare_func_t cmp, swap_func_t swp, int *partitioned) /* {{{ */
+{
+	char *first = begin + siz;
+	char *last = end;
+
+	while (first < end && ZEND_PDQ_GT(begin, first)) {
+		first += siz;
+	}
+	do {
+		last -= siz;
+	} while (last > first && !ZEND_PDQ_GT(begin, last));
+
+	*partitioned = first >= last;
+
+	while (first < last) {
+		swp(first, last);
+		do {
+			first += siz;
+		} while (first < last && ZEND_PDQ_GT(begin, first));
+		do {
+			last -= siz;
+		} while (last > first && !ZEND_PDQ_GT(begin, last));
+	}
+
+	first -= siz;
+	if (first != begin) {
+		swp(begin, first);
+	}
+	return first;
+}
+/* }}} */
+
+/* Partitions [begin, end) around the pivot at begin, elements equal to the
+ * pivot go to the left. Used when the pivot equals the element before the
+ * range, so the left part is known to contain only equal elements. */
+static zend_always_inline char *zend_pdq_partition_left(char *begin, char *end, size_t siz, compare_func_t cmp, swap_func_t swp) /* {{{ */
+{
+	char *first = begin;
+	char *last = end;
+
+	do {
+		last -= siz;
+	} while (last > begin && ZEND_PDQ_GT(last, begin));
+	do {
+		first += siz;
+	} while (first < last && !ZEND_PDQ_GT(first, begin));
+
+	while (first < last) {
+		swp(first, last);
+		do {
+			last -= siz;
+		} while (last > begin && ZEND_PDQ_GT(last, begin));
+		do {
+			first += siz;
+		} while (first < last && !ZEND_PDQ_GT(first, begin));
+	}
+
+	if (last != begin) {
+		swp(begin, last);
+	}
+	return last;
+}
+/* }}} */
+
+/* Swaps a few elements of an unbalanced partition around to break up the
+ * patterns which made the pivot selection fail. */
+static zend_always_inline void zend_pdq_break_patterns(char *begin, size_t nmemb, size_t siz, swap_func_t swp) /* {{{ */
+{
+	size_t quarter = nmemb / 4;
+	char *last = ZEND_PDQ_AT(begin, nmemb - 1);
+
+	if (nmemb < ZEND_PDQ_INSERTION_THRESHOLD) {
+		return;
+	}
+	swp(begin, ZEND_PDQ_AT(begin, quarter));
+	swp(last, last - quarter * siz);
+	if (nmemb > ZEND_PDQ_NINTHER_THRESHOLD) {
+		swp(begin + siz, ZEND_PDQ_AT(begin, quarter + 1));
+		swp(begin + 2 * siz, ZEND_PDQ_AT(begin, quarter + 2));
+		swp(last - siz, last - (quarter + 1) * siz);
+		swp(last - 2 * siz, last - (quarter + 2) * siz);
+	}
+}
+/* }}} */
+
+static zend_always_inline void zend_pdq_sort(void *base, size_t nmemb, size_t siz, compare_func_t cmp, swap_func_t swp) /* {{{ */
+{
+	char   *begin_stack[QSORT_STACK_SIZE];
+	char   *end_stack[QSORT_STACK_SIZE];
+	int     leftmost_stack[QSORT_STACK_SIZE];
+	int     bad_allowed_stack[QSORT_STACK_SIZE];
+	int     loop = 0;
+	size_t  n;
+
+	begin_stack[0] = (char *) base;
+	end_stack[0] = ZEND_PDQ_AT(base, nmemb);
+	leftmost_stack[0] = 1;
+	/* switch to heap sort after log2(nmemb) badly unbalanced partitions */
+	for (bad_allowed_stack[0] = 0, n = nmemb; n > 1; n >>= 1) {
+		bad_allowed_stack[0]++;
+	}
+
+	for (; loop >= 0; --loop) {
+		char *begin = begin_stack[loop];
+		char *end = end_stack[loop];
+		int leftmost = leftmost_stack[loop];
+		int bad_allowed = bad_allowed_stack[loop];
+
+		while (1) {
+			size_t size = (end - begin) / siz;
+			size_t half = size / 2;
+			size_t l_size, r_size;
+			char *pivot;
+			int partitioned;
+
+			if (size < ZEND_PDQ_INSERTION_THRESHOLD) {
+				zend_pdq_insert_sort(begin, end, siz, cmp, swp);
+				break;
+			}
+
+			/* move the median of 3 (or the ninther) to begin */
+			if (size > ZEND_PDQ_NINTHER_THRESHOLD) {
+				zend_sort_3(begin, ZEND_PDQ_AT(begin, half), end - siz, cmp, swp);
+				zend_sort_3(begin + siz, ZEND_PDQ_AT(begin, half - 1), end - 2 * siz, cmp, swp);
+				zend_sort_3(begin + 2 * siz, ZEND_PDQ_AT(begin, half + 1), end - 3 * siz, cmp, swp);
+				zend_sort_3(ZEND_PDQ_AT(begin, half - 1), ZEND_PDQ_AT(begin, half), ZEND_PDQ_AT(begin, half + 1), cmp, swp);
+				swp(begin, ZEND_PDQ_AT(begin, half));
 			} else {
-				zend_sort_3(start, pivot, end - siz, cmp, swp);
+				zend_sort_3(ZEND_PDQ_AT(begin, half), begin, end - siz, cmp, swp);
 			}
-			swp(start + siz, pivot);
-			pivot = start + siz;
-			i = pivot + siz;
-			j = end - siz;
-			while (1) {
-				while (cmp(pivot, i) > 0) {
-					i += siz;
-					if (UNEXPECTED(i == j)) {
-						goto done;
-					}
-				}
-				j -= siz;
-				if (UNEXPECTED(j == i)) {
-					goto done;
-				}
-				while (cmp(j, pivot) > 0) {
-					j -= siz;
-					if (UNEXPECTED(j == i)) {
-						goto done;
-					}
-				}
-				swp(i, j);
-				i += siz;
-				if (UNEXPECTED(i == j)) {
-					goto done;
+
+			/* the element before the range is not greater than anything in
+			 * it, if it equals the pivot too there are many equal elements
+			 * and those are put aside at once */
+			if (!leftmost && !ZEND_PDQ_GT(begin, begin - siz)) {
+				begin = zend_pdq_partition_left(begin, end, siz, cmp, swp) + siz;
+				continue;
+			}
+
+			pivot = zend_pdq_partition_right(begin, end, siz, cmp, swp, &partitioned);
+			l_size = (pivot - begin) / siz;
+			r_size = (end - pivot) / siz - 1;
+
+			if (l_size < size / 8 || r_size < size / 8) {
+				if (--bad_allowed <= 0) {
+					zend_pdq_heap_sort(begin, size, siz, cmp, swp);
+					break;
 				}
+				zend_pdq_break_patterns(begin, l_size, siz, swp);
+				zend_pdq_break_patterns(pivot + siz, r_size, siz, swp);
+			} else if (partitioned &&
+					zend_pdq_partial_insert_sort(begin, pivot, siz, cmp, swp) &&
+					zend_pdq_partial_insert_sort(pivot + siz, end, siz, cmp, swp)) {
+				/* presorted input, nothing left to do */
+				break;
 			}
-done:
-			swp(pivot, i - siz);
-			if ((i - siz) - start < end - i) {
-				zend_sort(start, (i - start)/siz - 1, siz, cmp, swp);
-				base = i;
-				nmemb = (end - i)/siz;
+
+			/* keep the larger part for later and go on with the smaller
+			 * one, so the stack never grows beyond log2(nmemb) entries */
+			if (l_size > r_size) {
+				begin_stack[loop] = begin;
+				end_stack[loop] = pivot;
+				leftmost_stack[loop] = leftmost;
+				bad_allowed_stack[loop++] = bad_allowed;
+				begin = pivot + siz;
+				leftmost = 0;
 			} else {
-				zend_sort(i, (end - i)/siz, siz, cmp, swp);
-				nmemb = (i - start)/siz - 1;
+				begin_stack[loop] = pivot + siz;
+				end_stack[loop] = end;
+				leftmost_stack[loop] = 0;
+				bad_allowed_stack[loop++] = bad_allowed;
+				end = pivot;
 			}
 		}
 	}
 }
 /* }}} */
+/* }}} */
+
+/* {{{ ZEND_API void zend_sort(void *base, size_t nmemb, size_t siz, compare_func_t cmp, swap_func_t swp)
+ *
+ * Hybrid sort: insertion sort for short ranges, pattern-defeating quicksort
+ * otherwise, which detects presorted runs and falls back to heap sort on
+ * adversarial input. */
+ZEND_API void zend_sort(void *base, size_t nmemb, size_t siz, compare_func_t cmp, swap_func_t swp)
+{
+	if (nmemb <= 16) {
+		zend_insert_sort(base, nmemb, siz, cmp, swp);
+		return;
+	}
+	zend_pdq_sort(base, nmemb, siz, cmp, swp);
+}
+/* }}} */
 
 /*
  * Local Variables:
@@ -147,7 +147,7 @@ static int zend_stream_getc(zend_file_handle *file_handle) /* {{{ */
 	return EOF;
 } /* }}} */
 
-static size_t zend_stream_read(zend_file_handle *file_handle, char *buf, size_t len) /* {{{ */
+ZEND_API size_t zend_stream_read(zend_file_handle *file_handle, char *buf, size_t len) /* {{{ */
 {
 	if (!zend_stream_is_mmap(file_handle) && file_handle->handle.stream.isatty) {
 		int c = '*';
@@ -165,11 +165,8 @@ static size_t zend_stream_read(zend_file_handle *file_handle, char *buf, size_t
 	return file_handle->handle.stream.reader(file_handle->handle.stream.handle, buf, len);
 } /* }}} */
 
-ZEND_API int zend_stream_fixup(zend_file_handle *file_handle, char **buf, size_t *len) /* {{{ */
+static int zend_stream_init_reader(zend_file_handle *file_handle) /* {{{ */
 {
-	size_t size;
-	zend_stream_type old_type;
-
 	if (file_handle->type == ZEND_HANDLE_FILENAME) {
 		if (zend_stream_open(file_handle->filename, file_handle) == FAILURE) {
 			return FAILURE;
@@ -191,20 +188,50 @@ ZEND_API int zend_stream_fixup(zend_file_handle *file_handle, char **buf, size_t
 			file_handle->handle.stream.closer     = (zend_stream_closer_t)zend_stream_stdio_closer;
 			file_handle->handle.stream.fsizer     = (zend_stream_fsizer_t)zend_stream_stdio_fsizer;
 			memset(&file_handle->handle.stream.mmap, 0, sizeof(file_handle->handle.stream.mmap));
-			/* no break; */
+			/* fall through */
 		case ZEND_HANDLE_STREAM:
-			/* nothing to do */
-			break;
-
 		case ZEND_HANDLE_MAPPED:
-			file_handle->handle.stream.mmap.pos = 0;
-			*buf = file_handle->handle.stream.mmap.buf;
-			*len = file_handle->handle.stream.mmap.len;
+			/* nothing to do */
 			return SUCCESS;
 
 		default:
 			return FAILURE;
 	}
+} /* }}} */
+
+ZEND_API int zend_stream_fixup_chunked(zend_file_handle *file_handle) /* {{{ */
+{
+	size_t size;
+
+	if (zend_stream_init_reader(file_handle) == FAILURE || file_handle->type == ZEND_HANDLE_MAPPED) {
+		return FAILURE;
+	}
+
+	/* pipes and terminals report a size of 0 */
+	size = zend_stream_fsize(file_handle);
+	if (size == (size_t)-1 || (size && size < ZEND_STREAM_CHUNKED_MIN_SIZE)) {
+		return FAILURE;
+	}
+
+	file_handle->type = ZEND_HANDLE_STREAM;
+	return SUCCESS;
+} /* }}} */
+
+ZEND_API int zend_stream_fixup(zend_file_handle *file_handle, char **buf, size_t *len) /* {{{ */
+{
+	size_t size;
+	zend_stream_type old_type;
+
+	if (zend_stream_init_reader(file_handle) == FAILURE) {
+		return FAILURE;
+	}
+
+	if (file_handle->type == ZEND_HANDLE_MAPPED) {
+		file_handle->handle.stream.mmap.pos = 0;
+		*buf = file_handle->handle.stream.mmap.buf;
+		*len = file_handle->handle.stream.mmap.len;
+		return SUCCESS;
+	}
 
 	size = zend_stream_fsize(file_handle);
 	if (size == (size_t)-1) {
@@ -34,6 +34,10 @@ typedef void   (*zend_stream_closer_t)(void* handle);
 
 #define ZEND_MMAP_AHEAD 32
 
+/* Regular files smaller than this are mapped (or read) into memory as a whole
+ * for scanning, larger ones as well as pipes are read in chunks */
+#define ZEND_STREAM_CHUNKED_MIN_SIZE (1024 * 1024)
+
 typedef enum {
 	ZEND_HANDLE_FILENAME,
 	ZEND_HANDLE_FD,
@@ -75,6 +79,11 @@ typedef struct _zend_file_handle {
 BEGIN_EXTERN_C()
 ZEND_API int zend_stream_open(const char *filename, zend_file_handle *handle);
 ZEND_API int zend_stream_fixup(zend_file_handle *file_handle, char **buf, size_t *len);
+/* Prepares the handle to be read with zend_stream_read() if it refers to a
+ * pipe, a terminal or a file of at least ZEND_STREAM_CHUNKED_MIN_SIZE bytes.
+ * Otherwise FAILURE is returned and the handle is left for zend_stream_fixup(). */
+ZEND_API int zend_stream_fixup_chunked(zend_file_handle *file_handle);
+ZEND_API size_t zend_stream_read(zend_file_handle *file_handle, char *buf, size_t len);
 ZEND_API void zend_file_handle_dtor(zend_file_handle *fh);
 ZEND_API int zend_compare_file_handles(zend_file_handle *fh1, zend_file_handle *fh2);
 END_EXTERN_C()
@@ -37,6 +37,41 @@ static zend_string* ZEND_FASTCALL zend_string_init_interned_request(const char *
    possible on costs of locking in the thread safe builds. */
 static HashTable interned_strings_permanent;
 
+/* Strings published by the request tiers of the threads at their safe points,
+   see zend_interned_strings_publish(). The table is open addressed and append
+   only: a slot is written once, after the string in it is complete, so lookups
+   don't lock. Only the publishers are serialized. A table that has to grow is
+   replaced by a copy, the old one is kept until shutdown as other threads may
+   still probe it; tables grow by doubling, so that costs less than the live
+   table itself. */
+typedef struct _zend_interned_strings_shared {
+	uint32_t mask;
+	uint32_t used;
+	struct _zend_interned_strings_shared *prev;
+	zend_string *slots[1];
+} zend_interned_strings_shared;
+
+static zend_interned_strings_shared *interned_strings_shared = NULL;
+
+#ifdef ZTS
+static MUTEX_T interned_strings_shared_mutex = NULL;
+# define INTERNED_STRINGS_SHARED_LOCK()   tsrm_mutex_lock(interned_strings_shared_mutex)
+# define INTERNED_STRINGS_SHARED_UNLOCK() tsrm_mutex_unlock(interned_strings_shared_mutex)
+#else
+# define INTERNED_STRINGS_SHARED_LOCK()
+# define INTERNED_STRINGS_SHARED_UNLOCK()
+#endif
+
+#if defined(ZTS) && (defined(__GNUC__) || defined(__clang__))
+# define INTERNED_STRINGS_SHARED_LOAD(p)     __atomic_load_n(&(p), __ATOMIC_ACQUIRE)
+# define INTERNED_STRINGS_SHARED_STORE(p, v) __atomic_store_n(&(p), (v), __ATOMIC_RELEASE)
+#else
+/* aligned pointer stores are atomic; MSVC gives volatile accesses acquire and
+   release semantics */
+# define INTERNED_STRINGS_SHARED_LOAD(p)     (*(void * volatile *)&(p))
+# define INTERNED_STRINGS_SHARED_STORE(p, v) (*(void * volatile *)&(p) = (v))
+#endif
+
 static zend_new_interned_string_func_t interned_string_request_handler = zend_new_interned_string_request;
 static zend_string_init_interned_func_t interned_string_init_request_handler = zend_string_init_interned_request;
 static zend_string_copy_storage_func_t interned_string_copy_storage = NULL;
@@ -90,6 +125,9 @@ ZEND_API void zend_interned_strings_init(void)
 	zend_known_strings = NULL;
 
 	zend_init_interned_strings_ht(&interned_strings_permanent, 1);
+#ifdef ZTS
+	interned_strings_shared_mutex = tsrm_mutex_alloc();
+#endif
 
 	zend_new_interned_string = zend_new_interned_string_permanent;
 	zend_string_init_interned = zend_string_init_interned_permanent;
@@ -115,6 +153,30 @@ ZEND_API void zend_interned_strings_init(void)
 
 ZEND_API void zend_interned_strings_dtor(void)
 {
+	zend_interned_strings_shared *shared = interned_strings_shared;
+
+	if (shared) {
+		uint32_t i;
+
+		for (i = 0; i <= shared->mask; i++) {
+			if (shared->slots[i]) {
+				free(shared->slots[i]);
+			}
+		}
+		do {
+			zend_interned_strings_shared *prev = shared->prev;
+			free(shared);
+			shared = prev;
+		} while (shared);
+		interned_strings_shared = NULL;
+	}
+#ifdef ZTS
+	if (interned_strings_shared_mutex) {
+		tsrm_mutex_free(interned_strings_shared_mutex);
+		interned_strings_shared_mutex = NULL;
+	}
+#endif
+
 	zend_hash_destroy(&interned_strings_permanent);
 
 	free(zend_known_strings);
@@ -162,6 +224,81 @@ static zend_always_inline zend_string *zend_interned_string_ht_lookup(zend_strin
 	return NULL;
 }
 
+static zend_always_inline zend_string *zend_interned_string_shared_lookup(zend_ulong h, const char *str, size_t size)
+{
+	zend_interned_strings_shared *shared = INTERNED_STRINGS_SHARED_LOAD(interned_strings_shared);
+	zend_string *s;
+	uint32_t idx;
+
+	if (!shared) {
+		return NULL;
+	}
+
+	idx = (uint32_t)h & shared->mask;
+	while ((s = INTERNED_STRINGS_SHARED_LOAD(shared->slots[idx])) != NULL) {
+		if (ZSTR_H(s) == h && ZSTR_LEN(s) == size && !memcmp(ZSTR_VAL(s), str, size)) {
+			return s;
+		}
+		idx = (idx + 1) & shared->mask;
+	}
+
+	return NULL;
+}
+
+/* Must be called with the shared tier locked */
+static zend_interned_strings_shared *zend_interned_strings_shared_grow(zend_interned_strings_shared *old)
+{
+	uint32_t size = old ? (old->mask + 1) * 2 : 1024;
+	zend_interned_strings_shared *shared = pemalloc(sizeof(zend_interned_strings_shared) + (size - 1) * sizeof(zend_string *), 1);
+	uint32_t i;
+
+	shared->mask = size - 1;
+	shared->used = 0;
+	shared->prev = old;
+	memset(shared->slots, 0, size * sizeof(zend_string *));
+
+	if (old) {
+		for (i = 0; i <= old->mask; i++) {
+			zend_string *s = old->slots[i];
+
+			if (s) {
+				uint32_t idx = (uint32_t)ZSTR_H(s) & shared->mask;
+
+				while (shared->slots[idx]) {
+					idx = (idx + 1) & shared->mask;
+				}
+				shared->slots[idx] = s;
+			}
+		}
+		shared->used = old->used;
+	}
+
+	INTERNED_STRINGS_SHARED_STORE(interned_strings_shared, shared);
+	return shared;
+}
+
+/* Must be called with the shared tier locked, fails once the tier is full */
+static zend_bool zend_interned_strings_shared_add(zend_string *str)
+{
+	zend_interned_strings_shared *shared = interned_strings_shared;
+	uint32_t idx;
+
+	if (shared && shared->used >= ZEND_INTERNED_STRINGS_SHARED_MAX) {
+		return 0;
+	}
+	if (!shared || (shared->used + 1) * 2 > shared->mask + 1) {
+		shared = zend_interned_strings_shared_grow(shared);
+	}
+
+	idx = (uint32_t)ZSTR_H(str) & shared->mask;
+	while (shared->slots[idx]) {
+		idx = (idx + 1) & shared->mask;
+	}
+	shared->used++;
+	INTERNED_STRINGS_SHARED_STORE(shared->slots[idx], str);
+	return 1;
+}
+
 /* This function might be not thread safe at least because it would update the
    hash val in the passed string. Be sure it is called in the appropriate context. */
 static zend_always_inline zend_string *zend_add_interned_string(zend_string *str, HashTable *interned_strings, uint32_t flags)
@@ -178,10 +315,32 @@ static zend_always_inline zend_string *zend_add_interned_string(zend_string *str
 	return str;
 }
 
+/* Strings interned while code is compiled are likely needed by the next
+   request too. The ones interned by running code are often built from data,
+   e.g. keys or names assembled at run time, they are marked so that
+   zend_interned_strings_publish() leaves them out. A marked string that the
+   compiler asks for later loses the mark. */
+#define ZEND_INTERNED_STRING_REQUEST_FLAGS() \
+	(CG(in_compilation) ? 0 : IS_STR_REQUEST_LOCAL)
+
+static zend_always_inline zend_string *zend_interned_string_request_seen(zend_string *str)
+{
+	if (UNEXPECTED(GC_FLAGS(str) & IS_STR_REQUEST_LOCAL) && CG(in_compilation)) {
+		GC_DEL_FLAGS(str, IS_STR_REQUEST_LOCAL);
+	}
+	return str;
+}
+
 ZEND_API zend_string* ZEND_FASTCALL zend_interned_string_find_permanent(zend_string *str)
 {
+	zend_string *ret;
+
 	zend_string_hash_val(str);
-	return zend_interned_string_ht_lookup(str, &interned_strings_permanent);
+	ret = zend_interned_string_ht_lookup(str, &interned_strings_permanent);
+	if (!ret) {
+		ret = zend_interned_string_shared_lookup(ZSTR_H(str), ZSTR_VAL(str), ZSTR_LEN(str));
+	}
+	return ret;
 }
 
 static zend_string* ZEND_FASTCALL zend_new_interned_string_permanent(zend_string *str)
@@ -223,17 +382,31 @@ static zend_string* ZEND_FASTCALL zend_new_interned_string_request(zend_string *
 	/* Check for permanent strings, the table is readonly at this point. */
 	ret = zend_interned_string_ht_lookup(str, &interned_strings_permanent);
 	if (ret) {
+		CG(interned_strings_hits)++;
 		zend_string_release(str);
 		return ret;
 	}
 
+	/* The request tier goes before the shared one, a string interned by this
+	   request keeps resolving to the same copy when another thread publishes
+	   it meanwhile. */
 	ret = zend_interned_string_ht_lookup(str, &CG(interned_strings));
 	if (ret) {
+		CG(interned_strings_hits)++;
+		zend_string_release(str);
+		return zend_interned_string_request_seen(ret);
+	}
+
+	ret = zend_interned_string_shared_lookup(ZSTR_H(str), ZSTR_VAL(str), ZSTR_LEN(str));
+	if (ret) {
+		CG(interned_strings_hits)++;
+		CG(interned_strings_shared_hits)++;
 		zend_string_release(str);
 		return ret;
 	}
 
 	/* Create a short living interned, freed after the request. */
+	CG(interned_strings_misses)++;
 	ZEND_ASSERT(!(GC_FLAGS(str) & GC_PERSISTENT));
 	if (GC_REFCOUNT(str) > 1) {
 		zend_ulong h = ZSTR_H(str);
@@ -242,7 +415,7 @@ static zend_string* ZEND_FASTCALL zend_new_interned_string_request(zend_string *
 		ZSTR_H(str) = h;
 	}
 
-	ret = zend_add_interned_string(str, &CG(interned_strings), 0);
+	ret = zend_add_interned_string(str, &CG(interned_strings), ZEND_INTERNED_STRING_REQUEST_FLAGS());
 
 	return ret;
 }
@@ -270,31 +443,166 @@ static zend_string* ZEND_FASTCALL zend_string_init_interned_request(const char *
 	/* Check for permanent strings, the table is readonly at this point. */
 	ret = zend_interned_string_ht_lookup_ex(h, str, size, &interned_strings_permanent);
 	if (ret) {
+		CG(interned_strings_hits)++;
 		return ret;
 	}
 
 	ret = zend_interned_string_ht_lookup_ex(h, str, size, &CG(interned_strings));
 	if (ret) {
+		CG(interned_strings_hits)++;
+		return zend_interned_string_request_seen(ret);
+	}
+
+	ret = zend_interned_string_shared_lookup(h, str, size);
+	if (ret) {
+		CG(interned_strings_hits)++;
+		CG(interned_strings_shared_hits)++;
 		return ret;
 	}
 
+	CG(interned_strings_misses)++;
 	ret = zend_string_init(str, size, permanent);
 	ZSTR_H(ret) = h;
 
 	/* Create a short living interned, freed after the request. */
-	return zend_add_interned_string(ret, &CG(interned_strings), 0);
+	return zend_add_interned_string(ret, &CG(interned_strings), ZEND_INTERNED_STRING_REQUEST_FLAGS());
 }
 
 ZEND_API void zend_interned_strings_activate(void)
 {
 	zend_init_interned_strings_ht(&CG(interned_strings), 0);
+	CG(interned_strings_hits) = 0;
+	CG(interned_strings_shared_hits) = 0;
+	CG(interned_strings_misses) = 0;
 }
 
 ZEND_API void zend_interned_strings_deactivate(void)
 {
+	/* with zend.publish_interned_strings, the requests that come after this
+	 * one, in any thread, find its strings in the shared tier */
+	if (CG(publish_interned_strings) && zend_hash_num_elements(&CG(interned_strings))) {
+		zend_interned_strings_publish();
+	}
 	zend_hash_destroy(&CG(interned_strings));
 }
 
+/* Whether strings interned from now on are kept in CG(interned_strings), that
+ * is, private to the calling thread */
+ZEND_API zend_bool zend_interned_strings_are_thread_local(void)
+{
+	return zend_new_interned_string == zend_new_interned_string_request
+		&& zend_string_init_interned == zend_string_init_interned_request;
+}
+
+/* Takes over the request interned strings collected by another thread into
+ * CG(interned_strings). The memory of the strings must already belong to the
+ * current heap (see zend_mm_adopt_heap()). Strings that are interned here as
+ * well are still referenced by the code that was compiled with them, so they
+ * are kept under numeric keys until the end of the request. Numeric keys never
+ * match a lookup, as string hashes always have the high bit set. */
+ZEND_API void zend_interned_strings_adopt(HashTable *interned_strings)
+{
+	zend_string *str;
+	zval val;
+
+	ZEND_HASH_FOREACH_STR_KEY(interned_strings, str) {
+		ZVAL_INTERNED_STR(&val, str);
+		if (zend_interned_string_ht_lookup(str, &CG(interned_strings))) {
+			zend_hash_next_index_insert_new(&CG(interned_strings), &val);
+		} else {
+			zend_hash_add_new(&CG(interned_strings), str, &val);
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	interned_strings->pDestructor = NULL;
+	zend_hash_destroy(interned_strings);
+}
+
+/* Copies the strings interned by the current request into the shared tier,
+ * where the request tiers of all the threads find them from now on. Called
+ * at the end of every request with zend.publish_interned_strings, and meant
+ * for long running workers that prefer to pick their own safe point; strings
+ * already shared are skipped. So are the strings marked IS_STR_REQUEST_LOCAL:
+ * those interned by running code rather than by the compiler, and names the
+ * compiler makes unique to one compilation, as the shared tier is never
+ * freed. Returns the number of strings added. */
+ZEND_API uint32_t zend_interned_strings_publish(void)
+{
+	zval *zv;
+	uint32_t published = 0;
+
+	INTERNED_STRINGS_SHARED_LOCK();
+	ZEND_HASH_FOREACH_VAL(&CG(interned_strings), zv) {
+		zend_string *str = Z_STR_P(zv);
+		zend_string *copy;
+
+		if (GC_FLAGS(str) & IS_STR_REQUEST_LOCAL) {
+			continue;
+		}
+		if (zend_interned_string_shared_lookup(ZSTR_H(str), ZSTR_VAL(str), ZSTR_LEN(str))) {
+			continue;
+		}
+
+		copy = zend_string_init(ZSTR_VAL(str), ZSTR_LEN(str), 1);
+		ZSTR_H(copy) = ZSTR_H(str);
+		GC_SET_REFCOUNT(copy, 1);
+		GC_ADD_FLAGS(copy, IS_STR_INTERNED | IS_STR_PERMANENT);
+		if (!zend_interned_strings_shared_add(copy)) {
+			pefree(copy, 1);
+			break;
+		}
+		published++;
+	} ZEND_HASH_FOREACH_END();
+	INTERNED_STRINGS_SHARED_UNLOCK();
+
+	return published;
+}
+
+/* Returns a string equal to str that all the threads can use until shutdown:
+ * str itself when it is permanent, else the copy in the permanent or shared
+ * tier, which is added to the shared tier if needed. Returns NULL when str
+ * would have to be added and the shared tier is full. */
+ZEND_API zend_string* ZEND_FASTCALL zend_interned_string_share(zend_string *str)
+{
+	zend_string *ret;
+
+	if (ZSTR_IS_INTERNED(str) && (GC_FLAGS(str) & IS_STR_PERMANENT)) {
+		return str;
+	}
+
+	ret = zend_interned_string_find_permanent(str);
+	if (ret) {
+		return ret;
+	}
+
+	INTERNED_STRINGS_SHARED_LOCK();
+	ret = zend_interned_string_shared_lookup(ZSTR_H(str), ZSTR_VAL(str), ZSTR_LEN(str));
+	if (!ret) {
+		ret = zend_string_init(ZSTR_VAL(str), ZSTR_LEN(str), 1);
+		ZSTR_H(ret) = ZSTR_H(str);
+		GC_SET_REFCOUNT(ret, 1);
+		GC_ADD_FLAGS(ret, IS_STR_INTERNED | IS_STR_PERMANENT);
+		if (!zend_interned_strings_shared_add(ret)) {
+			pefree(ret, 1);
+			ret = NULL;
+		}
+	}
+	INTERNED_STRINGS_SHARED_UNLOCK();
+
+	return ret;
+}
+
+ZEND_API void zend_interned_strings_get_status(zend_interned_strings_status *status)
+{
+	INTERNED_STRINGS_SHARED_LOCK();
+	status->shared = interned_strings_shared ? interned_strings_shared->used : 0;
+	INTERNED_STRINGS_SHARED_UNLOCK();
+	status->request = zend_hash_num_elements(&CG(interned_strings));
+	status->hits = CG(interned_strings_hits);
+	status->shared_hits = CG(interned_strings_shared_hits);
+	status->misses = CG(interned_strings_misses);
+}
+
 ZEND_API void zend_interned_strings_set_request_storage_handlers(zend_new_interned_string_func_t handler, zend_string_init_interned_func_t init_handler)
 {
 	interned_string_request_handler = handler;
@@ -324,6 +632,28 @@ ZEND_API void zend_interned_strings_switch_storage(zend_bool request)
 	}
 }
 
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__)) && defined(__SSE2__)
+/* Compares 16 bytes at a time; the last block overlaps the previous one
+ * instead of reading past the end. len must be at least 16. */
+static zend_always_inline zend_bool zend_string_equal_val_sse2(const char *ptr1, const char *ptr2, size_t len)
+{
+	const char *end = ptr1 + len - 16;
+	__m128i acc;
+
+	while (ptr1 < end) {
+		acc = _mm_xor_si128(_mm_loadu_si128((const __m128i *)ptr1), _mm_loadu_si128((const __m128i *)ptr2));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(acc, _mm_setzero_si128())) != 0xffff) {
+			return 0;
+		}
+		ptr1 += 16;
+		ptr2 += 16;
+	}
+	ptr2 -= ptr1 - end;
+	acc = _mm_xor_si128(_mm_loadu_si128((const __m128i *)end), _mm_loadu_si128((const __m128i *)ptr2));
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(acc, _mm_setzero_si128())) == 0xffff;
+}
+#endif
+
 #if defined(__GNUC__) && defined(__i386__)
 ZEND_API zend_bool ZEND_FASTCALL zend_string_equal_val(zend_string *s1, zend_string *s2)
 {
@@ -332,6 +662,12 @@ ZEND_API zend_bool ZEND_FASTCALL zend_string_equal_val(zend_string *s1, zend_str
 	size_t len = ZSTR_LEN(s1);
 	zend_ulong ret;
 
+#ifdef __SSE2__
+	if (len >= 16) {
+		return zend_string_equal_val_sse2(ptr, ZSTR_VAL(s2), len);
+	}
+#endif
+
 	__asm__ (
 		".LL0%=:\n\t"
 		"movl (%2,%3), %0\n\t"
@@ -400,6 +736,12 @@ ZEND_API zend_bool ZEND_FASTCALL zend_string_equal_val(zend_string *s1, zend_str
 	size_t len = ZSTR_LEN(s1);
 	zend_ulong ret;
 
+#ifdef __SSE2__
+	if (len >= 16) {
+		return zend_string_equal_val_sse2(ptr, ZSTR_VAL(s2), len);
+	}
+#endif
+
 	__asm__ (
 		".LL0%=:\n\t"
 		"movq (%2,%3), %0\n\t"
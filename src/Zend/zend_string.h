@@ -27,6 +27,14 @@ typedef void (*zend_string_copy_storage_func_t)(void);
 typedef zend_string *(ZEND_FASTCALL *zend_new_interned_string_func_t)(zend_string *str);
 typedef zend_string *(ZEND_FASTCALL *zend_string_init_interned_func_t)(const char *str, size_t size, int permanent);
 
+typedef struct _zend_interned_strings_status {
+	uint32_t   shared;      /* strings in the tier shared by all the threads */
+	uint32_t   request;     /* strings in the request tier of this thread */
+	zend_ulong hits;        /* lookups of this request that found a string */
+	zend_ulong shared_hits; /* ... of them in the shared tier */
+	zend_ulong misses;      /* lookups that added a string to the request tier */
+} zend_interned_strings_status;
+
 ZEND_API extern zend_new_interned_string_func_t zend_new_interned_string;
 ZEND_API extern zend_string_init_interned_func_t zend_string_init_interned;
 
@@ -38,6 +46,17 @@ ZEND_API void zend_interned_strings_init(void);
 ZEND_API void zend_interned_strings_dtor(void);
 ZEND_API void zend_interned_strings_activate(void);
 ZEND_API void zend_interned_strings_deactivate(void);
+ZEND_API zend_bool zend_interned_strings_are_thread_local(void);
+ZEND_API void zend_interned_strings_adopt(HashTable *interned_strings);
+/* Strings added to the shared tier are only freed at shutdown, so the tier
+ * stops growing at ZEND_INTERNED_STRINGS_SHARED_MAX strings. Past that,
+ * zend_interned_strings_publish() adds nothing and zend_interned_string_share()
+ * returns NULL for strings that are not in it yet. */
+#define ZEND_INTERNED_STRINGS_SHARED_MAX (256 * 1024)
+
+ZEND_API uint32_t zend_interned_strings_publish(void);
+ZEND_API zend_string* ZEND_FASTCALL zend_interned_string_share(zend_string *str);
+ZEND_API void zend_interned_strings_get_status(zend_interned_strings_status *status);
 ZEND_API void zend_interned_strings_set_request_storage_handlers(zend_new_interned_string_func_t handler, zend_string_init_interned_func_t init_handler);
 ZEND_API void zend_interned_strings_set_permanent_storage_copy_handlers(zend_string_copy_storage_func_t copy_handler, zend_string_copy_storage_func_t restore_handler);
 ZEND_API void zend_interned_strings_switch_storage(zend_bool request);
@@ -2528,6 +2528,392 @@ retlow1:
 	}
 #endif /* NO_STRTOD_BIGCOMP */
 
+/* Fast paths
+ *
+ * Most conversions can be decided with 64 and 128 bit integer arithmetic:
+ * zend_strtod() tries the Eisel-Lemire algorithm and modes 0 and 2 of
+ * zend_dtoa() try Grisu3. Both recognize the rare inputs they cannot decide
+ * and leave those to the multiple-precision code below, so the results are
+ * exactly the same as without them.
+ *
+ * Daniel Lemire, "Number Parsing at a Gigabyte per Second",
+ * Software: Practice and Experience 51 (8), 2021.
+ * Florian Loitsch, "Printing Floating-Point Numbers Quickly and Accurately
+ * with Integers", PLDI 2010.
+ */
+#if defined(IEEE_Arith) && !defined(NO_LONG_LONG) && !defined(Honor_FLT_ROUNDS) && !defined(SET_INEXACT)
+#define ZEND_STRTOD_FAST_PATHS 1
+
+#include "zend_strtod_pow10.h"
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 zend_uint128;
+#endif
+
+/* High 64 bits of a * b, the low 64 bits are stored in *lo */
+static zend_always_inline ULLong zend_umul128(ULLong a, ULLong b, ULLong *lo) /* {{{ */
+{
+#ifdef __SIZEOF_INT128__
+	zend_uint128 r = (zend_uint128)a * b;
+
+	*lo = (ULLong)r;
+	return (ULLong)(r >> 64);
+#else
+	ULLong a0 = a & 0xffffffff, a1 = a >> 32;
+	ULLong b0 = b & 0xffffffff, b1 = b >> 32;
+	ULLong p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+	ULLong mid = (p00 >> 32) + (p01 & 0xffffffff) + (p10 & 0xffffffff);
+
+	*lo = (mid << 32) | (p00 & 0xffffffff);
+	return p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+#endif
+}
+/* }}} */
+
+static zend_always_inline int zend_clz64(ULLong x) /* {{{ */
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_clzll(x);
+#else
+	return (x >> 32) ? hi0bits((ULong)(x >> 32)) : 32 + hi0bits((ULong)x);
+#endif
+}
+/* }}} */
+
+/* Computes w * 10^e10 correctly rounded, for w != 0. Returns 0 when this can
+ * not be decided with 128 bits of 10^e10, or when the result is subnormal or
+ * overflows. */
+static int zend_strtod_eisel_lemire(ULLong w, int e10, U *rv) /* {{{ */
+{
+	const ULLong *pow10;
+	ULLong hi, lo, mantissa, msb;
+	int clz, e2;
+
+	if (e10 < ZEND_POW10_MIN_EXP10 || e10 > ZEND_POW10_MAX_EXP10) {
+		return 0;
+	}
+	pow10 = zend_pow10_128[e10 - ZEND_POW10_MIN_EXP10];
+
+	clz = zend_clz64(w);
+	w <<= clz;
+	/* biased exponent of the result if the product has its top bit set */
+	e2 = ((217706 * e10) >> 16) + 64 + Bias - clz;
+
+	hi = zend_umul128(w, pow10[0], &lo);
+	/* The low half of 10^e10 can only matter when the bits below the 54 we
+	 * keep are all ones and could still carry */
+	if ((hi & 0x1ff) == 0x1ff && lo + w < w) {
+		ULLong hi2, lo2;
+
+		hi2 = zend_umul128(w, pow10[1], &lo2);
+		lo += hi2;
+		if (lo < hi2) {
+			hi++;
+		}
+		if ((hi & 0x1ff) == 0x1ff && lo + 1 == 0 && lo2 + w < w) {
+			return 0;
+		}
+	}
+
+	msb = hi >> 63;
+	mantissa = hi >> (msb + 9);
+	e2 -= 1 ^ (int)msb;
+
+	/* exactly half way between two doubles: the truncated bits of 10^e10
+	 * decide which way to round */
+	if (lo == 0 && (hi & 0x1ff) == 0 && (mantissa & 3) == 1) {
+		return 0;
+	}
+
+	mantissa += mantissa & 1;
+	mantissa >>= 1;
+	if (mantissa >> 53) {
+		mantissa >>= 1;
+		e2++;
+	}
+	if (e2 <= 0 || e2 >= 0x7ff) {
+		return 0;
+	}
+
+	word0(rv) = ((ULong)e2 << Exp_shift) | ((ULong)(mantissa >> 32) & Frac_mask);
+	word1(rv) = (ULong)mantissa;
+	return 1;
+}
+/* }}} */
+
+/* A value f * 2^e with a 64 bit significand */
+typedef struct _zend_diy_fp {
+	ULLong f;
+	int e;
+} zend_diy_fp;
+
+static zend_always_inline zend_diy_fp zend_diy_fp_normalize(zend_diy_fp x) /* {{{ */
+{
+	int shift = zend_clz64(x.f);
+
+	x.f <<= shift;
+	x.e -= shift;
+	return x;
+}
+/* }}} */
+
+/* Product rounded to 64 bits */
+static zend_always_inline zend_diy_fp zend_diy_fp_mul(zend_diy_fp x, zend_diy_fp y) /* {{{ */
+{
+	zend_diy_fp r;
+	ULLong lo;
+
+	r.f = zend_umul128(x.f, y.f, &lo);
+	r.f += lo >> 63;
+	r.e = x.e + y.e + 64;
+	return r;
+}
+/* }}} */
+
+/* Finds c = 10^k such that the exponent of c times a normalized value with
+ * exponent e is between -60 and -32, so that the integral part of the
+ * scaled value fits into 32 bits. Returns c rounded to 64 bits. */
+static zend_diy_fp zend_cached_power(int e, int *k) /* {{{ */
+{
+	const ULLong *pow10;
+	zend_diy_fp c;
+
+	*k = (int)ceil((-60 - (e + 64) + 63) * 0.30102999566398114);
+	pow10 = zend_pow10_128[*k - ZEND_POW10_MIN_EXP10];
+	c.f = pow10[0];
+	c.e = ((217706 * *k) >> 16) - 63;
+	if (pow10[1] >> 63) {
+		if (++c.f == 0) {
+			c.f = (ULLong)1 << 63;
+			c.e++;
+		}
+	}
+	return c;
+}
+/* }}} */
+
+/* Largest power of ten not greater than number, and its number of digits */
+static zend_always_inline void zend_biggest_power_ten(ULong number, ULong *power, int *digits) /* {{{ */
+{
+	ULong p = 1;
+	int n = 1;
+
+	while (n < 10 && p <= number / 10) {
+		p *= 10;
+		n++;
+	}
+	*power = p;
+	*digits = n;
+}
+/* }}} */
+
+static int zend_grisu_round_weed(char *buffer, int length, ULLong distance_too_high_w, ULLong unsafe_interval, ULLong rest, ULLong ten_kappa, ULLong unit) /* {{{ */
+{
+	ULLong small_distance = distance_too_high_w - unit;
+	ULLong big_distance = distance_too_high_w + unit;
+
+	/* Move the last digit down as long as that brings the candidate closer to
+	 * the value while staying in the unsafe interval */
+	while (rest < small_distance
+			&& unsafe_interval - rest >= ten_kappa
+			&& (rest + ten_kappa < small_distance
+				|| small_distance - rest >= rest + ten_kappa - small_distance)) {
+		buffer[length - 1]--;
+		rest += ten_kappa;
+	}
+
+	/* If the candidate one below could be closer as well, the error margin
+	 * does not allow to tell which one is the right one */
+	if (rest < big_distance
+			&& unsafe_interval - rest >= ten_kappa
+			&& (rest + ten_kappa < big_distance
+				|| big_distance - rest > rest + ten_kappa - big_distance)) {
+		return 0;
+	}
+
+	/* The candidate must lie in the safe interval */
+	return (2 * unit <= rest) && (rest <= unsafe_interval - 4 * unit);
+}
+/* }}} */
+
+/* Shortest digits of v that read back as v, or 0 if that could not be
+ * decided. v = buffer * 10^*exp10. */
+static int zend_grisu3_shortest(U *v, char *buffer, int *length, int *exp10) /* {{{ */
+{
+	ULLong frac = ((ULLong)(word0(v) & Frac_mask) << 32) | word1(v);
+	int biased_e = (int)((word0(v) & Exp_mask) >> Exp_shift);
+	zend_diy_fp w, plus, minus, c, low, high, too_low, too_high, one;
+	ULLong unit = 1, unsafe_interval, fractionals, rest;
+	ULong integrals, divisor;
+	int k, kappa;
+
+	if (biased_e) {
+		w.f = frac | ((ULLong)1 << 52);
+		w.e = biased_e - Bias - 52;
+	} else {
+		w.f = frac;
+		w.e = 1 - Bias - 52;
+	}
+
+	/* boundaries half way to the neighbouring doubles; the lower one is
+	 * closer when the significand is a power of two */
+	plus.f = (w.f << 1) + 1;
+	plus.e = w.e - 1;
+	plus = zend_diy_fp_normalize(plus);
+	if (frac == 0 && biased_e > 1) {
+		minus.f = (w.f << 2) - 1;
+		minus.e = w.e - 2;
+	} else {
+		minus.f = (w.f << 1) - 1;
+		minus.e = w.e - 1;
+	}
+	minus.f <<= minus.e - plus.e;
+	minus.e = plus.e;
+	w = zend_diy_fp_normalize(w);
+
+	c = zend_cached_power(w.e, &k);
+	w = zend_diy_fp_mul(w, c);
+	low = zend_diy_fp_mul(minus, c);
+	high = zend_diy_fp_mul(plus, c);
+
+	/* each of the scaled values is off by at most one unit */
+	too_low.f = low.f - unit;
+	too_high.f = high.f + unit;
+	too_high.e = too_low.e = w.e;
+	unsafe_interval = too_high.f - too_low.f;
+
+	one.f = (ULLong)1 << -w.e;
+	one.e = w.e;
+	integrals = (ULong)(too_high.f >> -one.e);
+	fractionals = too_high.f & (one.f - 1);
+	zend_biggest_power_ten(integrals, &divisor, &kappa);
+	*length = 0;
+
+	while (kappa > 0) {
+		buffer[(*length)++] = '0' + integrals / divisor;
+		integrals %= divisor;
+		kappa--;
+		rest = ((ULLong)integrals << -one.e) + fractionals;
+		if (rest < unsafe_interval) {
+			*exp10 = kappa - k;
+			return zend_grisu_round_weed(buffer, *length, too_high.f - w.f, unsafe_interval, rest, (ULLong)divisor << -one.e, unit);
+		}
+		divisor /= 10;
+	}
+
+	for (;;) {
+		fractionals *= 10;
+		unit *= 10;
+		unsafe_interval *= 10;
+		buffer[(*length)++] = '0' + (int)(fractionals >> -one.e);
+		fractionals &= one.f - 1;
+		kappa--;
+		if (fractionals < unsafe_interval) {
+			*exp10 = kappa - k;
+			return zend_grisu_round_weed(buffer, *length, (too_high.f - w.f) * unit, unsafe_interval, fractionals, one.f, unit);
+		}
+	}
+}
+/* }}} */
+
+static int zend_grisu_round_weed_counted(char *buffer, int length, ULLong rest, ULLong ten_kappa, ULLong unit, int *kappa) /* {{{ */
+{
+	int i;
+
+	if (unit >= ten_kappa || ten_kappa - unit <= unit) {
+		return 0;
+	}
+	/* rounding down is safe */
+	if ((ten_kappa - rest > rest) && (ten_kappa - 2 * rest >= 2 * unit)) {
+		return 1;
+	}
+	/* rounding up is safe */
+	if ((rest > unit) && (ten_kappa - (rest - unit) <= (rest - unit))) {
+		buffer[length - 1]++;
+		for (i = length - 1; i > 0; i--) {
+			if (buffer[i] != '0' + 10) {
+				break;
+			}
+			buffer[i] = '0';
+			buffer[i - 1]++;
+		}
+		if (buffer[0] == '0' + 10) {
+			buffer[0] = '1';
+			(*kappa)++;
+		}
+		return 1;
+	}
+	return 0;
+}
+/* }}} */
+
+/* The first ndigits digits of v correctly rounded, or 0 if that could not
+ * be decided. v ~ buffer * 10^*exp10. */
+static int zend_grisu3_counted(U *v, int ndigits, char *buffer, int *length, int *exp10) /* {{{ */
+{
+	ULLong frac = ((ULLong)(word0(v) & Frac_mask) << 32) | word1(v);
+	int biased_e = (int)((word0(v) & Exp_mask) >> Exp_shift);
+	zend_diy_fp w, c, one;
+	ULLong w_error = 1, fractionals;
+	ULong integrals, divisor;
+	int k, kappa;
+
+	if (biased_e) {
+		w.f = frac | ((ULLong)1 << 52);
+		w.e = biased_e - Bias - 52;
+	} else {
+		w.f = frac;
+		w.e = 1 - Bias - 52;
+	}
+	w = zend_diy_fp_normalize(w);
+	c = zend_cached_power(w.e, &k);
+	w = zend_diy_fp_mul(w, c);
+
+	one.f = (ULLong)1 << -w.e;
+	one.e = w.e;
+	integrals = (ULong)(w.f >> -one.e);
+	fractionals = w.f & (one.f - 1);
+	zend_biggest_power_ten(integrals, &divisor, &kappa);
+	*length = 0;
+
+	while (kappa > 0) {
+		buffer[(*length)++] = '0' + integrals / divisor;
+		ndigits--;
+		integrals %= divisor;
+		kappa--;
+		if (ndigits == 0) {
+			break;
+		}
+		divisor /= 10;
+	}
+
+	if (ndigits == 0) {
+		ULLong rest = ((ULLong)integrals << -one.e) + fractionals;
+
+		if (!zend_grisu_round_weed_counted(buffer, *length, rest, (ULLong)divisor << -one.e, w_error, &kappa)) {
+			return 0;
+		}
+		*exp10 = kappa - k;
+		return 1;
+	}
+
+	while (ndigits > 0 && fractionals > w_error) {
+		fractionals *= 10;
+		w_error *= 10;
+		buffer[(*length)++] = '0' + (int)(fractionals >> -one.e);
+		ndigits--;
+		fractionals &= one.f - 1;
+		kappa--;
+	}
+	if (ndigits != 0 || !zend_grisu_round_weed_counted(buffer, *length, fractionals, one.f, w_error, &kappa)) {
+		return 0;
+	}
+	*exp10 = kappa - k;
+	return 1;
+}
+/* }}} */
+#endif /* IEEE_Arith && !NO_LONG_LONG && !Honor_FLT_ROUNDS && !SET_INEXACT */
+
 ZEND_API double
 zend_strtod
 #ifdef KR_headers
@@ -2849,6 +3235,17 @@ zend_strtod
 #endif
 #endif /* ROUND_BIASED_without_Round_Up */
 		}
+#ifdef ZEND_STRTOD_FAST_PATHS
+	if (nd <= DBL_DIG + 2) {
+		/* all digits are in y and z */
+		ULLong w = y;
+
+		if (k > 9)
+			w = w * (ULLong)tens[k - 9] + z;
+		if (zend_strtod_eisel_lemire(w, e, &rv))
+			goto ret;
+		}
+#endif
 	e1 += nd - k;
 
 #ifdef IEEE_Arith
@@ -3824,6 +4221,26 @@ zend_dtoa
 		return nrv_alloc("0", rve, 1);
 		}
 
+#ifdef ZEND_STRTOD_FAST_PATHS
+	if (mode == 0 || (mode == 2 && ndigits <= 17)) {
+		char buf[18];
+		int len, exp10;
+
+		if (mode == 0
+				? zend_grisu3_shortest(&u, buf, &len, &exp10)
+				: zend_grisu3_counted(&u, ndigits > 0 ? ndigits : 1, buf, &len, &exp10)) {
+			/* trailing zeros are suppressed, as below */
+			while (len > 1 && buf[len - 1] == '0') {
+				len--;
+				exp10++;
+				}
+			buf[len] = '\0';
+			*decpt = len + exp10;
+			return nrv_alloc(buf, rve, mode == 2 && ndigits > len ? ndigits : len);
+			}
+		}
+#endif
+
 #ifdef SET_INEXACT
 	try_quick = oldinexact = get_inexact();
 	inexact = 1;
@@ -547,6 +547,7 @@ static zend_always_inline uint32_t zval_gc_info(uint32_t gc_type_info) {
 #define IS_STR_INTERNED				GC_IMMUTABLE  /* interned string */
 #define IS_STR_PERSISTENT			GC_PERSISTENT /* allocated using malloc */
 #define IS_STR_PERMANENT        	(1<<8)        /* relives request boundary */
+#define IS_STR_REQUEST_LOCAL		(1<<9)        /* interned for one request, never published */
 
 /* array flags */
 #define IS_ARRAY_IMMUTABLE			GC_IMMUTABLE
@@ -68,6 +68,13 @@
 #define realpath(x,y) strcpy(y,x)
 #endif
 
+#if HAVE_SYS_INOTIFY_H && !defined(ZEND_WIN32)
+# include <sys/inotify.h>
+# define REALPATH_CACHE_USE_INOTIFY 1
+#else
+# define REALPATH_CACHE_USE_INOTIFY 0
+#endif
+
 #define VIRTUAL_CWD_DEBUG 0
 
 #include "TSRM.h"
@@ -85,6 +92,24 @@ virtual_cwd_globals cwd_globals;
 
 static cwd_state main_cwd_state; /* True global */
 
+#ifdef ZTS
+/* Under ZTS the per-thread caches are backed by a process wide cache, so a
+ * path resolved by one thread is not lstat()'ed again by the others. Lookups
+ * hit the thread local table first and take the lock only on a local miss. */
+static realpath_cache_bucket *realpath_shared_cache[sizeof(((virtual_cwd_globals *)0)->realpath_cache) / sizeof(realpath_cache_bucket *)];
+static zend_long realpath_shared_cache_size = 0;
+static MUTEX_T realpath_shared_cache_mutex = NULL;
+# define REALPATH_SHARED_CACHE_LOCK()   tsrm_mutex_lock(realpath_shared_cache_mutex)
+# define REALPATH_SHARED_CACHE_UNLOCK() tsrm_mutex_unlock(realpath_shared_cache_mutex)
+#else
+# define REALPATH_SHARED_CACHE_LOCK()
+# define REALPATH_SHARED_CACHE_UNLOCK()
+#endif
+
+/* Bumped whenever the filesystem below a watched directory changes, caches
+ * filled under an older epoch are dropped on their next use. */
+static volatile uint32_t realpath_cache_epoch = 0;
+
 #ifndef ZEND_WIN32
 #include <unistd.h>
 #else
@@ -385,19 +410,32 @@ static int php_is_file_ok(const cwd_state *state)  /* {{{ */
 }
 /* }}} */
 
+static void realpath_cache_table_clean(realpath_cache_bucket **cache, zend_long *cache_size);
+static void realpath_cache_shutdown(void);
+
 static void cwd_globals_ctor(virtual_cwd_globals *cwd_g) /* {{{ */
 {
 	CWD_STATE_COPY(&cwd_g->cwd, &main_cwd_state);
 	cwd_g->realpath_cache_size = 0;
 	cwd_g->realpath_cache_size_limit = REALPATH_CACHE_SIZE;
 	cwd_g->realpath_cache_ttl = REALPATH_CACHE_TTL;
+	cwd_g->realpath_cache_epoch = realpath_cache_epoch;
 	memset(cwd_g->realpath_cache, 0, sizeof(cwd_g->realpath_cache));
+#ifdef ZTS
+	cwd_g->realpath_cache_overflow = NULL;
+#endif
 }
 /* }}} */
 
 static void cwd_globals_dtor(virtual_cwd_globals *cwd_g) /* {{{ */
 {
-	realpath_cache_clean();
+	realpath_cache_table_clean(cwd_g->realpath_cache, &cwd_g->realpath_cache_size);
+#ifdef ZTS
+	if (cwd_g->realpath_cache_overflow) {
+		free(cwd_g->realpath_cache_overflow);
+		cwd_g->realpath_cache_overflow = NULL;
+	}
+#endif
 }
 /* }}} */
 
@@ -443,6 +481,9 @@ CWD_API void virtual_cwd_startup(void) /* {{{ */
 #if (defined(ZEND_WIN32)) && defined(ZTS)
 	cwd_mutex = tsrm_mutex_alloc();
 #endif
+#ifdef ZTS
+	realpath_shared_cache_mutex = tsrm_mutex_alloc();
+#endif
 }
 /* }}} */
 
@@ -454,6 +495,7 @@ CWD_API void virtual_cwd_shutdown(void) /* {{{ */
 #if (defined(ZEND_WIN32)) && defined(ZTS)
 	tsrm_mutex_free(cwd_mutex);
 #endif
+	realpath_cache_shutdown();
 
 	free(main_cwd_state.cwd); /* Don't use CWD_STATE_FREE because the non global states will probably use emalloc()/efree() */
 }
@@ -583,42 +625,41 @@ static inline zend_ulong realpath_cache_key(const char *path, size_t path_len) /
 /* }}} */
 #endif /* defined(ZEND_WIN32) */
 
-CWD_API void realpath_cache_clean(void) /* {{{ */
+#define REALPATH_CACHE_BUCKETS \
+	(sizeof(((virtual_cwd_globals *)0)->realpath_cache) / sizeof(realpath_cache_bucket *))
+
+#define REALPATH_CACHE_BUCKET_SIZE(r) \
+	((r)->path == (r)->realpath ? \
+		sizeof(realpath_cache_bucket) + (r)->path_len + 1 : \
+		sizeof(realpath_cache_bucket) + (r)->path_len + 1 + (r)->realpath_len + 1)
+
+static void realpath_cache_table_clean(realpath_cache_bucket **cache, zend_long *cache_size) /* {{{ */
 {
 	uint32_t i;
 
-	for (i = 0; i < sizeof(CWDG(realpath_cache))/sizeof(CWDG(realpath_cache)[0]); i++) {
-		realpath_cache_bucket *p = CWDG(realpath_cache)[i];
+	for (i = 0; i < REALPATH_CACHE_BUCKETS; i++) {
+		realpath_cache_bucket *p = cache[i];
 		while (p != NULL) {
 			realpath_cache_bucket *r = p;
 			p = p->next;
 			free(r);
 		}
-		CWDG(realpath_cache)[i] = NULL;
+		cache[i] = NULL;
 	}
-	CWDG(realpath_cache_size) = 0;
+	*cache_size = 0;
 }
 /* }}} */
 
-CWD_API void realpath_cache_del(const char *path, size_t path_len) /* {{{ */
+static void realpath_cache_table_del(realpath_cache_bucket **cache, zend_long *cache_size, zend_ulong key, const char *path, size_t path_len) /* {{{ */
 {
-	zend_ulong key = realpath_cache_key(path, path_len);
-	zend_ulong n = key % (sizeof(CWDG(realpath_cache)) / sizeof(CWDG(realpath_cache)[0]));
-	realpath_cache_bucket **bucket = &CWDG(realpath_cache)[n];
+	realpath_cache_bucket **bucket = &cache[key % REALPATH_CACHE_BUCKETS];
 
 	while (*bucket != NULL) {
 		if (key == (*bucket)->key && path_len == (*bucket)->path_len &&
 					memcmp(path, (*bucket)->path, path_len) == 0) {
 			realpath_cache_bucket *r = *bucket;
 			*bucket = (*bucket)->next;
-
-			/* if the pointers match then only subtract the length of the path */
-		   	if(r->path == r->realpath) {
-				CWDG(realpath_cache_size) -= sizeof(realpath_cache_bucket) + r->path_len + 1;
-			} else {
-				CWDG(realpath_cache_size) -= sizeof(realpath_cache_bucket) + r->path_len + 1 + r->realpath_len + 1;
-			}
-
+			*cache_size -= REALPATH_CACHE_BUCKET_SIZE(r);
 			free(r);
 			return;
 		} else {
@@ -628,10 +669,12 @@ CWD_API void realpath_cache_del(const char *path, size_t path_len) /* {{{ */
 }
 /* }}} */
 
-static inline void realpath_cache_add(const char *path, size_t path_len, const char *realpath, size_t realpath_len, int is_dir, time_t t) /* {{{ */
+static realpath_cache_bucket *realpath_cache_table_add(realpath_cache_bucket **cache, zend_long *cache_size, zend_ulong key, const char *path, size_t path_len, const char *realpath, size_t realpath_len, int is_dir, int is_watched, time_t expires) /* {{{ */
 {
 	zend_long size = sizeof(realpath_cache_bucket) + path_len + 1;
 	int same = 1;
+	realpath_cache_bucket *bucket;
+	zend_ulong n;
 
 	if (realpath_len != path_len ||
 		memcmp(path, realpath, path_len) != 0) {
@@ -639,58 +682,52 @@ static inline void realpath_cache_add(const char *path, size_t path_len, const c
 		same = 0;
 	}
 
-	if (CWDG(realpath_cache_size) + size <= CWDG(realpath_cache_size_limit)) {
-		realpath_cache_bucket *bucket = malloc(size);
-		zend_ulong n;
+	if (*cache_size + size > CWDG(realpath_cache_size_limit)) {
+		return NULL;
+	}
 
-		if (bucket == NULL) {
-			return;
-		}
+	bucket = malloc(size);
+	if (bucket == NULL) {
+		return NULL;
+	}
 
-		bucket->key = realpath_cache_key(path, path_len);
-		bucket->path = (char*)bucket + sizeof(realpath_cache_bucket);
-		memcpy(bucket->path, path, path_len+1);
-		bucket->path_len = path_len;
-		if (same) {
-			bucket->realpath = bucket->path;
-		} else {
-			bucket->realpath = bucket->path + (path_len + 1);
-			memcpy(bucket->realpath, realpath, realpath_len+1);
-		}
-		bucket->realpath_len = realpath_len;
-		bucket->is_dir = is_dir > 0;
+	bucket->key = key;
+	bucket->path = (char*)bucket + sizeof(realpath_cache_bucket);
+	memcpy(bucket->path, path, path_len+1);
+	bucket->path_len = path_len;
+	if (same) {
+		bucket->realpath = bucket->path;
+	} else {
+		bucket->realpath = bucket->path + (path_len + 1);
+		memcpy(bucket->realpath, realpath, realpath_len+1);
+	}
+	bucket->realpath_len = realpath_len;
+	bucket->is_dir = is_dir > 0;
+	bucket->is_watched = is_watched > 0;
 #ifdef ZEND_WIN32
-		bucket->is_rvalid   = 0;
-		bucket->is_readable = 0;
-		bucket->is_wvalid   = 0;
-		bucket->is_writable = 0;
+	bucket->is_rvalid   = 0;
+	bucket->is_readable = 0;
+	bucket->is_wvalid   = 0;
+	bucket->is_writable = 0;
 #endif
-		bucket->expires = t + CWDG(realpath_cache_ttl);
-		n = bucket->key % (sizeof(CWDG(realpath_cache)) / sizeof(CWDG(realpath_cache)[0]));
-		bucket->next = CWDG(realpath_cache)[n];
-		CWDG(realpath_cache)[n] = bucket;
-		CWDG(realpath_cache_size) += size;
-	}
+	bucket->expires = expires;
+	n = key % REALPATH_CACHE_BUCKETS;
+	bucket->next = cache[n];
+	cache[n] = bucket;
+	*cache_size += size;
+	return bucket;
 }
 /* }}} */
 
-static inline realpath_cache_bucket* realpath_cache_find(const char *path, size_t path_len, time_t t) /* {{{ */
+static realpath_cache_bucket *realpath_cache_table_find(realpath_cache_bucket **cache, zend_long *cache_size, zend_ulong key, const char *path, size_t path_len, time_t t) /* {{{ */
 {
-	zend_ulong key = realpath_cache_key(path, path_len);
-	zend_ulong n = key % (sizeof(CWDG(realpath_cache)) / sizeof(CWDG(realpath_cache)[0]));
-	realpath_cache_bucket **bucket = &CWDG(realpath_cache)[n];
+	realpath_cache_bucket **bucket = &cache[key % REALPATH_CACHE_BUCKETS];
 
 	while (*bucket != NULL) {
-		if (CWDG(realpath_cache_ttl) && (*bucket)->expires < t) {
+		if (CWDG(realpath_cache_ttl) && !(*bucket)->is_watched && (*bucket)->expires < t) {
 			realpath_cache_bucket *r = *bucket;
 			*bucket = (*bucket)->next;
-
-			/* if the pointers match then only subtract the length of the path */
-		   	if(r->path == r->realpath) {
-				CWDG(realpath_cache_size) -= sizeof(realpath_cache_bucket) + r->path_len + 1;
-			} else {
-				CWDG(realpath_cache_size) -= sizeof(realpath_cache_bucket) + r->path_len + 1 + r->realpath_len + 1;
-			}
+			*cache_size -= REALPATH_CACHE_BUCKET_SIZE(r);
 			free(r);
 		} else if (key == (*bucket)->key && path_len == (*bucket)->path_len &&
 					memcmp(path, (*bucket)->path, path_len) == 0) {
@@ -703,8 +740,254 @@ static inline realpath_cache_bucket* realpath_cache_find(const char *path, size_
 }
 /* }}} */
 
+
+#if REALPATH_CACHE_USE_INOTIFY
+/* The parent directory of every cached path is watched, cached entries then
+ * stay valid until a watched directory really changes instead of until the
+ * TTL expires. The queue is drained at most once per second, so a new, renamed
+ * or unlinked entry is picked up by the cache within that second. Entries whose
+ * directory can't be watched (e.g. when fs.inotify.max_user_watches is
+ * exhausted) keep using the TTL. Every change drops all watches along with the
+ * cached entries, the directories of the paths cached again are then watched
+ * again. */
+#define REALPATH_CACHE_INOTIFY_MASK \
+	(IN_CREATE | IN_DELETE | IN_DELETE_SELF | IN_MOVE_SELF | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR)
+
+static int realpath_cache_inotify_fd = -1;
+static pid_t realpath_cache_inotify_pid = 0;
+static int realpath_cache_inotify_max_wd = 0;
+static time_t realpath_cache_inotify_polled = 0;
+
+/* Drops all watches by starting over with a new inotify instance, the caller
+ * holds the shared cache lock. */
+static void realpath_cache_inotify_reset(void) /* {{{ */
+{
+	if (realpath_cache_inotify_fd >= 0 && realpath_cache_inotify_pid == getpid()) {
+		close(realpath_cache_inotify_fd);
+	}
+	realpath_cache_inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	realpath_cache_inotify_pid = getpid();
+	realpath_cache_inotify_max_wd = 0;
+}
+/* }}} */
+
+static void realpath_cache_inotify_poll(void) /* {{{ */
+{
+	char buf[4096];
+	time_t now = time(0);
+	int changed = 0;
+	ssize_t n;
+
+	if (EXPECTED(realpath_cache_inotify_polled == now)) {
+		return;
+	}
+	REALPATH_SHARED_CACHE_LOCK();
+	if (realpath_cache_inotify_polled != now) {
+		realpath_cache_inotify_polled = now;
+		if (realpath_cache_inotify_pid != getpid()) {
+			/* a forked child must not drain the queue of its parent */
+			changed = realpath_cache_inotify_fd >= 0;
+			realpath_cache_inotify_reset();
+		} else if (realpath_cache_inotify_fd >= 0) {
+			while ((n = read(realpath_cache_inotify_fd, buf, sizeof(buf))) > 0) {
+				changed = 1;
+			}
+			if (changed) {
+				realpath_cache_inotify_reset();
+			}
+		}
+		if (changed) {
+#ifdef ZTS
+			realpath_cache_table_clean(realpath_shared_cache, &realpath_shared_cache_size);
+#endif
+			realpath_cache_epoch++;
+		}
+	}
+	REALPATH_SHARED_CACHE_UNLOCK();
+}
+/* }}} */
+
+/* Returns 1 when the parent directory of path was already watched before the
+ * path got resolved, so a change in between can't have been missed. */
+static int realpath_cache_inotify_watch(const char *path, size_t path_len) /* {{{ */
+{
+	char dir[MAXPATHLEN];
+	size_t dir_len = path_len;
+	int wd, watched = 0;
+
+	while (dir_len > 0 && !IS_SLASH(path[dir_len - 1])) {
+		dir_len--;
+	}
+	if (dir_len > 1) {
+		dir_len--;
+	}
+	if (dir_len == 0 || dir_len >= MAXPATHLEN) {
+		return 0;
+	}
+	memcpy(dir, path, dir_len);
+	dir[dir_len] = '\0';
+
+	REALPATH_SHARED_CACHE_LOCK();
+	if (realpath_cache_inotify_fd >= 0 && realpath_cache_inotify_pid == getpid()) {
+		wd = inotify_add_watch(realpath_cache_inotify_fd, dir, REALPATH_CACHE_INOTIFY_MASK);
+		if (wd > 0) {
+			/* watch descriptors are handed out in increasing order */
+			watched = wd <= realpath_cache_inotify_max_wd;
+			if (wd > realpath_cache_inotify_max_wd) {
+				realpath_cache_inotify_max_wd = wd;
+			}
+		}
+	}
+	REALPATH_SHARED_CACHE_UNLOCK();
+	return watched;
+}
+/* }}} */
+#endif
+
+static void realpath_cache_shutdown(void) /* {{{ */
+{
+#ifdef ZTS
+	realpath_cache_table_clean(realpath_shared_cache, &realpath_shared_cache_size);
+	tsrm_mutex_free(realpath_shared_cache_mutex);
+	realpath_shared_cache_mutex = NULL;
+#endif
+#if REALPATH_CACHE_USE_INOTIFY
+	if (realpath_cache_inotify_fd >= 0 && realpath_cache_inotify_pid == getpid()) {
+		close(realpath_cache_inotify_fd);
+	}
+	realpath_cache_inotify_fd = -1;
+	realpath_cache_inotify_pid = 0;
+#endif
+}
+/* }}} */
+
+static void realpath_cache_sync(void) /* {{{ */
+{
+#if REALPATH_CACHE_USE_INOTIFY
+	realpath_cache_inotify_poll();
+#endif
+	if (UNEXPECTED(CWDG(realpath_cache_epoch) != realpath_cache_epoch)) {
+		realpath_cache_table_clean(CWDG(realpath_cache), &CWDG(realpath_cache_size));
+		CWDG(realpath_cache_epoch) = realpath_cache_epoch;
+	}
+}
+/* }}} */
+
+CWD_API void realpath_cache_clean(void) /* {{{ */
+{
+	realpath_cache_table_clean(CWDG(realpath_cache), &CWDG(realpath_cache_size));
+	REALPATH_SHARED_CACHE_LOCK();
+#ifdef ZTS
+	realpath_cache_table_clean(realpath_shared_cache, &realpath_shared_cache_size);
+#endif
+#if REALPATH_CACHE_USE_INOTIFY
+	if (realpath_cache_inotify_pid == getpid()) {
+		realpath_cache_inotify_reset();
+	}
+#endif
+	/* the other threads drop their entries too, their watches are gone */
+	realpath_cache_epoch++;
+	CWDG(realpath_cache_epoch) = realpath_cache_epoch;
+	REALPATH_SHARED_CACHE_UNLOCK();
+}
+/* }}} */
+
+CWD_API void realpath_cache_del(const char *path, size_t path_len) /* {{{ */
+{
+	zend_ulong key = realpath_cache_key(path, path_len);
+
+	realpath_cache_table_del(CWDG(realpath_cache), &CWDG(realpath_cache_size), key, path, path_len);
+#ifdef ZTS
+	REALPATH_SHARED_CACHE_LOCK();
+	realpath_cache_table_del(realpath_shared_cache, &realpath_shared_cache_size, key, path, path_len);
+	REALPATH_SHARED_CACHE_UNLOCK();
+#endif
+}
+/* }}} */
+
+static inline void realpath_cache_add(const char *path, size_t path_len, const char *realpath, size_t realpath_len, int is_dir, time_t t) /* {{{ */
+{
+	zend_ulong key = realpath_cache_key(path, path_len);
+	time_t expires = t + CWDG(realpath_cache_ttl);
+	int is_watched = 0;
+
+	if (CWDG(realpath_cache_epoch) != realpath_cache_epoch) {
+		/* the path was resolved before the last change was noticed */
+		return;
+	}
+#if REALPATH_CACHE_USE_INOTIFY
+	is_watched = realpath_cache_inotify_watch(path, path_len);
+#endif
+	realpath_cache_table_add(CWDG(realpath_cache), &CWDG(realpath_cache_size),
+		key, path, path_len, realpath, realpath_len, is_dir, is_watched, expires);
+#ifdef ZTS
+	REALPATH_SHARED_CACHE_LOCK();
+	if (CWDG(realpath_cache_epoch) == realpath_cache_epoch &&
+			!realpath_cache_table_find(realpath_shared_cache, &realpath_shared_cache_size, key, path, path_len, t)) {
+		realpath_cache_table_add(realpath_shared_cache, &realpath_shared_cache_size,
+			key, path, path_len, realpath, realpath_len, is_dir, is_watched, expires);
+	}
+	REALPATH_SHARED_CACHE_UNLOCK();
+#endif
+}
+/* }}} */
+
+#ifdef ZTS
+static realpath_cache_bucket *realpath_cache_bucket_copy(const realpath_cache_bucket *bucket, realpath_cache_bucket *old) /* {{{ */
+{
+	size_t size = REALPATH_CACHE_BUCKET_SIZE(bucket);
+	realpath_cache_bucket *copy = realloc(old, size);
+
+	if (copy == NULL) {
+		free(old);
+		return NULL;
+	}
+	memcpy(copy, bucket, size);
+	copy->path = (char*)copy + sizeof(realpath_cache_bucket);
+	if (bucket->path == bucket->realpath) {
+		copy->realpath = copy->path;
+	} else {
+		copy->realpath = copy->path + (bucket->path_len + 1);
+	}
+	copy->next = NULL;
+	return copy;
+}
+/* }}} */
+#endif
+
+static inline realpath_cache_bucket* realpath_cache_find(const char *path, size_t path_len, time_t t) /* {{{ */
+{
+	zend_ulong key = realpath_cache_key(path, path_len);
+	realpath_cache_bucket *bucket;
+
+	bucket = realpath_cache_table_find(CWDG(realpath_cache), &CWDG(realpath_cache_size), key, path, path_len, t);
+#ifdef ZTS
+	if (bucket == NULL) {
+		realpath_cache_bucket *shared;
+
+		REALPATH_SHARED_CACHE_LOCK();
+		shared = realpath_cache_table_find(realpath_shared_cache, &realpath_shared_cache_size, key, path, path_len, t);
+		if (shared != NULL) {
+			bucket = realpath_cache_table_add(CWDG(realpath_cache), &CWDG(realpath_cache_size),
+				key, shared->path, shared->path_len, shared->realpath, shared->realpath_len,
+				shared->is_dir, shared->is_watched, shared->expires);
+			if (bucket == NULL) {
+				/* the thread's table is full, hand out a copy that lives
+				 * until the next such miss */
+				bucket = realpath_cache_bucket_copy(shared, CWDG(realpath_cache_overflow));
+				CWDG(realpath_cache_overflow) = bucket;
+			}
+		}
+		REALPATH_SHARED_CACHE_UNLOCK();
+	}
+#endif
+	return bucket;
+}
+/* }}} */
+
 CWD_API realpath_cache_bucket* realpath_cache_lookup(const char *path, size_t path_len, time_t t) /* {{{ */
 {
+	realpath_cache_sync();
 	return realpath_cache_find(path, path_len, t);
 }
 /* }}} */
@@ -716,7 +999,7 @@ CWD_API zend_long realpath_cache_size(void)
 
 CWD_API zend_long realpath_cache_max_buckets(void)
 {
-	return (sizeof(CWDG(realpath_cache)) / sizeof(CWDG(realpath_cache)[0]));
+	return REALPATH_CACHE_BUCKETS;
 }
 
 CWD_API realpath_cache_bucket** realpath_cache_get_buckets(void)
@@ -1368,6 +1651,9 @@ CWD_API int virtual_file_ex(cwd_state *state, const char *path, verify_path_func
 
 	add_slash = (use_realpath != CWD_REALPATH) && path_length > 0 && IS_SLASH(resolved_path[path_length-1]);
 	t = CWDG(realpath_cache_ttl) ? 0 : -1;
+	if (CWDG(realpath_cache_size_limit)) {
+		realpath_cache_sync();
+	}
 #ifdef ZEND_WIN32
 	if (CWD_EXPAND != use_realpath) {
 		size_t tmp_len = tsrm_win32_realpath_quick(resolved_path, path_length, &t);
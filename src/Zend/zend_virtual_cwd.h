@@ -190,6 +190,7 @@ typedef struct _realpath_cache_bucket {
 	uint16_t                       path_len;
 	uint16_t                       realpath_len;
 	uint8_t                        is_dir:1;
+	uint8_t                        is_watched:1; /* invalidated by inotify, not by the TTL */
 #ifdef ZEND_WIN32
 	uint8_t                        is_rvalid:1;
 	uint8_t                        is_readable:1;
@@ -203,7 +204,11 @@ typedef struct _virtual_cwd_globals {
 	zend_long                   realpath_cache_size;
 	zend_long                   realpath_cache_size_limit;
 	zend_long                   realpath_cache_ttl;
+	uint32_t                    realpath_cache_epoch;
 	realpath_cache_bucket *realpath_cache[1024];
+#ifdef ZTS
+	realpath_cache_bucket *realpath_cache_overflow; /* shared hit that didn't fit */
+#endif
 } virtual_cwd_globals;
 
 #ifdef ZTS
@@ -1538,7 +1538,7 @@ ZEND_VM_HELPER(zend_fetch_static_prop_helper, CONST|TMPVAR|CV, UNUSED|CONST|VAR,
 				ce = Z_CE_P(EX_VAR(opline->op2.var));
 			}
 			if (OP1_TYPE == IS_CONST &&
-			    EXPECTED(CACHED_PTR(opline->extended_value) == ce)) {
+			    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, ce))) {
 				retval = CACHED_PTR(opline->extended_value + sizeof(void*));
 				break;
 			}
@@ -1807,7 +1807,7 @@ ZEND_VM_HOT_OBJ_HANDLER(82, ZEND_FETCH_OBJ_R, CONST|TMPVAR|UNUSED|THIS|CV, CONST
 		if (OP2_TYPE == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -1951,7 +1951,7 @@ ZEND_VM_COLD_CONST_HANDLER(91, ZEND_FETCH_OBJ_IS, CONST|TMPVAR|UNUSED|THIS|CV, C
 		if (OP2_TYPE == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -2112,7 +2112,7 @@ ZEND_VM_HANDLER(136, ZEND_ASSIGN_OBJ, VAR|UNUSED|THIS|CV, CONST|TMPVAR|CV, CACHE
 
 ZEND_VM_C_LABEL(assign_object):
 	if (OP2_TYPE == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -2223,7 +2223,7 @@ ZEND_VM_C_LABEL(try_assign_dim_array):
 			if (OP_DATA_TYPE == IS_CV || OP_DATA_TYPE == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 				FREE_OP_DATA();
 				zend_cannot_add_element();
@@ -3067,7 +3067,7 @@ ZEND_VM_HOT_OBJ_HANDLER(112, ZEND_INIT_METHOD_CALL, CONST|TMPVAR|UNUSED|THIS|CV,
 	called_scope = obj->ce;
 
 	if (OP2_TYPE == IS_CONST &&
-	    EXPECTED(CACHED_PTR(opline->result.num) == called_scope)) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, called_scope))) {
 	    fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else {
 	    zend_object *orig_obj = obj;
@@ -3176,7 +3176,7 @@ ZEND_VM_HANDLER(113, ZEND_INIT_STATIC_METHOD_CALL, UNUSED|CLASS_FETCH|CONST|VAR,
 		/* nothing to do */
 	} else if (OP1_TYPE != IS_CONST &&
 	           OP2_TYPE == IS_CONST &&
-	           EXPECTED(CACHED_PTR(opline->result.num) == ce)) {
+	           EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, ce))) {
 		fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else if (OP2_TYPE != IS_UNUSED) {
 		zend_free_op free_op2;
@@ -5110,7 +5110,7 @@ ZEND_VM_HANDLER(181, ZEND_FETCH_CLASS_CONSTANT, VAR|CONST|UNUSED|CLASS_FETCH, CO
 			} else {
 				ce = Z_CE_P(EX_VAR(opline->op1.var));
 			}
-			if (EXPECTED(CACHED_PTR(opline->extended_value) == ce)) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, ce))) {
 				value = CACHED_PTR(opline->extended_value + sizeof(void*));
 				break;
 			}
@@ -5232,7 +5232,7 @@ ZEND_VM_C_LABEL(num_index):
 		}
 		FREE_OP2();
 	} else {
-		if (!zend_hash_next_index_insert(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
+		if (!zend_hash_next_index_insert_fast(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
 			zend_cannot_add_element();
 			zval_ptr_dtor_nogc(expr_ptr);
 		}
@@ -5837,35 +5837,55 @@ ZEND_VM_HANDLER(78, ZEND_FE_FETCH_R, VAR, ANY, JMP_ADDR)
 		fe_ht = Z_ARRVAL_P(array);
 		pos = Z_FE_POS_P(array);
 		p = fe_ht->arData + pos;
-		while (1) {
-			if (UNEXPECTED(pos >= fe_ht->nNumUsed)) {
-				/* reached end of iteration */
-ZEND_VM_C_LABEL(fe_fetch_r_exit):
-				ZEND_VM_SET_RELATIVE_OPCODE(opline, opline->extended_value);
-				ZEND_VM_CONTINUE();
+		if (HT_FLAGS(fe_ht) & HASH_FLAG_PACKED) {
+			/* packed arrays have neither INDIRECT values nor string keys */
+			while (1) {
+				if (UNEXPECTED(pos >= fe_ht->nNumUsed)) {
+					ZEND_VM_C_GOTO(fe_fetch_r_exit);
+				}
+				value = &p->val;
+				value_type = Z_TYPE_INFO_P(value);
+				if (EXPECTED(value_type != IS_UNDEF)) {
+					break;
+				}
+				pos++;
+				p++;
 			}
-			value = &p->val;
-			value_type = Z_TYPE_INFO_P(value);
-			if (EXPECTED(value_type != IS_UNDEF)) {
-				if (UNEXPECTED(value_type == IS_INDIRECT)) {
-					value = Z_INDIRECT_P(value);
-					value_type = Z_TYPE_INFO_P(value);
-					if (EXPECTED(value_type != IS_UNDEF)) {
+			Z_FE_POS_P(array) = pos + 1;
+			if (RETURN_VALUE_USED(opline)) {
+				ZVAL_LONG(EX_VAR(opline->result.var), pos);
+			}
+		} else {
+			while (1) {
+				if (UNEXPECTED(pos >= fe_ht->nNumUsed)) {
+					/* reached end of iteration */
+ZEND_VM_C_LABEL(fe_fetch_r_exit):
+					ZEND_VM_SET_RELATIVE_OPCODE(opline, opline->extended_value);
+					ZEND_VM_CONTINUE();
+				}
+				value = &p->val;
+				value_type = Z_TYPE_INFO_P(value);
+				if (EXPECTED(value_type != IS_UNDEF)) {
+					if (UNEXPECTED(value_type == IS_INDIRECT)) {
+						value = Z_INDIRECT_P(value);
+						value_type = Z_TYPE_INFO_P(value);
+						if (EXPECTED(value_type != IS_UNDEF)) {
+							break;
+						}
+					} else {
 						break;
 					}
-				} else {
-					break;
 				}
+				pos++;
+				p++;
 			}
-			pos++;
-			p++;
-		}
-		Z_FE_POS_P(array) = pos + 1;
-		if (RETURN_VALUE_USED(opline)) {
-			if (!p->key) {
-				ZVAL_LONG(EX_VAR(opline->result.var), p->h);
-			} else {
-				ZVAL_STR_COPY(EX_VAR(opline->result.var), p->key);
+			Z_FE_POS_P(array) = pos + 1;
+			if (RETURN_VALUE_USED(opline)) {
+				if (!p->key) {
+					ZVAL_LONG(EX_VAR(opline->result.var), p->h);
+				} else {
+					ZVAL_STR_COPY(EX_VAR(opline->result.var), p->key);
+				}
 			}
 		}
 	} else {
@@ -6250,7 +6270,7 @@ ZEND_VM_HANDLER(180, ZEND_ISSET_ISEMPTY_STATIC_PROP, CONST|TMPVAR|CV, UNUSED|CLA
 			ce = Z_CE_P(EX_VAR(opline->op2.var));
 		}
 		if (OP1_TYPE == IS_CONST &&
-		    EXPECTED(CACHED_PTR(opline->extended_value & ~ZEND_ISEMPTY) == ce)) {
+		    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value & ~ZEND_ISEMPTY, ce))) {
 
 			value = CACHED_PTR((opline->extended_value & ~ZEND_ISEMPTY) + sizeof(void*));
 			ZEND_VM_C_GOTO(is_static_prop_return);
@@ -8824,34 +8844,55 @@ ZEND_VM_HOT_TYPE_SPEC_HANDLER(ZEND_FE_FETCH_R, op->op2_type == IS_CV && (op1_inf
 	fe_ht = Z_ARRVAL_P(array);
 	pos = Z_FE_POS_P(array);
 	p = fe_ht->arData + pos;
-	while (1) {
-		if (UNEXPECTED(pos >= fe_ht->nNumUsed)) {
-			/* reached end of iteration */
-			ZEND_VM_SET_RELATIVE_OPCODE(opline, opline->extended_value);
-			ZEND_VM_CONTINUE();
+	if (HT_FLAGS(fe_ht) & HASH_FLAG_PACKED) {
+		/* packed arrays have neither INDIRECT values nor string keys */
+		while (1) {
+			if (UNEXPECTED(pos >= fe_ht->nNumUsed)) {
+				/* reached end of iteration */
+				ZEND_VM_SET_RELATIVE_OPCODE(opline, opline->extended_value);
+				ZEND_VM_CONTINUE();
+			}
+			value = &p->val;
+			if (EXPECTED(Z_TYPE_INFO_P(value) != IS_UNDEF)) {
+				break;
+			}
+			pos++;
+			p++;
 		}
-		value = &p->val;
-		value_type = Z_TYPE_INFO_P(value);
-		if (EXPECTED(value_type != IS_UNDEF)) {
-			if (UNEXPECTED(value_type == IS_INDIRECT)) {
-				value = Z_INDIRECT_P(value);
-				value_type = Z_TYPE_INFO_P(value);
-				if (EXPECTED(value_type != IS_UNDEF)) {
+		Z_FE_POS_P(array) = pos + 1;
+		if (RETURN_VALUE_USED(opline)) {
+			ZVAL_LONG(EX_VAR(opline->result.var), pos);
+		}
+	} else {
+		while (1) {
+			if (UNEXPECTED(pos >= fe_ht->nNumUsed)) {
+				/* reached end of iteration */
+				ZEND_VM_SET_RELATIVE_OPCODE(opline, opline->extended_value);
+				ZEND_VM_CONTINUE();
+			}
+			value = &p->val;
+			value_type = Z_TYPE_INFO_P(value);
+			if (EXPECTED(value_type != IS_UNDEF)) {
+				if (UNEXPECTED(value_type == IS_INDIRECT)) {
+					value = Z_INDIRECT_P(value);
+					value_type = Z_TYPE_INFO_P(value);
+					if (EXPECTED(value_type != IS_UNDEF)) {
+						break;
+					}
+				} else {
 					break;
 				}
-			} else {
-				break;
 			}
+			pos++;
+			p++;
 		}
-		pos++;
-		p++;
-	}
-	Z_FE_POS_P(array) = pos + 1;
-	if (RETURN_VALUE_USED(opline)) {
-		if (!p->key) {
-			ZVAL_LONG(EX_VAR(opline->result.var), p->h);
-		} else {
-			ZVAL_STR_COPY(EX_VAR(opline->result.var), p->key);
+		Z_FE_POS_P(array) = pos + 1;
+		if (RETURN_VALUE_USED(opline)) {
+			if (!p->key) {
+				ZVAL_LONG(EX_VAR(opline->result.var), p->h);
+			} else {
+				ZVAL_STR_COPY(EX_VAR(opline->result.var), p->key);
+			}
 		}
 	}
 
@@ -4554,7 +4554,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL zend_fetch_static_prop_helper_SPEC_
 				ce = Z_CE_P(EX_VAR(opline->op2.var));
 			}
 			if (IS_CONST == IS_CONST &&
-			    EXPECTED(CACHED_PTR(opline->extended_value) == ce)) {
+			    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, ce))) {
 				retval = CACHED_PTR(opline->extended_value + sizeof(void*));
 				break;
 			}
@@ -4747,7 +4747,7 @@ static ZEND_VM_COLD ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_OBJ_R_SPEC_
 		if (IS_CONST == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -4845,7 +4845,7 @@ static ZEND_VM_COLD ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_OBJ_IS_SPEC
 		if (IS_CONST == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -5117,7 +5117,7 @@ static ZEND_VM_COLD ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_INIT_METHOD_CALL_
 	called_scope = obj->ce;
 
 	if (IS_CONST == IS_CONST &&
-	    EXPECTED(CACHED_PTR(opline->result.num) == called_scope)) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, called_scope))) {
 	    fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else {
 	    zend_object *orig_obj = obj;
@@ -5225,7 +5225,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_INIT_STATIC_METHOD_CALL_SPEC_C
 		/* nothing to do */
 	} else if (IS_CONST != IS_CONST &&
 	           IS_CONST == IS_CONST &&
-	           EXPECTED(CACHED_PTR(opline->result.num) == ce)) {
+	           EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, ce))) {
 		fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else if (IS_CONST != IS_UNUSED) {
 
@@ -5431,7 +5431,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_CLASS_CONSTANT_SPEC_CONS
 			} else {
 				ce = Z_CE_P(EX_VAR(opline->op1.var));
 			}
-			if (EXPECTED(CACHED_PTR(opline->extended_value) == ce)) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, ce))) {
 				value = CACHED_PTR(opline->extended_value + sizeof(void*));
 				break;
 			}
@@ -5553,7 +5553,7 @@ num_index:
 		}
 
 	} else {
-		if (!zend_hash_next_index_insert(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
+		if (!zend_hash_next_index_insert_fast(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
 			zend_cannot_add_element();
 			zval_ptr_dtor_nogc(expr_ptr);
 		}
@@ -5675,7 +5675,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ISSET_ISEMPTY_STATIC_PROP_SPEC
 			ce = Z_CE_P(EX_VAR(opline->op2.var));
 		}
 		if (IS_CONST == IS_CONST &&
-		    EXPECTED(CACHED_PTR(opline->extended_value & ~ZEND_ISEMPTY) == ce)) {
+		    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value & ~ZEND_ISEMPTY, ce))) {
 
 			value = CACHED_PTR((opline->extended_value & ~ZEND_ISEMPTY) + sizeof(void*));
 			goto is_static_prop_return;
@@ -6922,7 +6922,7 @@ static ZEND_VM_COLD ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_OBJ_R_SPEC_
 		if ((IS_TMP_VAR|IS_VAR) == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -7021,7 +7021,7 @@ static ZEND_VM_COLD ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_OBJ_IS_SPEC
 		if ((IS_TMP_VAR|IS_VAR) == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -7294,7 +7294,7 @@ static ZEND_VM_COLD ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_INIT_METHOD_CALL_
 	called_scope = obj->ce;
 
 	if ((IS_TMP_VAR|IS_VAR) == IS_CONST &&
-	    EXPECTED(CACHED_PTR(opline->result.num) == called_scope)) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, called_scope))) {
 	    fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else {
 	    zend_object *orig_obj = obj;
@@ -7402,7 +7402,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_INIT_STATIC_METHOD_CALL_SPEC_C
 		/* nothing to do */
 	} else if (IS_CONST != IS_CONST &&
 	           (IS_TMP_VAR|IS_VAR) == IS_CONST &&
-	           EXPECTED(CACHED_PTR(opline->result.num) == ce)) {
+	           EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, ce))) {
 		fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else if ((IS_TMP_VAR|IS_VAR) != IS_UNUSED) {
 		zend_free_op free_op2;
@@ -7660,7 +7660,7 @@ num_index:
 		}
 		zval_ptr_dtor_nogc(free_op2);
 	} else {
-		if (!zend_hash_next_index_insert(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
+		if (!zend_hash_next_index_insert_fast(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
 			zend_cannot_add_element();
 			zval_ptr_dtor_nogc(expr_ptr);
 		}
@@ -7986,7 +7986,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL zend_fetch_static_prop_helper_SPEC_
 				ce = Z_CE_P(EX_VAR(opline->op2.var));
 			}
 			if (IS_CONST == IS_CONST &&
-			    EXPECTED(CACHED_PTR(opline->extended_value) == ce)) {
+			    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, ce))) {
 				retval = CACHED_PTR(opline->extended_value + sizeof(void*));
 				break;
 			}
@@ -8161,7 +8161,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ISSET_ISEMPTY_STATIC_PROP_SPEC
 			ce = Z_CE_P(EX_VAR(opline->op2.var));
 		}
 		if (IS_CONST == IS_CONST &&
-		    EXPECTED(CACHED_PTR(opline->extended_value & ~ZEND_ISEMPTY) == ce)) {
+		    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value & ~ZEND_ISEMPTY, ce))) {
 
 			value = CACHED_PTR((opline->extended_value & ~ZEND_ISEMPTY) + sizeof(void*));
 			goto is_static_prop_return;
@@ -8497,7 +8497,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL zend_fetch_static_prop_helper_SPEC_
 				ce = Z_CE_P(EX_VAR(opline->op2.var));
 			}
 			if (IS_CONST == IS_CONST &&
-			    EXPECTED(CACHED_PTR(opline->extended_value) == ce)) {
+			    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, ce))) {
 				retval = CACHED_PTR(opline->extended_value + sizeof(void*));
 				break;
 			}
@@ -8635,7 +8635,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_INIT_STATIC_METHOD_CALL_SPEC_C
 		/* nothing to do */
 	} else if (IS_CONST != IS_CONST &&
 	           IS_UNUSED == IS_CONST &&
-	           EXPECTED(CACHED_PTR(opline->result.num) == ce)) {
+	           EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, ce))) {
 		fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else if (IS_UNUSED != IS_UNUSED) {
 
@@ -8941,7 +8941,7 @@ num_index:
 		}
 
 	} else {
-		if (!zend_hash_next_index_insert(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
+		if (!zend_hash_next_index_insert_fast(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
 			zend_cannot_add_element();
 			zval_ptr_dtor_nogc(expr_ptr);
 		}
@@ -9143,7 +9143,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ISSET_ISEMPTY_STATIC_PROP_SPEC
 			ce = Z_CE_P(EX_VAR(opline->op2.var));
 		}
 		if (IS_CONST == IS_CONST &&
-		    EXPECTED(CACHED_PTR(opline->extended_value & ~ZEND_ISEMPTY) == ce)) {
+		    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value & ~ZEND_ISEMPTY, ce))) {
 
 			value = CACHED_PTR((opline->extended_value & ~ZEND_ISEMPTY) + sizeof(void*));
 			goto is_static_prop_return;
@@ -10020,7 +10020,7 @@ static ZEND_VM_COLD ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_OBJ_R_SPEC_
 		if (IS_CV == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -10118,7 +10118,7 @@ static ZEND_VM_COLD ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_OBJ_IS_SPEC
 		if (IS_CV == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -10390,7 +10390,7 @@ static ZEND_VM_COLD ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_INIT_METHOD_CALL_
 	called_scope = obj->ce;
 
 	if (IS_CV == IS_CONST &&
-	    EXPECTED(CACHED_PTR(opline->result.num) == called_scope)) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, called_scope))) {
 	    fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else {
 	    zend_object *orig_obj = obj;
@@ -10498,7 +10498,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_INIT_STATIC_METHOD_CALL_SPEC_C
 		/* nothing to do */
 	} else if (IS_CONST != IS_CONST &&
 	           IS_CV == IS_CONST &&
-	           EXPECTED(CACHED_PTR(opline->result.num) == ce)) {
+	           EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, ce))) {
 		fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else if (IS_CV != IS_UNUSED) {
 
@@ -10755,7 +10755,7 @@ num_index:
 		}
 
 	} else {
-		if (!zend_hash_next_index_insert(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
+		if (!zend_hash_next_index_insert_fast(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
 			zend_cannot_add_element();
 			zval_ptr_dtor_nogc(expr_ptr);
 		}
@@ -13596,7 +13596,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL zend_fetch_static_prop_helper_SPEC_
 				ce = Z_CE_P(EX_VAR(opline->op2.var));
 			}
 			if ((IS_TMP_VAR|IS_VAR) == IS_CONST &&
-			    EXPECTED(CACHED_PTR(opline->extended_value) == ce)) {
+			    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, ce))) {
 				retval = CACHED_PTR(opline->extended_value + sizeof(void*));
 				break;
 			}
@@ -13775,7 +13775,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_OBJ_R_SPEC_TMPVAR_CONST_
 		if (IS_CONST == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -13873,7 +13873,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_OBJ_IS_SPEC_TMPVAR_CONST
 		if (IS_CONST == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -14118,7 +14118,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_INIT_METHOD_CALL_SPEC_TMPVAR_C
 	called_scope = obj->ce;
 
 	if (IS_CONST == IS_CONST &&
-	    EXPECTED(CACHED_PTR(opline->result.num) == called_scope)) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, called_scope))) {
 	    fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else {
 	    zend_object *orig_obj = obj;
@@ -14335,7 +14335,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ISSET_ISEMPTY_STATIC_PROP_SPEC
 			ce = Z_CE_P(EX_VAR(opline->op2.var));
 		}
 		if ((IS_TMP_VAR|IS_VAR) == IS_CONST &&
-		    EXPECTED(CACHED_PTR(opline->extended_value & ~ZEND_ISEMPTY) == ce)) {
+		    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value & ~ZEND_ISEMPTY, ce))) {
 
 			value = CACHED_PTR((opline->extended_value & ~ZEND_ISEMPTY) + sizeof(void*));
 			goto is_static_prop_return;
@@ -15383,7 +15383,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_OBJ_R_SPEC_TMPVAR_TMPVAR
 		if ((IS_TMP_VAR|IS_VAR) == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -15482,7 +15482,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_OBJ_IS_SPEC_TMPVAR_TMPVA
 		if ((IS_TMP_VAR|IS_VAR) == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -15728,7 +15728,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_INIT_METHOD_CALL_SPEC_TMPVAR_T
 	called_scope = obj->ce;
 
 	if ((IS_TMP_VAR|IS_VAR) == IS_CONST &&
-	    EXPECTED(CACHED_PTR(opline->result.num) == called_scope)) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, called_scope))) {
 	    fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else {
 	    zend_object *orig_obj = obj;
@@ -16012,7 +16012,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL zend_fetch_static_prop_helper_SPEC_
 				ce = Z_CE_P(EX_VAR(opline->op2.var));
 			}
 			if ((IS_TMP_VAR|IS_VAR) == IS_CONST &&
-			    EXPECTED(CACHED_PTR(opline->extended_value) == ce)) {
+			    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, ce))) {
 				retval = CACHED_PTR(opline->extended_value + sizeof(void*));
 				break;
 			}
@@ -16188,7 +16188,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ISSET_ISEMPTY_STATIC_PROP_SPEC
 			ce = Z_CE_P(EX_VAR(opline->op2.var));
 		}
 		if ((IS_TMP_VAR|IS_VAR) == IS_CONST &&
-		    EXPECTED(CACHED_PTR(opline->extended_value & ~ZEND_ISEMPTY) == ce)) {
+		    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value & ~ZEND_ISEMPTY, ce))) {
 
 			value = CACHED_PTR((opline->extended_value & ~ZEND_ISEMPTY) + sizeof(void*));
 			goto is_static_prop_return;
@@ -16437,7 +16437,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL zend_fetch_static_prop_helper_SPEC_
 				ce = Z_CE_P(EX_VAR(opline->op2.var));
 			}
 			if ((IS_TMP_VAR|IS_VAR) == IS_CONST &&
-			    EXPECTED(CACHED_PTR(opline->extended_value) == ce)) {
+			    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, ce))) {
 				retval = CACHED_PTR(opline->extended_value + sizeof(void*));
 				break;
 			}
@@ -16694,7 +16694,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ISSET_ISEMPTY_STATIC_PROP_SPEC
 			ce = Z_CE_P(EX_VAR(opline->op2.var));
 		}
 		if ((IS_TMP_VAR|IS_VAR) == IS_CONST &&
-		    EXPECTED(CACHED_PTR(opline->extended_value & ~ZEND_ISEMPTY) == ce)) {
+		    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value & ~ZEND_ISEMPTY, ce))) {
 
 			value = CACHED_PTR((opline->extended_value & ~ZEND_ISEMPTY) + sizeof(void*));
 			goto is_static_prop_return;
@@ -17262,7 +17262,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_OBJ_R_SPEC_TMPVAR_CV_HAN
 		if (IS_CV == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -17360,7 +17360,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_OBJ_IS_SPEC_TMPVAR_CV_HA
 		if (IS_CV == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -17605,7 +17605,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_INIT_METHOD_CALL_SPEC_TMPVAR_C
 	called_scope = obj->ce;
 
 	if (IS_CV == IS_CONST &&
-	    EXPECTED(CACHED_PTR(opline->result.num) == called_scope)) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, called_scope))) {
 	    fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else {
 	    zend_object *orig_obj = obj;
@@ -18821,7 +18821,7 @@ num_index:
 		}
 
 	} else {
-		if (!zend_hash_next_index_insert(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
+		if (!zend_hash_next_index_insert_fast(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
 			zend_cannot_add_element();
 			zval_ptr_dtor_nogc(expr_ptr);
 		}
@@ -19235,7 +19235,7 @@ num_index:
 		}
 		zval_ptr_dtor_nogc(free_op2);
 	} else {
-		if (!zend_hash_next_index_insert(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
+		if (!zend_hash_next_index_insert_fast(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
 			zend_cannot_add_element();
 			zval_ptr_dtor_nogc(expr_ptr);
 		}
@@ -19725,7 +19725,7 @@ num_index:
 		}
 
 	} else {
-		if (!zend_hash_next_index_insert(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
+		if (!zend_hash_next_index_insert_fast(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
 			zend_cannot_add_element();
 			zval_ptr_dtor_nogc(expr_ptr);
 		}
@@ -20195,7 +20195,7 @@ num_index:
 		}
 
 	} else {
-		if (!zend_hash_next_index_insert(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
+		if (!zend_hash_next_index_insert_fast(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
 			zend_cannot_add_element();
 			zval_ptr_dtor_nogc(expr_ptr);
 		}
@@ -21400,35 +21400,55 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FE_FETCH_R_SPEC_VAR_HANDLER(ZE
 		fe_ht = Z_ARRVAL_P(array);
 		pos = Z_FE_POS_P(array);
 		p = fe_ht->arData + pos;
-		while (1) {
-			if (UNEXPECTED(pos >= fe_ht->nNumUsed)) {
-				/* reached end of iteration */
-fe_fetch_r_exit:
-				ZEND_VM_SET_RELATIVE_OPCODE(opline, opline->extended_value);
-				ZEND_VM_CONTINUE();
+		if (HT_FLAGS(fe_ht) & HASH_FLAG_PACKED) {
+			/* packed arrays have neither INDIRECT values nor string keys */
+			while (1) {
+				if (UNEXPECTED(pos >= fe_ht->nNumUsed)) {
+					goto fe_fetch_r_exit;
+				}
+				value = &p->val;
+				value_type = Z_TYPE_INFO_P(value);
+				if (EXPECTED(value_type != IS_UNDEF)) {
+					break;
+				}
+				pos++;
+				p++;
 			}
-			value = &p->val;
-			value_type = Z_TYPE_INFO_P(value);
-			if (EXPECTED(value_type != IS_UNDEF)) {
-				if (UNEXPECTED(value_type == IS_INDIRECT)) {
-					value = Z_INDIRECT_P(value);
-					value_type = Z_TYPE_INFO_P(value);
-					if (EXPECTED(value_type != IS_UNDEF)) {
+			Z_FE_POS_P(array) = pos + 1;
+			if (RETURN_VALUE_USED(opline)) {
+				ZVAL_LONG(EX_VAR(opline->result.var), pos);
+			}
+		} else {
+			while (1) {
+				if (UNEXPECTED(pos >= fe_ht->nNumUsed)) {
+					/* reached end of iteration */
+fe_fetch_r_exit:
+					ZEND_VM_SET_RELATIVE_OPCODE(opline, opline->extended_value);
+					ZEND_VM_CONTINUE();
+				}
+				value = &p->val;
+				value_type = Z_TYPE_INFO_P(value);
+				if (EXPECTED(value_type != IS_UNDEF)) {
+					if (UNEXPECTED(value_type == IS_INDIRECT)) {
+						value = Z_INDIRECT_P(value);
+						value_type = Z_TYPE_INFO_P(value);
+						if (EXPECTED(value_type != IS_UNDEF)) {
+							break;
+						}
+					} else {
 						break;
 					}
-				} else {
-					break;
 				}
+				pos++;
+				p++;
 			}
-			pos++;
-			p++;
-		}
-		Z_FE_POS_P(array) = pos + 1;
-		if (RETURN_VALUE_USED(opline)) {
-			if (!p->key) {
-				ZVAL_LONG(EX_VAR(opline->result.var), p->h);
-			} else {
-				ZVAL_STR_COPY(EX_VAR(opline->result.var), p->key);
+			Z_FE_POS_P(array) = pos + 1;
+			if (RETURN_VALUE_USED(opline)) {
+				if (!p->key) {
+					ZVAL_LONG(EX_VAR(opline->result.var), p->h);
+				} else {
+					ZVAL_STR_COPY(EX_VAR(opline->result.var), p->key);
+				}
 			}
 		}
 	} else {
@@ -22757,7 +22777,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_VAR_CONST_OP_D
 
 assign_object:
 	if (IS_CONST == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -22878,7 +22898,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_VAR_CONST_OP_D
 
 assign_object:
 	if (IS_CONST == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -22999,7 +23019,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_VAR_CONST_OP_D
 
 assign_object:
 	if (IS_CONST == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -23120,7 +23140,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_VAR_CONST_OP_D
 
 assign_object:
 	if (IS_CONST == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -23231,7 +23251,7 @@ try_assign_dim_array:
 			if (IS_CONST == IS_CV || IS_CONST == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 
 				zend_cannot_add_element();
@@ -23341,7 +23361,7 @@ try_assign_dim_array:
 			if (IS_TMP_VAR == IS_CV || IS_TMP_VAR == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 				zval_ptr_dtor_nogc(free_op_data);
 				zend_cannot_add_element();
@@ -23452,7 +23472,7 @@ try_assign_dim_array:
 			if (IS_VAR == IS_CV || IS_VAR == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 				zval_ptr_dtor_nogc(free_op_data);
 				zend_cannot_add_element();
@@ -23563,7 +23583,7 @@ try_assign_dim_array:
 			if (IS_CV == IS_CV || IS_CV == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 
 				zend_cannot_add_element();
@@ -23749,7 +23769,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_INIT_STATIC_METHOD_CALL_SPEC_V
 		/* nothing to do */
 	} else if (IS_VAR != IS_CONST &&
 	           IS_CONST == IS_CONST &&
-	           EXPECTED(CACHED_PTR(opline->result.num) == ce)) {
+	           EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, ce))) {
 		fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else if (IS_CONST != IS_UNUSED) {
 
@@ -23882,7 +23902,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_CLASS_CONSTANT_SPEC_VAR_
 			} else {
 				ce = Z_CE_P(EX_VAR(opline->op1.var));
 			}
-			if (EXPECTED(CACHED_PTR(opline->extended_value) == ce)) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, ce))) {
 				value = CACHED_PTR(opline->extended_value + sizeof(void*));
 				break;
 			}
@@ -24004,7 +24024,7 @@ num_index:
 		}
 
 	} else {
-		if (!zend_hash_next_index_insert(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
+		if (!zend_hash_next_index_insert_fast(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
 			zend_cannot_add_element();
 			zval_ptr_dtor_nogc(expr_ptr);
 		}
@@ -25127,7 +25147,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_VAR_TMPVAR_OP_
 
 assign_object:
 	if ((IS_TMP_VAR|IS_VAR) == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -25248,7 +25268,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_VAR_TMPVAR_OP_
 
 assign_object:
 	if ((IS_TMP_VAR|IS_VAR) == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -25369,7 +25389,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_VAR_TMPVAR_OP_
 
 assign_object:
 	if ((IS_TMP_VAR|IS_VAR) == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -25490,7 +25510,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_VAR_TMPVAR_OP_
 
 assign_object:
 	if ((IS_TMP_VAR|IS_VAR) == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -25601,7 +25621,7 @@ try_assign_dim_array:
 			if (IS_CONST == IS_CV || IS_CONST == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 
 				zend_cannot_add_element();
@@ -25711,7 +25731,7 @@ try_assign_dim_array:
 			if (IS_TMP_VAR == IS_CV || IS_TMP_VAR == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 				zval_ptr_dtor_nogc(free_op_data);
 				zend_cannot_add_element();
@@ -25822,7 +25842,7 @@ try_assign_dim_array:
 			if (IS_VAR == IS_CV || IS_VAR == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 				zval_ptr_dtor_nogc(free_op_data);
 				zend_cannot_add_element();
@@ -25933,7 +25953,7 @@ try_assign_dim_array:
 			if (IS_CV == IS_CV || IS_CV == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 
 				zend_cannot_add_element();
@@ -26063,7 +26083,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_INIT_STATIC_METHOD_CALL_SPEC_V
 		/* nothing to do */
 	} else if (IS_VAR != IS_CONST &&
 	           (IS_TMP_VAR|IS_VAR) == IS_CONST &&
-	           EXPECTED(CACHED_PTR(opline->result.num) == ce)) {
+	           EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, ce))) {
 		fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else if ((IS_TMP_VAR|IS_VAR) != IS_UNUSED) {
 		zend_free_op free_op2;
@@ -26247,7 +26267,7 @@ num_index:
 		}
 		zval_ptr_dtor_nogc(free_op2);
 	} else {
-		if (!zend_hash_next_index_insert(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
+		if (!zend_hash_next_index_insert_fast(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
 			zend_cannot_add_element();
 			zval_ptr_dtor_nogc(expr_ptr);
 		}
@@ -27160,7 +27180,7 @@ try_assign_dim_array:
 			if (IS_CONST == IS_CV || IS_CONST == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 
 				zend_cannot_add_element();
@@ -27270,7 +27290,7 @@ try_assign_dim_array:
 			if (IS_TMP_VAR == IS_CV || IS_TMP_VAR == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 				zval_ptr_dtor_nogc(free_op_data);
 				zend_cannot_add_element();
@@ -27381,7 +27401,7 @@ try_assign_dim_array:
 			if (IS_VAR == IS_CV || IS_VAR == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 				zval_ptr_dtor_nogc(free_op_data);
 				zend_cannot_add_element();
@@ -27492,7 +27512,7 @@ try_assign_dim_array:
 			if (IS_CV == IS_CV || IS_CV == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 
 				zend_cannot_add_element();
@@ -27622,7 +27642,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_INIT_STATIC_METHOD_CALL_SPEC_V
 		/* nothing to do */
 	} else if (IS_VAR != IS_CONST &&
 	           IS_UNUSED == IS_CONST &&
-	           EXPECTED(CACHED_PTR(opline->result.num) == ce)) {
+	           EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, ce))) {
 		fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else if (IS_UNUSED != IS_UNUSED) {
 
@@ -27928,7 +27948,7 @@ num_index:
 		}
 
 	} else {
-		if (!zend_hash_next_index_insert(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
+		if (!zend_hash_next_index_insert_fast(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
 			zend_cannot_add_element();
 			zval_ptr_dtor_nogc(expr_ptr);
 		}
@@ -29020,7 +29040,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_VAR_CV_OP_DATA
 
 assign_object:
 	if (IS_CV == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -29141,7 +29161,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_VAR_CV_OP_DATA
 
 assign_object:
 	if (IS_CV == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -29262,7 +29282,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_VAR_CV_OP_DATA
 
 assign_object:
 	if (IS_CV == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -29383,7 +29403,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_VAR_CV_OP_DATA
 
 assign_object:
 	if (IS_CV == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -29494,7 +29514,7 @@ try_assign_dim_array:
 			if (IS_CONST == IS_CV || IS_CONST == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 
 				zend_cannot_add_element();
@@ -29604,7 +29624,7 @@ try_assign_dim_array:
 			if (IS_TMP_VAR == IS_CV || IS_TMP_VAR == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 				zval_ptr_dtor_nogc(free_op_data);
 				zend_cannot_add_element();
@@ -29715,7 +29735,7 @@ try_assign_dim_array:
 			if (IS_VAR == IS_CV || IS_VAR == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 				zval_ptr_dtor_nogc(free_op_data);
 				zend_cannot_add_element();
@@ -29826,7 +29846,7 @@ try_assign_dim_array:
 			if (IS_CV == IS_CV || IS_CV == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 
 				zend_cannot_add_element();
@@ -30060,7 +30080,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_INIT_STATIC_METHOD_CALL_SPEC_V
 		/* nothing to do */
 	} else if (IS_VAR != IS_CONST &&
 	           IS_CV == IS_CONST &&
-	           EXPECTED(CACHED_PTR(opline->result.num) == ce)) {
+	           EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, ce))) {
 		fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else if (IS_CV != IS_UNUSED) {
 
@@ -30244,7 +30264,7 @@ num_index:
 		}
 
 	} else {
-		if (!zend_hash_next_index_insert(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
+		if (!zend_hash_next_index_insert_fast(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
 			zend_cannot_add_element();
 			zval_ptr_dtor_nogc(expr_ptr);
 		}
@@ -30556,34 +30576,55 @@ static ZEND_VM_HOT ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FE_FETCH_R_SIMPLE_
 	fe_ht = Z_ARRVAL_P(array);
 	pos = Z_FE_POS_P(array);
 	p = fe_ht->arData + pos;
-	while (1) {
-		if (UNEXPECTED(pos >= fe_ht->nNumUsed)) {
-			/* reached end of iteration */
-			ZEND_VM_SET_RELATIVE_OPCODE(opline, opline->extended_value);
-			ZEND_VM_CONTINUE();
+	if (HT_FLAGS(fe_ht) & HASH_FLAG_PACKED) {
+		/* packed arrays have neither INDIRECT values nor string keys */
+		while (1) {
+			if (UNEXPECTED(pos >= fe_ht->nNumUsed)) {
+				/* reached end of iteration */
+				ZEND_VM_SET_RELATIVE_OPCODE(opline, opline->extended_value);
+				ZEND_VM_CONTINUE();
+			}
+			value = &p->val;
+			if (EXPECTED(Z_TYPE_INFO_P(value) != IS_UNDEF)) {
+				break;
+			}
+			pos++;
+			p++;
 		}
-		value = &p->val;
-		value_type = Z_TYPE_INFO_P(value);
-		if (EXPECTED(value_type != IS_UNDEF)) {
-			if (UNEXPECTED(value_type == IS_INDIRECT)) {
-				value = Z_INDIRECT_P(value);
-				value_type = Z_TYPE_INFO_P(value);
-				if (EXPECTED(value_type != IS_UNDEF)) {
+		Z_FE_POS_P(array) = pos + 1;
+		if (0) {
+			ZVAL_LONG(EX_VAR(opline->result.var), pos);
+		}
+	} else {
+		while (1) {
+			if (UNEXPECTED(pos >= fe_ht->nNumUsed)) {
+				/* reached end of iteration */
+				ZEND_VM_SET_RELATIVE_OPCODE(opline, opline->extended_value);
+				ZEND_VM_CONTINUE();
+			}
+			value = &p->val;
+			value_type = Z_TYPE_INFO_P(value);
+			if (EXPECTED(value_type != IS_UNDEF)) {
+				if (UNEXPECTED(value_type == IS_INDIRECT)) {
+					value = Z_INDIRECT_P(value);
+					value_type = Z_TYPE_INFO_P(value);
+					if (EXPECTED(value_type != IS_UNDEF)) {
+						break;
+					}
+				} else {
 					break;
 				}
-			} else {
-				break;
 			}
+			pos++;
+			p++;
 		}
-		pos++;
-		p++;
-	}
-	Z_FE_POS_P(array) = pos + 1;
-	if (0) {
-		if (!p->key) {
-			ZVAL_LONG(EX_VAR(opline->result.var), p->h);
-		} else {
-			ZVAL_STR_COPY(EX_VAR(opline->result.var), p->key);
+		Z_FE_POS_P(array) = pos + 1;
+		if (0) {
+			if (!p->key) {
+				ZVAL_LONG(EX_VAR(opline->result.var), p->h);
+			} else {
+				ZVAL_STR_COPY(EX_VAR(opline->result.var), p->key);
+			}
 		}
 	}
 
@@ -30608,34 +30649,55 @@ static ZEND_VM_HOT ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FE_FETCH_R_SIMPLE_
 	fe_ht = Z_ARRVAL_P(array);
 	pos = Z_FE_POS_P(array);
 	p = fe_ht->arData + pos;
-	while (1) {
-		if (UNEXPECTED(pos >= fe_ht->nNumUsed)) {
-			/* reached end of iteration */
-			ZEND_VM_SET_RELATIVE_OPCODE(opline, opline->extended_value);
-			ZEND_VM_CONTINUE();
+	if (HT_FLAGS(fe_ht) & HASH_FLAG_PACKED) {
+		/* packed arrays have neither INDIRECT values nor string keys */
+		while (1) {
+			if (UNEXPECTED(pos >= fe_ht->nNumUsed)) {
+				/* reached end of iteration */
+				ZEND_VM_SET_RELATIVE_OPCODE(opline, opline->extended_value);
+				ZEND_VM_CONTINUE();
+			}
+			value = &p->val;
+			if (EXPECTED(Z_TYPE_INFO_P(value) != IS_UNDEF)) {
+				break;
+			}
+			pos++;
+			p++;
 		}
-		value = &p->val;
-		value_type = Z_TYPE_INFO_P(value);
-		if (EXPECTED(value_type != IS_UNDEF)) {
-			if (UNEXPECTED(value_type == IS_INDIRECT)) {
-				value = Z_INDIRECT_P(value);
-				value_type = Z_TYPE_INFO_P(value);
-				if (EXPECTED(value_type != IS_UNDEF)) {
+		Z_FE_POS_P(array) = pos + 1;
+		if (1) {
+			ZVAL_LONG(EX_VAR(opline->result.var), pos);
+		}
+	} else {
+		while (1) {
+			if (UNEXPECTED(pos >= fe_ht->nNumUsed)) {
+				/* reached end of iteration */
+				ZEND_VM_SET_RELATIVE_OPCODE(opline, opline->extended_value);
+				ZEND_VM_CONTINUE();
+			}
+			value = &p->val;
+			value_type = Z_TYPE_INFO_P(value);
+			if (EXPECTED(value_type != IS_UNDEF)) {
+				if (UNEXPECTED(value_type == IS_INDIRECT)) {
+					value = Z_INDIRECT_P(value);
+					value_type = Z_TYPE_INFO_P(value);
+					if (EXPECTED(value_type != IS_UNDEF)) {
+						break;
+					}
+				} else {
 					break;
 				}
-			} else {
-				break;
 			}
+			pos++;
+			p++;
 		}
-		pos++;
-		p++;
-	}
-	Z_FE_POS_P(array) = pos + 1;
-	if (1) {
-		if (!p->key) {
-			ZVAL_LONG(EX_VAR(opline->result.var), p->h);
-		} else {
-			ZVAL_STR_COPY(EX_VAR(opline->result.var), p->key);
+		Z_FE_POS_P(array) = pos + 1;
+		if (1) {
+			if (!p->key) {
+				ZVAL_LONG(EX_VAR(opline->result.var), p->h);
+			} else {
+				ZVAL_STR_COPY(EX_VAR(opline->result.var), p->key);
+			}
 		}
 	}
 
@@ -31173,7 +31235,7 @@ static ZEND_VM_HOT ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_OBJ_R_SPEC_U
 		if (IS_CONST == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -31316,7 +31378,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_OBJ_IS_SPEC_UNUSED_CONST
 		if (IS_CONST == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -31439,7 +31501,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_UNUSED_CONST_O
 
 assign_object:
 	if (IS_CONST == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -31560,7 +31622,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_UNUSED_CONST_O
 
 assign_object:
 	if (IS_CONST == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -31681,7 +31743,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_UNUSED_CONST_O
 
 assign_object:
 	if (IS_CONST == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -31802,7 +31864,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_UNUSED_CONST_O
 
 assign_object:
 	if (IS_CONST == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -32050,7 +32112,7 @@ static ZEND_VM_HOT ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_INIT_METHOD_CALL_S
 	called_scope = obj->ce;
 
 	if (IS_CONST == IS_CONST &&
-	    EXPECTED(CACHED_PTR(opline->result.num) == called_scope)) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, called_scope))) {
 	    fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else {
 	    zend_object *orig_obj = obj;
@@ -32158,7 +32220,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_INIT_STATIC_METHOD_CALL_SPEC_U
 		/* nothing to do */
 	} else if (IS_UNUSED != IS_CONST &&
 	           IS_CONST == IS_CONST &&
-	           EXPECTED(CACHED_PTR(opline->result.num) == ce)) {
+	           EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, ce))) {
 		fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else if (IS_CONST != IS_UNUSED) {
 
@@ -32307,7 +32369,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_CLASS_CONSTANT_SPEC_UNUS
 			} else {
 				ce = Z_CE_P(EX_VAR(opline->op1.var));
 			}
-			if (EXPECTED(CACHED_PTR(opline->extended_value) == ce)) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, ce))) {
 				value = CACHED_PTR(opline->extended_value + sizeof(void*));
 				break;
 			}
@@ -32901,7 +32963,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_OBJ_R_SPEC_UNUSED_TMPVAR
 		if ((IS_TMP_VAR|IS_VAR) == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -33045,7 +33107,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_OBJ_IS_SPEC_UNUSED_TMPVA
 		if ((IS_TMP_VAR|IS_VAR) == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -33169,7 +33231,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_UNUSED_TMPVAR_
 
 assign_object:
 	if ((IS_TMP_VAR|IS_VAR) == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -33290,7 +33352,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_UNUSED_TMPVAR_
 
 assign_object:
 	if ((IS_TMP_VAR|IS_VAR) == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -33411,7 +33473,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_UNUSED_TMPVAR_
 
 assign_object:
 	if ((IS_TMP_VAR|IS_VAR) == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -33532,7 +33594,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_UNUSED_TMPVAR_
 
 assign_object:
 	if ((IS_TMP_VAR|IS_VAR) == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -33781,7 +33843,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_INIT_METHOD_CALL_SPEC_UNUSED_T
 	called_scope = obj->ce;
 
 	if ((IS_TMP_VAR|IS_VAR) == IS_CONST &&
-	    EXPECTED(CACHED_PTR(opline->result.num) == called_scope)) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, called_scope))) {
 	    fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else {
 	    zend_object *orig_obj = obj;
@@ -33889,7 +33951,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_INIT_STATIC_METHOD_CALL_SPEC_U
 		/* nothing to do */
 	} else if (IS_UNUSED != IS_CONST &&
 	           (IS_TMP_VAR|IS_VAR) == IS_CONST &&
-	           EXPECTED(CACHED_PTR(opline->result.num) == ce)) {
+	           EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, ce))) {
 		fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else if ((IS_TMP_VAR|IS_VAR) != IS_UNUSED) {
 		zend_free_op free_op2;
@@ -34427,7 +34489,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_INIT_STATIC_METHOD_CALL_SPEC_U
 		/* nothing to do */
 	} else if (IS_UNUSED != IS_CONST &&
 	           IS_UNUSED == IS_CONST &&
-	           EXPECTED(CACHED_PTR(opline->result.num) == ce)) {
+	           EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, ce))) {
 		fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else if (IS_UNUSED != IS_UNUSED) {
 
@@ -35279,7 +35341,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_OBJ_R_SPEC_UNUSED_CV_HAN
 		if (IS_CV == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -35422,7 +35484,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_OBJ_IS_SPEC_UNUSED_CV_HA
 		if (IS_CV == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -35545,7 +35607,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_UNUSED_CV_OP_D
 
 assign_object:
 	if (IS_CV == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -35666,7 +35728,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_UNUSED_CV_OP_D
 
 assign_object:
 	if (IS_CV == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -35787,7 +35849,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_UNUSED_CV_OP_D
 
 assign_object:
 	if (IS_CV == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -35908,7 +35970,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_UNUSED_CV_OP_D
 
 assign_object:
 	if (IS_CV == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -36156,7 +36218,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_INIT_METHOD_CALL_SPEC_UNUSED_C
 	called_scope = obj->ce;
 
 	if (IS_CV == IS_CONST &&
-	    EXPECTED(CACHED_PTR(opline->result.num) == called_scope)) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, called_scope))) {
 	    fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else {
 	    zend_object *orig_obj = obj;
@@ -36264,7 +36326,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_INIT_STATIC_METHOD_CALL_SPEC_U
 		/* nothing to do */
 	} else if (IS_UNUSED != IS_CONST &&
 	           IS_CV == IS_CONST &&
-	           EXPECTED(CACHED_PTR(opline->result.num) == ce)) {
+	           EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, ce))) {
 		fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else if (IS_CV != IS_UNUSED) {
 
@@ -39526,7 +39588,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL zend_fetch_static_prop_helper_SPEC_
 				ce = Z_CE_P(EX_VAR(opline->op2.var));
 			}
 			if (IS_CV == IS_CONST &&
-			    EXPECTED(CACHED_PTR(opline->extended_value) == ce)) {
+			    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, ce))) {
 				retval = CACHED_PTR(opline->extended_value + sizeof(void*));
 				break;
 			}
@@ -39770,7 +39832,7 @@ static ZEND_VM_HOT ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_OBJ_R_SPEC_C
 		if (IS_CONST == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -39913,7 +39975,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_OBJ_IS_SPEC_CV_CONST_HAN
 		if (IS_CONST == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -40036,7 +40098,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_CV_CONST_OP_DA
 
 assign_object:
 	if (IS_CONST == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -40157,7 +40219,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_CV_CONST_OP_DA
 
 assign_object:
 	if (IS_CONST == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -40278,7 +40340,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_CV_CONST_OP_DA
 
 assign_object:
 	if (IS_CONST == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -40399,7 +40461,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_CV_CONST_OP_DA
 
 assign_object:
 	if (IS_CONST == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -40510,7 +40572,7 @@ try_assign_dim_array:
 			if (IS_CONST == IS_CV || IS_CONST == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 
 				zend_cannot_add_element();
@@ -40620,7 +40682,7 @@ try_assign_dim_array:
 			if (IS_TMP_VAR == IS_CV || IS_TMP_VAR == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 				zval_ptr_dtor_nogc(free_op_data);
 				zend_cannot_add_element();
@@ -40731,7 +40793,7 @@ try_assign_dim_array:
 			if (IS_VAR == IS_CV || IS_VAR == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 				zval_ptr_dtor_nogc(free_op_data);
 				zend_cannot_add_element();
@@ -40842,7 +40904,7 @@ try_assign_dim_array:
 			if (IS_CV == IS_CV || IS_CV == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 
 				zend_cannot_add_element();
@@ -41177,7 +41239,7 @@ static ZEND_VM_HOT ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_INIT_METHOD_CALL_S
 	called_scope = obj->ce;
 
 	if (IS_CONST == IS_CONST &&
-	    EXPECTED(CACHED_PTR(opline->result.num) == called_scope)) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, called_scope))) {
 	    fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else {
 	    zend_object *orig_obj = obj;
@@ -41330,7 +41392,7 @@ num_index:
 		}
 
 	} else {
-		if (!zend_hash_next_index_insert(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
+		if (!zend_hash_next_index_insert_fast(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
 			zend_cannot_add_element();
 			zval_ptr_dtor_nogc(expr_ptr);
 		}
@@ -41582,7 +41644,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ISSET_ISEMPTY_STATIC_PROP_SPEC
 			ce = Z_CE_P(EX_VAR(opline->op2.var));
 		}
 		if (IS_CV == IS_CONST &&
-		    EXPECTED(CACHED_PTR(opline->extended_value & ~ZEND_ISEMPTY) == ce)) {
+		    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value & ~ZEND_ISEMPTY, ce))) {
 
 			value = CACHED_PTR((opline->extended_value & ~ZEND_ISEMPTY) + sizeof(void*));
 			goto is_static_prop_return;
@@ -43587,7 +43649,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_OBJ_R_SPEC_CV_TMPVAR_HAN
 		if ((IS_TMP_VAR|IS_VAR) == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -43731,7 +43793,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_OBJ_IS_SPEC_CV_TMPVAR_HA
 		if ((IS_TMP_VAR|IS_VAR) == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -43855,7 +43917,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_CV_TMPVAR_OP_D
 
 assign_object:
 	if ((IS_TMP_VAR|IS_VAR) == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -43976,7 +44038,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_CV_TMPVAR_OP_D
 
 assign_object:
 	if ((IS_TMP_VAR|IS_VAR) == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -44097,7 +44159,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_CV_TMPVAR_OP_D
 
 assign_object:
 	if ((IS_TMP_VAR|IS_VAR) == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -44218,7 +44280,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_CV_TMPVAR_OP_D
 
 assign_object:
 	if ((IS_TMP_VAR|IS_VAR) == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -44329,7 +44391,7 @@ try_assign_dim_array:
 			if (IS_CONST == IS_CV || IS_CONST == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 
 				zend_cannot_add_element();
@@ -44439,7 +44501,7 @@ try_assign_dim_array:
 			if (IS_TMP_VAR == IS_CV || IS_TMP_VAR == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 				zval_ptr_dtor_nogc(free_op_data);
 				zend_cannot_add_element();
@@ -44550,7 +44612,7 @@ try_assign_dim_array:
 			if (IS_VAR == IS_CV || IS_VAR == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 				zval_ptr_dtor_nogc(free_op_data);
 				zend_cannot_add_element();
@@ -44661,7 +44723,7 @@ try_assign_dim_array:
 			if (IS_CV == IS_CV || IS_CV == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 
 				zend_cannot_add_element();
@@ -44940,7 +45002,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_INIT_METHOD_CALL_SPEC_CV_TMPVA
 	called_scope = obj->ce;
 
 	if ((IS_TMP_VAR|IS_VAR) == IS_CONST &&
-	    EXPECTED(CACHED_PTR(opline->result.num) == called_scope)) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, called_scope))) {
 	    fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else {
 	    zend_object *orig_obj = obj;
@@ -45093,7 +45155,7 @@ num_index:
 		}
 		zval_ptr_dtor_nogc(free_op2);
 	} else {
-		if (!zend_hash_next_index_insert(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
+		if (!zend_hash_next_index_insert_fast(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
 			zend_cannot_add_element();
 			zval_ptr_dtor_nogc(expr_ptr);
 		}
@@ -45679,7 +45741,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL zend_fetch_static_prop_helper_SPEC_
 				ce = Z_CE_P(EX_VAR(opline->op2.var));
 			}
 			if (IS_CV == IS_CONST &&
-			    EXPECTED(CACHED_PTR(opline->extended_value) == ce)) {
+			    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, ce))) {
 				retval = CACHED_PTR(opline->extended_value + sizeof(void*));
 				break;
 			}
@@ -45959,7 +46021,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ISSET_ISEMPTY_STATIC_PROP_SPEC
 			ce = Z_CE_P(EX_VAR(opline->op2.var));
 		}
 		if (IS_CV == IS_CONST &&
-		    EXPECTED(CACHED_PTR(opline->extended_value & ~ZEND_ISEMPTY) == ce)) {
+		    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value & ~ZEND_ISEMPTY, ce))) {
 
 			value = CACHED_PTR((opline->extended_value & ~ZEND_ISEMPTY) + sizeof(void*));
 			goto is_static_prop_return;
@@ -46517,7 +46579,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL zend_fetch_static_prop_helper_SPEC_
 				ce = Z_CE_P(EX_VAR(opline->op2.var));
 			}
 			if (IS_CV == IS_CONST &&
-			    EXPECTED(CACHED_PTR(opline->extended_value) == ce)) {
+			    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, ce))) {
 				retval = CACHED_PTR(opline->extended_value + sizeof(void*));
 				break;
 			}
@@ -46669,7 +46731,7 @@ try_assign_dim_array:
 			if (IS_CONST == IS_CV || IS_CONST == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 
 				zend_cannot_add_element();
@@ -46779,7 +46841,7 @@ try_assign_dim_array:
 			if (IS_TMP_VAR == IS_CV || IS_TMP_VAR == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 				zval_ptr_dtor_nogc(free_op_data);
 				zend_cannot_add_element();
@@ -46890,7 +46952,7 @@ try_assign_dim_array:
 			if (IS_VAR == IS_CV || IS_VAR == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 				zval_ptr_dtor_nogc(free_op_data);
 				zend_cannot_add_element();
@@ -47001,7 +47063,7 @@ try_assign_dim_array:
 			if (IS_CV == IS_CV || IS_CV == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 
 				zend_cannot_add_element();
@@ -47226,7 +47288,7 @@ num_index:
 		}
 
 	} else {
-		if (!zend_hash_next_index_insert(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
+		if (!zend_hash_next_index_insert_fast(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
 			zend_cannot_add_element();
 			zval_ptr_dtor_nogc(expr_ptr);
 		}
@@ -47498,7 +47560,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ISSET_ISEMPTY_STATIC_PROP_SPEC
 			ce = Z_CE_P(EX_VAR(opline->op2.var));
 		}
 		if (IS_CV == IS_CONST &&
-		    EXPECTED(CACHED_PTR(opline->extended_value & ~ZEND_ISEMPTY) == ce)) {
+		    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value & ~ZEND_ISEMPTY, ce))) {
 
 			value = CACHED_PTR((opline->extended_value & ~ZEND_ISEMPTY) + sizeof(void*));
 			goto is_static_prop_return;
@@ -49283,7 +49345,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_OBJ_R_SPEC_CV_CV_HANDLER
 		if (IS_CV == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -49426,7 +49488,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_FETCH_OBJ_IS_SPEC_CV_CV_HANDLE
 		if (IS_CV == IS_CONST) {
 			cache_slot = CACHE_ADDR(opline->extended_value);
 
-			if (EXPECTED(zobj->ce == CACHED_PTR_EX(cache_slot))) {
+			if (EXPECTED(CACHED_POLYMORPHIC_FIND_EX(cache_slot, zobj->ce))) {
 				uintptr_t prop_offset = (uintptr_t)CACHED_PTR_EX(cache_slot + 1);
 
 				if (EXPECTED(IS_VALID_PROPERTY_OFFSET(prop_offset))) {
@@ -49549,7 +49611,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_CV_CV_OP_DATA_
 
 assign_object:
 	if (IS_CV == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -49670,7 +49732,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_CV_CV_OP_DATA_
 
 assign_object:
 	if (IS_CV == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -49791,7 +49853,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_CV_CV_OP_DATA_
 
 assign_object:
 	if (IS_CV == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -49912,7 +49974,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_ASSIGN_OBJ_SPEC_CV_CV_OP_DATA_
 
 assign_object:
 	if (IS_CV == IS_CONST &&
-	    EXPECTED(Z_OBJCE_P(object) == CACHED_PTR(opline->extended_value))) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->extended_value, Z_OBJCE_P(object)))) {
 		uintptr_t prop_offset = (uintptr_t)CACHED_PTR(opline->extended_value + sizeof(void*));
 		zend_object *zobj = Z_OBJ_P(object);
 		zval *property_val;
@@ -50023,7 +50085,7 @@ try_assign_dim_array:
 			if (IS_CONST == IS_CV || IS_CONST == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 
 				zend_cannot_add_element();
@@ -50133,7 +50195,7 @@ try_assign_dim_array:
 			if (IS_TMP_VAR == IS_CV || IS_TMP_VAR == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 				zval_ptr_dtor_nogc(free_op_data);
 				zend_cannot_add_element();
@@ -50244,7 +50306,7 @@ try_assign_dim_array:
 			if (IS_VAR == IS_CV || IS_VAR == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 				zval_ptr_dtor_nogc(free_op_data);
 				zend_cannot_add_element();
@@ -50355,7 +50417,7 @@ try_assign_dim_array:
 			if (IS_CV == IS_CV || IS_CV == IS_VAR) {
 				ZVAL_DEREF(value);
 			}
-			variable_ptr = zend_hash_next_index_insert(Z_ARRVAL_P(object_ptr), value);
+			variable_ptr = zend_hash_next_index_insert_fast(Z_ARRVAL_P(object_ptr), value);
 			if (UNEXPECTED(variable_ptr == NULL)) {
 
 				zend_cannot_add_element();
@@ -50738,7 +50800,7 @@ static ZEND_OPCODE_HANDLER_RET ZEND_FASTCALL ZEND_INIT_METHOD_CALL_SPEC_CV_CV_HA
 	called_scope = obj->ce;
 
 	if (IS_CV == IS_CONST &&
-	    EXPECTED(CACHED_PTR(opline->result.num) == called_scope)) {
+	    EXPECTED(CACHED_POLYMORPHIC_FIND(opline->result.num, called_scope))) {
 	    fbc = CACHED_PTR(opline->result.num + sizeof(void*));
 	} else {
 	    zend_object *orig_obj = obj;
@@ -50891,7 +50953,7 @@ num_index:
 		}
 
 	} else {
-		if (!zend_hash_next_index_insert(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
+		if (!zend_hash_next_index_insert_fast(Z_ARRVAL_P(EX_VAR(opline->result.var)), expr_ptr)) {
 			zend_cannot_add_element();
 			zval_ptr_dtor_nogc(expr_ptr);
 		}